@@ -2,7 +2,11 @@
 #define OC_ARRAY_H
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <utility>
 #include <initializer_list>
 #include <stdexcept>
 #include <span>
@@ -12,6 +16,25 @@
 #include <variant>
 #include <sstream>
 #include <cmath>
+#include <numbers>
+#include <vector>
+#include <array>
+#include <deque>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <optional>
+#include <coroutine>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#endif
 
 namespace oc {
 
@@ -42,17 +65,371 @@ namespace oc {
 
                 [[nodiscard]] constexpr pointer allocate(size_type n)
                 {
-                    return n == 0 ? nullptr : reinterpret_cast<pointer>(operator new[](n * sizeof(value_type)));
+                    if (n == 0) {
+                        return nullptr;
+                    }
+                    void* p{ std::malloc(n * sizeof(value_type)) };
+                    if (!p) {
+                        throw std::bad_alloc{};
+                    }
+                    return reinterpret_cast<pointer>(p);
                 }
 
                 constexpr void deallocate(pointer p, size_type n) noexcept
                 {
                     if (p && n > 0) {
-                        operator delete[](p, n * sizeof(value_type));
+                        std::free(p);
+                    }
+                }
+
+                /**
+                * @note Resizes the allocation of p in place if possible (by realloc). Only valid for trivially copyable value_type.
+                */
+                [[nodiscard]] pointer reallocate(pointer p, size_type n, size_type new_n)
+                {
+                    if (!p || n <= 0) {
+                        return allocate(new_n);
+                    }
+                    if (new_n == 0) {
+                        deallocate(p, n);
+                        return nullptr;
+                    }
+                    void* new_p{ std::realloc(p, new_n * sizeof(value_type)) };
+                    if (!new_p) {
+                        throw std::bad_alloc{};
+                    }
+                    return reinterpret_cast<pointer>(new_p);
+                }
+        };
+
+        /**
+        * @note Allocations of at least this number of bytes are backed by huge pages.
+        */
+        inline constexpr std::int64_t huge_page_size{ std::int64_t{ 1 } << 21 };
+
+        /**
+        * @note Large allocations (of at least huge_page_size bytes) are mapped directly at a huge page boundary and advised to use transparent huge pages,
+        * which reduces TLB misses of strided access. If UseHugetlb, reserved huge pages (MAP_HUGETLB) are tried first.
+        * Smaller allocations, and systems without mmap, fall back to operator new.
+        */
+        template <typename T, bool UseHugetlb = false>
+        requires (!std::is_reference_v<T>)
+            class basic_huge_page_allocator {
+            public:
+                using value_type = T;
+                using pointer = T*;
+                using const_pointer = const T*;
+                using reference = T&;
+                using const_reference = const T&;
+                using size_type = std::int64_t;
+                using difference_type = std::int64_t;
+
+                template <typename U>
+                struct rebind {
+                    using other = basic_huge_page_allocator<U, UseHugetlb>;
+                };
+
+                constexpr basic_huge_page_allocator() = default;
+                constexpr basic_huge_page_allocator(const basic_huge_page_allocator& other) = default;
+                constexpr basic_huge_page_allocator& operator=(const basic_huge_page_allocator& other) = default;
+                constexpr basic_huge_page_allocator(basic_huge_page_allocator&& other) = default;
+                constexpr basic_huge_page_allocator& operator=(basic_huge_page_allocator&& other) = default;
+                constexpr ~basic_huge_page_allocator() = default;
+
+                template <typename U>
+                requires (!std::is_reference_v<U>)
+                    constexpr basic_huge_page_allocator(const basic_huge_page_allocator<U, UseHugetlb>&) noexcept {}
+
+                [[nodiscard]] pointer allocate(size_type n)
+                {
+                    if (n == 0) {
+                        return nullptr;
+                    }
+#if defined(__linux__)
+                    if (is_mapped(n)) {
+                        const std::size_t length{ mapped_length(n) };
+                        void* p{ MAP_FAILED };
+                        if constexpr (UseHugetlb) {
+                            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                        }
+                        if (p == MAP_FAILED) {
+                            p = map_aligned(length);
+                            if (p == MAP_FAILED) {
+                                throw std::bad_alloc{};
+                            }
+                            madvise(p, length, MADV_HUGEPAGE);
+                        }
+                        return reinterpret_cast<pointer>(p);
+                    }
+#endif
+                    return reinterpret_cast<pointer>(operator new[](n * sizeof(value_type)));
+                }
+
+                void deallocate(pointer p, size_type n) noexcept
+                {
+                    if (!p || n <= 0) {
+                        return;
+                    }
+#if defined(__linux__)
+                    if (is_mapped(n)) {
+                        munmap(p, mapped_length(n));
+                        return;
+                    }
+#endif
+                    operator delete[](p, n * sizeof(value_type));
+                }
+
+                /**
+                * @note Mapped allocations are remapped (by mremap), i.e. grown without copying their pages. Only valid for trivially copyable value_type.
+                * A mapping that cannot be grown in place is moved to a huge page boundary.
+                */
+                [[nodiscard]] pointer reallocate(pointer p, size_type n, size_type new_n)
+                {
+                    if (!p || n <= 0) {
+                        return allocate(new_n);
+                    }
+#if defined(__linux__)
+                    if (is_mapped(n) && is_mapped(new_n)) {
+                        void* new_p{ mremap(p, mapped_length(n), mapped_length(new_n), 0) };
+                        if (new_p == MAP_FAILED) {
+                            void* target{ map_aligned(mapped_length(new_n)) };
+                            if (target != MAP_FAILED) {
+                                new_p = mremap(p, mapped_length(n), mapped_length(new_n), MREMAP_MAYMOVE | MREMAP_FIXED, target);
+                                if (new_p == MAP_FAILED) {
+                                    munmap(target, mapped_length(new_n));
+                                }
+                            }
+                        }
+                        if (new_p != MAP_FAILED) {
+                            return reinterpret_cast<pointer>(new_p);
+                        }
+                    }
+#endif
+                    pointer new_p{ allocate(new_n) };
+                    if (new_n > 0) {
+                        std::memcpy(new_p, p, std::min(n, new_n) * sizeof(value_type));
+                    }
+                    deallocate(p, n);
+                    return new_p;
+                }
+
+            private:
+                [[nodiscard]] static constexpr bool is_mapped(size_type n) noexcept
+                {
+                    return n * static_cast<size_type>(sizeof(value_type)) >= huge_page_size;
+                }
+
+                // whole huge pages, as required by MAP_HUGETLB mappings
+                [[nodiscard]] static constexpr std::size_t mapped_length(size_type n) noexcept
+                {
+                    const size_type size{ n * static_cast<size_type>(sizeof(value_type)) };
+                    return static_cast<std::size_t>((size + huge_page_size - 1) / huge_page_size * huge_page_size);
+                }
+
+#if defined(__linux__)
+                // the mapping is larger by a huge page and trimmed to a huge page boundary, since unaligned ends cannot be backed by huge pages
+                [[nodiscard]] static void* map_aligned(std::size_t length) noexcept
+                {
+                    const std::size_t alignment{ static_cast<std::size_t>(huge_page_size) };
+                    void* p{ mmap(nullptr, length + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+                    if (p == MAP_FAILED) {
+                        return MAP_FAILED;
+                    }
+
+                    const std::uintptr_t first{ reinterpret_cast<std::uintptr_t>(p) };
+                    const std::uintptr_t aligned{ (first + alignment - 1) / alignment * alignment };
+                    if (aligned > first) {
+                        munmap(p, aligned - first);
+                    }
+                    munmap(reinterpret_cast<void*>(aligned + length), first + alignment - aligned);
+                    return reinterpret_cast<void*>(aligned);
+                }
+#endif
+        };
+
+        template <typename T>
+        using huge_page_allocator = basic_huge_page_allocator<T, false>;
+
+        template <typename T>
+        using hugetlb_allocator = basic_huge_page_allocator<T, true>;
+
+        /**
+        * @note Bump allocation from a caller provided buffer. Memory is not released by deallocation,
+        * but by rewinding the arena to a previous mark (as done by arrnd_arena_scope).
+        */
+        class arrnd_arena final {
+        public:
+            explicit arrnd_arena(std::span<std::byte> buffer) noexcept
+                : buffer_(buffer)
+            {
+            }
+
+            arrnd_arena(const arrnd_arena&) = delete;
+            arrnd_arena& operator=(const arrnd_arena&) = delete;
+
+            /**
+            * @return nullptr if the arena is exhausted.
+            */
+            [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) noexcept
+            {
+                const std::uintptr_t first{ reinterpret_cast<std::uintptr_t>(buffer_.data()) };
+                const std::uintptr_t aligned{ (first + used_ + alignment - 1) / alignment * alignment };
+                if (aligned + size > first + buffer_.size()) {
+                    return nullptr;
+                }
+                used_ = aligned + size - first;
+                return reinterpret_cast<void*>(aligned);
+            }
+
+            [[nodiscard]] bool owns(const void* p) const noexcept
+            {
+                return std::less_equal<>{}(buffer_.data(), p) && std::less<>{}(p, buffer_.data() + buffer_.size());
+            }
+
+            [[nodiscard]] std::size_t mark() const noexcept
+            {
+                return used_;
+            }
+
+            void rewind(std::size_t mark) noexcept
+            {
+                used_ = mark;
+            }
+
+            /**
+            * @return Arena of the innermost arrnd_arena_scope of this thread, or nullptr.
+            */
+            [[nodiscard]] static arrnd_arena* current() noexcept
+            {
+                return current_;
+            }
+
+            /**
+            * @note Per thread arena for temporaries, e.g. of a slicing chain in a loop.
+            */
+            [[nodiscard]] static arrnd_arena& thread_local_arena()
+            {
+                constexpr std::size_t size{ std::size_t{ 1 } << 16 };
+                thread_local std::unique_ptr<std::byte[]> buffer{ std::make_unique<std::byte[]>(size) };
+                thread_local arrnd_arena arena{ std::span<std::byte>(buffer.get(), size) };
+                return arena;
+            }
+
+        private:
+            friend class arrnd_arena_scope;
+
+            std::span<std::byte> buffer_;
+            std::size_t used_{ 0 };
+
+            inline static thread_local arrnd_arena* current_{ nullptr };
+        };
+
+        /**
+        * @note Makes arena the current arena of this thread (i.e. the source of arena_allocator allocations) until the scope ends,
+        * at which point the arena is rewound. Objects allocated within the scope must not be used after it ends.
+        * A scope of nullptr suspends the current arena, e.g. for objects that are kept beyond the current scope.
+        */
+        class arrnd_arena_scope final {
+        public:
+            explicit arrnd_arena_scope(arrnd_arena* arena) noexcept
+                : arena_(arena), previous_(arrnd_arena::current_), mark_(arena ? arena->mark() : 0)
+            {
+                arrnd_arena::current_ = arena_;
+            }
+
+            explicit arrnd_arena_scope(arrnd_arena& arena) noexcept
+                : arrnd_arena_scope(&arena)
+            {
+            }
+
+            arrnd_arena_scope()
+                : arrnd_arena_scope(&arrnd_arena::thread_local_arena())
+            {
+            }
+
+            arrnd_arena_scope(const arrnd_arena_scope&) = delete;
+            arrnd_arena_scope& operator=(const arrnd_arena_scope&) = delete;
+
+            ~arrnd_arena_scope() noexcept
+            {
+                arrnd_arena::current_ = previous_;
+                if (arena_) {
+                    arena_->rewind(mark_);
+                }
+            }
+
+        private:
+            arrnd_arena* arena_;
+            arrnd_arena* previous_;
+            std::size_t mark_;
+        };
+
+        /**
+        * @note Allocates from the current arena of the thread if any (and not exhausted), and from the heap otherwise.
+        * Each allocation is prefixed by its source, so that it can be deallocated by any thread and after its scope ends.
+        */
+        template <typename T>
+        requires (!std::is_reference_v<T>)
+            class arena_allocator {
+            public:
+                using value_type = T;
+                using pointer = T*;
+                using const_pointer = const T*;
+                using reference = T&;
+                using const_reference = const T&;
+                using size_type = std::int64_t;
+                using difference_type = std::int64_t;
+
+                constexpr arena_allocator() = default;
+
+                template <typename U>
+                requires (!std::is_reference_v<U>)
+                    constexpr arena_allocator(const arena_allocator<U>&) noexcept {}
+
+                [[nodiscard]] pointer allocate(size_type n)
+                {
+                    if (n == 0) {
+                        return nullptr;
+                    }
+
+                    const std::size_t size{ prefix_size + static_cast<std::size_t>(n) * sizeof(value_type) };
+
+                    std::byte* block{ nullptr };
+                    source from{ source::heap };
+                    if (arrnd_arena* arena = arrnd_arena::current()) {
+                        block = static_cast<std::byte*>(arena->allocate(size, prefix_size));
+                        from = source::arena;
+                    }
+                    if (!block) {
+                        block = static_cast<std::byte*>(::operator new(size, std::align_val_t{ prefix_size }));
+                        from = source::heap;
+                    }
+
+                    std::memcpy(block, &from, sizeof(source));
+                    return reinterpret_cast<pointer>(block + prefix_size);
+                }
+
+                void deallocate(pointer p, size_type n) noexcept
+                {
+                    if (!p || n <= 0) {
+                        return;
+                    }
+
+                    std::byte* block{ reinterpret_cast<std::byte*>(p) - prefix_size };
+                    source from{};
+                    std::memcpy(&from, block, sizeof(source));
+                    if (from == source::heap) {
+                        ::operator delete(block, std::align_val_t{ prefix_size });
                     }
                 }
+
+            private:
+                enum class source : std::uint8_t { heap, arena };
+
+                static constexpr std::size_t prefix_size{ alignof(std::max_align_t) > alignof(T) ? alignof(std::max_align_t) : alignof(T) };
         };
 
+
         template <typename T, template<typename> typename Allocator = lightweight_allocator>
         requires (std::is_copy_constructible_v<T>&& std::is_copy_assignable_v<T>)
             class simple_dynamic_vector final {
@@ -76,7 +453,7 @@ namespace oc {
                 {
                     data_ptr_ = alloc_.allocate(capacity_);
                     if (data) {
-                        std::uninitialized_copy_n(data, size_, data_ptr_);
+                        copy_n(data, size_, data_ptr_);
                     }
                     else if constexpr (!std::is_fundamental_v<T>) {
                         std::uninitialized_default_construct_n(data_ptr_, size_);
@@ -92,13 +469,13 @@ namespace oc {
                 }
 
                 constexpr simple_dynamic_vector(const simple_dynamic_vector& other)
-                    : alloc_(other.alloc_), size_(other.size_), capacity_(other.capacity_)
+                    : alloc_(other.alloc_), size_(other.size_), capacity_(other.size_)
                 {
                     data_ptr_ = alloc_.allocate(capacity_);
-                    std::uninitialized_copy_n(other.data_ptr_, other.size_, data_ptr_);
+                    copy_n(other.data_ptr_, other.size_, data_ptr_);
                 }
 
-                constexpr simple_dynamic_vector operator=(const simple_dynamic_vector& other)
+                constexpr simple_dynamic_vector& operator=(const simple_dynamic_vector& other)
                 {
                     if (this == &other) {
                         return *this;
@@ -107,14 +484,17 @@ namespace oc {
                     if constexpr (!std::is_fundamental_v<T>) {
                         std::destroy_n(data_ptr_, size_);
                     }
-                    alloc_.deallocate(data_ptr_, capacity_);
 
-                    alloc_ = other.alloc_;
+                    // the buffer is reused if large enough
+                    if (capacity_ < other.size_) {
+                        alloc_.deallocate(data_ptr_, capacity_);
+                        alloc_ = other.alloc_;
+                        capacity_ = other.size_;
+                        data_ptr_ = alloc_.allocate(capacity_);
+                    }
                     size_ = other.size_;
-                    capacity_ = other.capacity_;
 
-                    data_ptr_ = alloc_.allocate(capacity_);
-                    std::uninitialized_copy_n(other.data_ptr_, other.size_, data_ptr_);
+                    copy_n(other.data_ptr_, other.size_, data_ptr_);
 
                     return *this;
                 }
@@ -126,9 +506,10 @@ namespace oc {
 
                     other.data_ptr_ = nullptr;
                     other.size_ = 0;
+                    other.capacity_ = 0;
                 }
 
-                constexpr simple_dynamic_vector operator=(simple_dynamic_vector&& other) noexcept
+                constexpr simple_dynamic_vector& operator=(simple_dynamic_vector&& other) noexcept
                 {
                     if (this == &other) {
                         return *this;
@@ -147,6 +528,7 @@ namespace oc {
 
                     other.data_ptr_ = nullptr;
                     other.size_ = 0;
+                    other.capacity_ = 0;
 
                     return *this;
                 }
@@ -199,19 +581,11 @@ namespace oc {
                     }
                     //else if (new_size == size_) { /* do nothing */ }
                     else if (new_size > size_) {
-                        size_type new_capacity = new_size;
-                        pointer new_data_ptr = alloc_.allocate(new_capacity);
-                        std::uninitialized_move_n(data_ptr_, size_, new_data_ptr);
-                        std::uninitialized_default_construct_n(new_data_ptr + size_, new_size - size_);
-
-                        if constexpr (!std::is_fundamental_v<T>) {
-                            std::destroy_n(data_ptr_, size_);
+                        if (new_size > capacity_) {
+                            reallocate(new_size);
                         }
-                        alloc_.deallocate(data_ptr_, capacity_);
-
-                        data_ptr_ = new_data_ptr;
+                        std::uninitialized_default_construct_n(data_ptr_ + size_, new_size - size_);
                         size_ = new_size;
-                        capacity_ = new_capacity;
                     }
                 }
 
@@ -219,35 +593,22 @@ namespace oc {
                 {
                     // if (new_capacity <= capacity_) do nothing
                     if (new_capacity > capacity_) {
-                        pointer new_data_ptr = alloc_.allocate(new_capacity);
-                        std::uninitialized_move_n(data_ptr_, size_, new_data_ptr);
-
-                        alloc_.deallocate(data_ptr_, capacity_);
-                        data_ptr_ = new_data_ptr;
-                        capacity_ = new_capacity;
+                        reallocate(new_capacity);
                     }
                 }
 
+                /**
+                * @note Capacity grows geometrically, i.e. repeated calls are amortized O(1) per element.
+                */
                 constexpr void expand(size_type count)
                 {
-                    if (size_ + count < capacity_) {
-                        if constexpr (!std::is_fundamental_v<T>) {
-                            std::uninitialized_default_construct_n(data_ptr_ + size_, count);
-                        }
-                        size_ += count;
+                    if (size_ + count > capacity_) {
+                        reallocate(grown_capacity(size_ + count));
                     }
-                    else if (size_ + count >= capacity_) {
-                        size_type new_capacity = static_cast<size_type>(1.5 * (size_ + count));
-                        size_type new_size = size_ + count;
-                        pointer data_ptr = alloc_.allocate(new_capacity);
-                        std::uninitialized_move_n(data_ptr_, size_, data_ptr);
-                        std::uninitialized_default_construct_n(data_ptr + size_, count);
-
-                        alloc_.deallocate(data_ptr_, capacity_);
-                        data_ptr_ = data_ptr;
-                        capacity_ = new_capacity;
-                        size_ = new_size;
+                    if constexpr (!std::is_fundamental_v<T>) {
+                        std::uninitialized_default_construct_n(data_ptr_ + size_, count);
                     }
+                    size_ += count;
                 }
 
                 constexpr void shrink(size_type count)
@@ -265,12 +626,7 @@ namespace oc {
                 constexpr void shrink_to_fit()
                 {
                     if (capacity_ > size_) {
-                        pointer data_ptr = alloc_.allocate(size_);
-                        std::uninitialized_move_n(data_ptr_, size_, data_ptr);
-
-                        alloc_.deallocate(data_ptr_, capacity_);
-                        data_ptr_ = data_ptr;
-                        capacity_ = size_;
+                        reallocate(size_);
                     }
                 }
 
@@ -284,6 +640,16 @@ namespace oc {
                     return data_ptr_ + size_;
                 }
 
+                [[nodiscard]] constexpr const_pointer begin() const noexcept
+                {
+                    return data_ptr_;
+                }
+
+                [[nodiscard]] constexpr const_pointer end() const noexcept
+                {
+                    return data_ptr_ + size_;
+                }
+
                 [[nodiscard]] constexpr const_reference back() const noexcept
                 {
                     return data_ptr_[size_ - 1];
@@ -305,6 +671,48 @@ namespace oc {
                 }
 
             private:
+                [[nodiscard]] static constexpr size_type grown_capacity(size_type min_capacity) noexcept
+                {
+                    return min_capacity + min_capacity / 2;
+                }
+
+                // trivially copyable elements are copied (and relocated) as bytes
+                static constexpr void copy_n(const_pointer src, size_type n, pointer dst)
+                {
+                    if constexpr (std::is_trivially_copyable_v<T>) {
+                        if (n > 0) {
+                            std::memcpy(dst, src, n * sizeof(T));
+                        }
+                    }
+                    else {
+                        std::uninitialized_copy_n(src, n, dst);
+                    }
+                }
+
+                /**
+                * @note Moves the elements to a buffer of new_capacity (not less than size_).
+                * Trivially copyable elements are resized in place by the allocator if it supports reallocate (e.g. by realloc or mremap).
+                */
+                constexpr void reallocate(size_type new_capacity)
+                {
+                    if constexpr (std::is_trivially_copyable_v<T> && requires(allocator_type a, pointer p) { a.reallocate(p, size_type{}, size_type{}); }) {
+                        data_ptr_ = alloc_.reallocate(data_ptr_, capacity_, new_capacity);
+                    }
+                    else {
+                        pointer new_data_ptr = alloc_.allocate(new_capacity);
+                        if constexpr (std::is_trivially_copyable_v<T>) {
+                            copy_n(data_ptr_, size_, new_data_ptr);
+                        }
+                        else {
+                            std::uninitialized_move_n(data_ptr_, size_, new_data_ptr);
+                            std::destroy_n(data_ptr_, size_);
+                        }
+                        alloc_.deallocate(data_ptr_, capacity_);
+                        data_ptr_ = new_data_ptr;
+                    }
+                    capacity_ = new_capacity;
+                }
+
                 allocator_type alloc_;
 
                 size_type size_;
@@ -504,4059 +912,8575 @@ namespace oc {
     }
 
     namespace details {
-        struct arrnd_tag {};
 
-        template <typename T>
-        concept arrnd_complient = std::is_same_v<typename T::tag, arrnd_tag>;
-    }
+        /**
+        * @note Arrays with less elements than this threshold are processed serially by parallel algorithms.
+        */
+        inline constexpr std::int64_t parallel_threshold{ 1 << 16 };
 
-    namespace details {
+        /**
+        * @note True if values of type T can be copied and destroyed by multiple threads concurrently.
+        * It is false for arrays of a non atomic reference count (and for arrays of such arrays), see non_atomic_ref_count.
+        */
         template <typename T>
-        [[nodiscard]] inline constexpr T default_atol() noexcept
-        {
-            return T{};
-        }
+        inline constexpr bool is_concurrently_copyable_v{ true };
 
-        template <std::integral T>
-        [[nodiscard]] inline constexpr T default_atol() noexcept
-        {
-            return T{ 0 };
+        /**
+        * @return CPUs of each NUMA node, as listed by the kernel (e.g. 0-15,32-47).
+        * Empty if the system has a single node, or if the information is not available.
+        */
+        [[nodiscard]] inline std::vector<std::vector<int>> numa_node_cpus()
+        {
+            std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+            for (int node = 0;; ++node) {
+                std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                if (!cpulist) {
+                    break;
+                }
+
+                std::vector<int> cpus;
+                std::string range;
+                while (std::getline(cpulist, range, ',')) {
+                    std::istringstream iss(range);
+                    int first{ 0 };
+                    if (!(iss >> first)) {
+                        continue;
+                    }
+                    int last{ first };
+                    char dash{};
+                    if (!(iss >> dash >> last)) {
+                        last = first;
+                    }
+                    for (int cpu = first; cpu <= last; ++cpu) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                nodes.push_back(std::move(cpus));
+            }
+#endif
+            if (nodes.size() <= 1) {
+                nodes.clear();
+            }
+            return nodes;
         }
 
-        template <std::floating_point T>
-        [[nodiscard]] inline constexpr T default_atol() noexcept
+        /**
+        * @return True if the calling thread was restricted to those of cpus that it is currently allowed to run on (e.g. by taskset or cgroups).
+        * @note Nothing is changed if none of cpus is allowed, or if thread affinity is not supported.
+        */
+        inline bool pin_current_thread(std::span<const int> cpus) noexcept
         {
-            return T{ 1e-8 };
-        }
+#if defined(__linux__)
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (cpus.empty() || sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+                return false;
+            }
 
-        template <typename T>
-        [[nodiscard]] inline constexpr T default_rtol() noexcept
-        {
-            return T{};
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : cpus) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+            if (CPU_COUNT(&set) == 0) {
+                return false;
+            }
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            return false;
+#endif
         }
 
-        template <std::integral T>
-        [[nodiscard]] inline constexpr T default_rtol() noexcept
-        {
-            return T{ 0 };
-        }
-
-        template <std::floating_point T>
-        [[nodiscard]] inline constexpr T default_rtol() noexcept
-        {
-            return T{ 1e-5 };
-        }
-
-        template <typename T1, typename T2> requires (!arrnd_complient<T1> && !arrnd_complient<T2>)
-        [[nodiscard]] inline constexpr bool close(const T1& a, const T2& b, const decltype(T1{} - T2{})& atol = default_atol<decltype(T1{} - T2{}) > (), const decltype(T1{} - T2{})& rtol = default_rtol<decltype(T1{} - T2{}) > ()) noexcept
-        {
-            const decltype(a - b) reps{ rtol * (abs(a) > abs(b) ? abs(a) : abs(b)) };
-            return abs(a - b) <= (atol > reps ? atol : reps);
-        }
-
-        template <std::integral T1, std::integral T2>
-        [[nodiscard]] inline constexpr auto modulo(const T1& value, const T2& modulus) noexcept -> decltype((value% modulus) + modulus)
-        {
-            return ((value % modulus) + modulus) % modulus;
-        }
-    }
-
-    using details::default_atol;
-    using details::default_rtol;
-
-    using details::close;
-    using details::modulo;
+        /**
+        * @note Work stealing scheduler. Each worker has its own deque of tasks, which it processes in LIFO order,
+        * and idle workers steal the oldest tasks of other workers. Tasks that are submitted by other threads are queued in a shared deque.
+        * Threads that wait for tasks (e.g. by task_group::wait) process pending tasks meanwhile, so that nested parallel calls
+        * are processed by the same workers without blocking them.
+        *
+        * On NUMA systems the workers can optionally be pinned to nodes (pin_to_numa_nodes), consecutive workers to the same node,
+        * including the workers of the shared pool of the library operations (see configure_instance).
+        * parallel_for queues consecutive partitions to consecutive workers, so with first touch page placement a buffer that is initialized
+        * by parallel_for tends to be local to the workers that process the same partitions later. This is not guaranteed,
+        * since the first partition is processed by the calling thread, and idle workers steal partitions of other workers.
+        */
+        class thread_pool final {
+        public:
+            explicit thread_pool(std::int64_t num_threads = std::thread::hardware_concurrency(), bool pin_to_numa_nodes = false)
+                : num_workers_(num_threads > 0 ? num_threads : 1)
+            {
+                // the last queue is of tasks that are submitted by non worker threads
+                queues_.reserve(num_workers_ + 1);
+                for (std::int64_t i = 0; i <= num_workers_; ++i) {
+                    queues_.emplace_back(std::make_unique<task_queue>());
+                }
 
+                std::vector<std::vector<int>> nodes{ pin_to_numa_nodes ? numa_node_cpus() : std::vector<std::vector<int>>{} };
 
+                // the workers use size() (i.e. num_workers_) from the start, while later workers are still being created
+                workers_.reserve(num_workers_);
+                for (std::int64_t i = 0; i < num_workers_; ++i) {
+                    std::vector<int> cpus{ nodes.empty() ? std::vector<int>{} : nodes[i * std::ssize(nodes) / num_workers_] };
+                    workers_.emplace_back([this, i, cpus = std::move(cpus)]() {
+                        // a worker that cannot be pinned (e.g. if the node is not allowed for the process) runs unpinned
+                        static_cast<void>(pin_current_thread(cpus));
+                        work(i);
+                    });
+                }
+            }
 
-    namespace details {
-        template <std::integral T = std::int64_t>
-        struct Interval {
-            Interval(const T& nstart, const T& nstop, const T& nstep) noexcept
-                : start(nstart), stop(nstop), step(nstep) {}
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+            thread_pool(thread_pool&&) = delete;
+            thread_pool& operator=(thread_pool&&) = delete;
 
-            Interval(const T& nstart, const T& nstop) noexcept
-                : Interval(nstart, nstop, 1) {}
+            ~thread_pool()
+            {
+                {
+                    std::scoped_lock lock(mutex_);
+                    stop_ = true;
+                }
+                cv_.notify_all();
+                for (auto& worker : workers_) {
+                    worker.join();
+                }
+            }
 
-            Interval(const T& nstart) noexcept
-                : Interval(nstart, nstart, 1) {}
+            [[nodiscard]] std::int64_t size() const noexcept
+            {
+                return num_workers_;
+            }
 
-            Interval() = default;
-            Interval(const Interval&) = default;
-            Interval& operator=(const Interval&) = default;
-            Interval(Interval&) = default;
-            Interval& operator=(Interval&) = default;
+            template <typename Task>
+            void submit(Task&& task)
+            {
+                push(current_pool_ == this ? worker_index_ : size(), std::forward<Task>(task));
+                cv_.notify_one();
+            }
 
-            T start{ 0 };
-            T stop{ 0 };
-            T step{ 1 };
-        };
+            /**
+            * @note The task is queued to the specified worker, which processes it unless it is stolen by an idle worker.
+            */
+            template <typename Task>
+            void submit_to(std::int64_t worker, Task&& task)
+            {
+                push((worker % size() + size()) % size(), std::forward<Task>(task));
 
-        template <std::integral T>
-        [[nodiscard]] inline Interval<T> reverse(const Interval<T>& i) noexcept
-        {
-            return { i.stop, i.start, -i.step };
-        }
+                // the owner might be any of the waiting workers
+                cv_.notify_all();
+            }
 
-        template <std::integral T>
-        [[nodiscard]] inline Interval<T> modulo(const Interval<T>& i, const T& modulus) noexcept
-        {
-            return { modulo(i.start, modulus), modulo(i.stop, modulus), i.step };
-        }
+            /**
+            * @return True if a pending task was processed by the calling thread.
+            * @note Workers take their own latest task first, and other threads start from the submitted tasks.
+            */
+            bool run_pending_task()
+            {
+                const std::int64_t first{ current_pool_ == this ? worker_index_ : size() };
 
-        template <std::integral T>
-        [[nodiscard]] inline Interval<T> forward(const Interval<T>& i) noexcept
-        {
-            return i.step < T{ 0 } ? reverse(i) : i;
-        }
-    }
+                std::function<void()> task;
+                for (std::int64_t i = 0; i <= size() && !task; ++i) {
+                    task_queue& queue{ *queues_[(first + i) % (size() + 1)] };
+                    std::scoped_lock lock(queue.mutex);
+                    if (queue.tasks.empty()) {
+                        continue;
+                    }
+                    if (i == 0 && current_pool_ == this) {
+                        task = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    }
+                    else {
+                        task = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                }
 
-    using details::Interval;
+                if (!task) {
+                    return false;
+                }
 
-    using details::modulo;
+                pending_.fetch_sub(1);
+                // tasks of this pool run on it, even if the calling thread is not one of its workers
+                struct running_pool_guard {
+                    thread_pool* previous;
+                    ~running_pool_guard()
+                    {
+                        running_pool_ = previous;
+                    }
+                } guard{ std::exchange(running_pool_, this) };
+                task();
+                return true;
+            }
 
-    using details::reverse;
-    using details::forward;
+            /**
+            * @param[in] func Invoked as func(first, last) for each partition of [0, count).
+            * @note The range is split into a few contiguous partitions per worker, which are balanced between the workers by stealing.
+            * The calling thread processes pending tasks until all partitions are processed, so that calls from inside pool tasks are also parallel.
+            */
+            template <typename Func>
+            void parallel_for(std::int64_t count, Func&& func);
 
+            /**
+            * @return The shared pool, which is created on first use (e.g. by a parallel operation) as configured by configure_instance.
+            */
+            [[nodiscard]] static thread_pool& instance()
+            {
+                static thread_pool pool{ use_instance_config() };
+                return pool;
+            }
 
+            /**
+            * @return False if the shared pool is already created, in which case the configuration is not applied.
+            * @note Configures the shared pool before its first use, e.g. to pin its workers (for first touch placement of the buffers that it initializes).
+            */
+            static bool configure_instance(std::int64_t num_threads = std::thread::hardware_concurrency(), bool pin_to_numa_nodes = false)
+            {
+                std::scoped_lock lock(instance_config_mutex_);
+                instance_config& config{ shared_instance_config() };
+                if (config.is_used) {
+                    return false;
+                }
+                config.num_threads = num_threads;
+                config.pin_to_numa_nodes = pin_to_numa_nodes;
+                return true;
+            }
 
+            /**
+            * @return The pool of the task processed by the calling thread, the pool of the calling worker, or the shared pool otherwise.
+            */
+            [[nodiscard]] static thread_pool& current() noexcept
+            {
+                return running_pool_ ? *running_pool_ : (current_pool_ ? *current_pool_ : instance());
+            }
 
-    namespace details {
+        private:
+            struct task_queue {
+                std::mutex mutex;
+                std::deque<std::function<void()>> tasks;
+            };
 
-        template <typename T, typename U>
-        [[nodiscard]] inline bool operator==(const std::span<T>& lhs, const std::span<U>& rhs) {
-            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-        }
+            struct instance_config {
+                std::int64_t num_threads{ std::thread::hardware_concurrency() };
+                bool pin_to_numa_nodes{ false };
+                bool is_used{ false };
+            };
 
-        /*
-        * N-dimensional array definitions:
-        * ================================
-        * 
-        * N - number of dimensions
-        * All sizes of defined groups are proportional to N.
-        * 
-        * Dimensions:
-        * -----------
-        * D = {n(1), n(2), ..., n(N)}
-        * The dimensions order is from the larges to the smallest (i.e. columns).
-        * 
-        * Ranges:
-        * -------
-        * R = {(Rs(1),Re(1),Rt(1)), (Rs(2),Re(2),Rt(2)), ..., (Rs(N),Re(N),Rt(N))}
-        * s.t. Rs - start index
-        *      Re - stop index
-        *      Rt - step
-        * 
-        * Strides:
-        * --------
-        * S = {s(1), s(2), ..., s(N)}
-        * s.t. s(i) - the elements count between two consecutive elements of the i(th) dimension.
-        * 
-        * Offset:
-        * -------
-        * The start index of the current array or sub-array.
-        * Has value of 0 for the base array.
-        * 
-        * Subscripts:
-        * -----------
-        * I = {I(1), I(2), ..., I(N)}
-        * s.t. I is a group of subscripts of specific value in the array.
-        */
+            explicit thread_pool(const instance_config& config)
+                : thread_pool(config.num_threads, config.pin_to_numa_nodes)
+            {
+            }
 
-        /*
-        * N-dimensional array indexing:
-        * =============================
-        * 
-        * Dimensions to strides:
-        * ----------------------
-        * Relates to the original array dimensions for the base strides calculation.
-        * s(N) = 1
-        * s(i) = f(S,D) = s(i+1) * n(i+1) - for every i in {1, 2, ..., N-1}
-        * 
-        * Ranges to strides:
-        * ------------------
-        * Relates to calculation of sub-array strides.
-        * s(i) = f(S',Rt) = s'(i) * Rt(i) for every i in {1, 2, ..., N}
-        * s.t. S' are the previously calculted strides.
-        * 
-        * Ranges to dimensions:
-        * ---------------------
-        * n(i) = f(R) = ceil((Re(i) - Rs(i) + 1) / Rt(i)) for every i in {1, 2, ..., N}
-        * 
-        * Offset:
-        * -------
-        * offset = f(offset', S',Rs) = offset' + dot(S',Rs)
-        * s.t. offset' - previously calculated offset
-        *      S'      - vector of previously calculated strides
-        *      Rs      - vector of ranges start indices
-        * 
-        * Index:
-        * ------
-        * index = f(offset, S, I) = offset + dot(S,I)
-        * 
-        * Number of elements in array:
-        * ----------------------------
-        * count = f(D) = n(1) * n(2) * ... n(N)
-        * 
-        * Check if two dimensions are equal:
-        * ----------------------------------
-        * are_equal = f(D1,D2) = D1(1)=D2(1) and D1(2)=D2(2) and ... and D1(N)=D2(N)
-        * 
-        * Check if ranges are valid/legal:
-        * --------------------------------
-        * are_legal - f(R) = Rt(1)>0 and Rt(2)>0 and ... and Rt(N)>0
-        */
+            [[nodiscard]] static instance_config& shared_instance_config()
+            {
+                static instance_config config{};
+                return config;
+            }
 
-        /**
-        * @note If dimensions contain zero or negative dimension value than the number of elements will be 0.
-        */
-        [[nodiscard]] inline std::int64_t numel(std::span<const std::int64_t> dims) noexcept
-        {
-            if (dims.empty()) {
-                return 0;
+            [[nodiscard]] static instance_config use_instance_config()
+            {
+                std::scoped_lock lock(instance_config_mutex_);
+                instance_config& config{ shared_instance_config() };
+                config.is_used = true;
+                return config;
             }
 
-            std::int64_t res{ 1 };
-            for (std::int64_t i = 0; i < std::ssize(dims); ++i) {
-                if (dims[i] <= 0) {
-                    return 0;
+            template <typename Task>
+            void push(std::int64_t queue_index, Task&& task)
+            {
+                task_queue& queue{ *queues_[queue_index] };
+                {
+                    std::scoped_lock lock(queue.mutex);
+                    queue.tasks.emplace_back(std::forward<Task>(task));
                 }
-                res *= dims[i];
+                std::scoped_lock lock(mutex_);
+                ++pending_;
             }
-            return res;
-        }
 
-        /**
-        * @param[out] strides An already allocated memory for computed strides.
-        * @return Number of computed strides
-        */
-        inline std::int64_t compute_strides(std::span<const std::int64_t> dims, std::span<std::int64_t> strides) noexcept
-        {
-            std::int64_t num_strides{ std::ssize(dims) > std::ssize(strides) ? std::ssize(strides) : std::ssize(dims) };
-            if (num_strides <= 0) {
-                return 0;
+            void work(std::int64_t index)
+            {
+                current_pool_ = this;
+                worker_index_ = index;
+                for (;;) {
+                    if (run_pending_task()) {
+                        continue;
+                    }
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+                    if (stop_ && pending_ == 0) {
+                        return;
+                    }
+                }
             }
 
-            strides[num_strides - 1] = 1;
-            for (std::int64_t i = num_strides - 2; i >= 0; --i) {
-                strides[i] = strides[i + 1] * dims[i + 1];
-            }
-            return num_strides;
-        }
+            const std::int64_t num_workers_;
+            std::vector<std::unique_ptr<task_queue>> queues_;
+            std::vector<std::thread> workers_;
+            std::atomic<std::int64_t> pending_{ 0 };
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            bool stop_{ false };
+
+            inline static thread_local thread_pool* current_pool_{ nullptr };
+            inline static thread_local std::int64_t worker_index_{ 0 };
+            inline static thread_local thread_pool* running_pool_{ nullptr };
+
+            inline static std::mutex instance_config_mutex_{};
+        };
 
         /**
-        * @param[out] strides An already allocated memory for computed strides.
-        * @return Number of computed strides
-        * @note When number of interval is smaller than number of strides, the other strides computed from previous dimensions.
+        * @note Fork/join of tasks on a thread pool. The first exception of the tasks is rethrown by wait.
         */
-        inline std::int64_t compute_strides(std::span<const std::int64_t> previous_dims, std::span<const std::int64_t> previous_strides, std::span<const Interval<std::int64_t>> intervals, std::span<std::int64_t> strides) noexcept
-        {
-            std::int64_t nstrides{ std::ssize(previous_strides) > std::ssize(strides) ? std::ssize(strides) : std::ssize(previous_strides) };
-            if (nstrides <= 0) {
-                return 0;
+        class task_group final {
+        public:
+            explicit task_group(thread_pool& pool = thread_pool::instance())
+                : pool_(pool)
+            {
             }
 
-            std::int64_t ncomp_from_intervals{ nstrides > std::ssize(intervals) ? std::ssize(intervals) : nstrides };
+            task_group(const task_group&) = delete;
+            task_group& operator=(const task_group&) = delete;
+            task_group(task_group&&) = delete;
+            task_group& operator=(task_group&&) = delete;
 
-            // compute strides with interval step
-            for (std::int64_t i = 0; i < ncomp_from_intervals; ++i) {
-                strides[i] = previous_strides[i] * forward(intervals[i]).step;
+            ~task_group()
+            {
+                wait_for_tasks();
             }
 
-            // compute strides from previous dimensions
-            if (std::ssize(intervals) < std::ssize(previous_dims) && nstrides >= std::ssize(previous_dims)) {
-                strides[std::ssize(previous_dims) - 1] = 1;
-                for (std::int64_t i = std::ssize(previous_dims) - 2; i >= std::ssize(intervals); --i) {
-                    strides[i] = strides[i + 1] * previous_dims[i + 1];
-                }
+            template <typename Func>
+            void run(Func&& func)
+            {
+                run_on(-1, std::forward<Func>(func));
             }
 
-            return nstrides;
-        }
+            /**
+            * @note The task is queued to the specified worker of the pool, or as by thread_pool::submit if worker is negative.
+            */
+            template <typename Func>
+            void run_on(std::int64_t worker, Func&& func)
+            {
+                {
+                    std::scoped_lock lock(mutex_);
+                    ++remaining_;
+                }
+                auto task = [this, func = std::forward<Func>(func)]() mutable {
+                    std::exception_ptr error{ nullptr };
+                    try {
+                        func();
+                    }
+                    catch (...) {
+                        error = std::current_exception();
+                    }
+                    std::scoped_lock lock(mutex_);
+                    if (error && !error_) {
+                        error_ = error;
+                    }
+                    if (--remaining_ == 0) {
+                        cv_.notify_all();
+                    }
+                };
 
-        /**
-        * @param[out] dims An already allocated memory for computed dimensions.
-        * @return Number of computed dimensions
-        * @note Previous dimensions are used in case of small number of intervals.
-        */
-        inline std::int64_t compute_dims(std::span<const std::int64_t> previous_dims, std::span<const Interval<std::int64_t>> intervals, std::span<std::int64_t> dims) noexcept
-        {
-            std::int64_t ndims{ std::ssize(previous_dims) > std::ssize(dims) ? std::ssize(dims) : std::ssize(previous_dims) };
-            if (ndims <= 0) {
-                return 0;
+                if (worker < 0) {
+                    pool_.submit(std::move(task));
+                }
+                else {
+                    pool_.submit_to(worker, std::move(task));
+                }
             }
 
-            std::int64_t num_computed_dims{ ndims > std::ssize(intervals) ? std::ssize(intervals) : ndims };
-
-            for (std::int64_t i = 0; i < num_computed_dims; ++i) {
-                Interval<std::int64_t> interval{ forward(modulo(intervals[i], previous_dims[i])) };
-                if (interval.start > interval.stop || interval.step <= 0) {
-                    return 0;
+            /**
+            * @note Pending tasks of the pool are processed by the calling thread until the tasks of this group are completed.
+            */
+            void wait()
+            {
+                wait_for_tasks();
+                std::exception_ptr error{ std::exchange(error_, nullptr) };
+                if (error) {
+                    std::rethrow_exception(error);
                 }
-                dims[i] = static_cast<std::int64_t>(std::ceil((interval.stop - interval.start + 1.0) / interval.step));
             }
 
-            for (std::int64_t i = num_computed_dims; i < ndims; ++i) {
-                dims[i] = previous_dims[i];
+        private:
+            void wait_for_tasks()
+            {
+                for (;;) {
+                    {
+                        std::scoped_lock lock(mutex_);
+                        if (remaining_ == 0) {
+                            return;
+                        }
+                    }
+                    if (pool_.run_pending_task()) {
+                        continue;
+                    }
+                    // the remaining tasks are processed by other threads, which process their own nested tasks while waiting for them
+                    std::unique_lock lock(mutex_);
+                    cv_.wait(lock, [this]() { return remaining_ == 0; });
+                }
             }
 
-            return ndims;
-        }
+            thread_pool& pool_;
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::int64_t remaining_{ 0 };
+            std::exception_ptr error_{ nullptr };
+        };
 
-        [[nodiscard]] inline std::int64_t compute_offset(std::span<const std::int64_t> previous_dims, std::int64_t previous_offset, std::span<const std::int64_t> previous_strides, std::span<const Interval<std::int64_t>> intervals) noexcept
+        template <typename Func>
+        void thread_pool::parallel_for(std::int64_t count, Func&& func)
         {
-            std::int64_t offset{ previous_offset };
+            constexpr std::int64_t partitions_per_worker{ 4 };
 
-            if (previous_dims.empty() || previous_strides.empty() || intervals.empty()) {
-                return offset;
+            std::int64_t num_partitions{ std::min(count, size() > 1 ? size() * partitions_per_worker : std::int64_t{ 1 }) };
+            if (num_partitions <= 1) {
+                if (count > 0) {
+                    func(std::int64_t{ 0 }, count);
+                }
+                return;
             }
 
-            std::int64_t num_computations{ std::ssize(previous_dims) > std::ssize(previous_strides) ? std::ssize(previous_strides) : std::ssize(previous_dims) };
-            num_computations = (num_computations > std::ssize(intervals) ? std::ssize(intervals) : num_computations);
+            auto partition = [count, num_partitions](std::int64_t i) {
+                return std::make_pair(i * count / num_partitions, (i + 1) * count / num_partitions);
+            };
 
-            for (std::int64_t i = 0; i < num_computations; ++i) {
-                offset += previous_strides[i] * forward(modulo(intervals[i], previous_dims[i])).start;
+            // consecutive partitions are queued to the same worker
+            task_group group(*this);
+            for (std::int64_t i = 1; i < num_partitions; ++i) {
+                group.run_on(i * size() / num_partitions, [&func, &partition, i]() {
+                    auto [first, last] = partition(i);
+                    func(first, last);
+                });
             }
-            return offset;
-        }
-
-        /**
-        * @note Extra subscripts are ignored. If number of subscripts are less than number of strides/dimensions, they are considered as the less significant subscripts.
-        */
-        [[nodiscard]] inline std::int64_t subs2ind(std::int64_t offset, std::span<const std::int64_t> strides, std::span<const std::int64_t> dims, std::span<std::int64_t> subs) noexcept
-        {
-            std::int64_t ind{ offset };
 
-            if (strides.empty() || dims.empty() || subs.empty()) {
-                return ind;
+            std::exception_ptr error{ nullptr };
+            try {
+                auto [first, last] = partition(0);
+                func(first, last);
             }
-
-            std::int64_t num_used_subs{ std::ssize(strides) > std::ssize(dims) ? std::ssize(dims) : std::ssize(strides) };
-            num_used_subs = (num_used_subs > std::ssize(subs) ? std::ssize(subs) : num_used_subs);
-
-            std::int64_t num_ignored_subs{ std::ssize(strides) - num_used_subs};
-            if (num_ignored_subs < 0) { // ignore extra subscripts
-                num_ignored_subs = 0;
+            catch (...) {
+                error = std::current_exception();
             }
 
-            for (std::int64_t i = num_ignored_subs; i < std::ssize(strides); ++i) {
-                ind += strides[i] * modulo(subs[i - num_ignored_subs], dims[i]);
+            group.wait();
+            if (error) {
+                std::rethrow_exception(error);
             }
-
-            return ind;
         }
 
-        /*
-        Example:
-        ========
-        D = {2, 2, 2, 2, 3}
-        N = 5
-        Data =
+        /**
+        * @note Calls func(first, last) over partitions of [0, count) on the current thread pool (i.e. the pool of the calling worker, or the shared pool)
+        * if work (e.g. the number of processed elements) reaches parallel_threshold, and func(0, count) otherwise.
+        * @tparam Copied Types of the values that func copies or destroys (e.g. elements or views of arrays).
+        * The partitions are processed serially unless all of them are concurrently copyable.
+        */
+        template <typename... Copied, typename Func>
+        inline void for_each_partition(std::int64_t count, std::int64_t work, Func&& func)
         {
-            {{{{1, 2, 3},
-            {4, 5, 6}},
-
-            {{7, 8, 9},
-            {10, 11, 12}}},
-
-
-            {{{13, 14, 15},
-            {16, 17, 18}},
-
-            {{19, 20, 21},
-            {22, 23, 24}}}},
-
-
-
-            {{{{25, <26>, 27},
-            {28, <29>, 30}},
-
-            {{31, 32, 33},
-            {34, 35, 36}}},
-
-
-            {{{37, 38, 39},
-            {40, 41, 42}},
-
-            {{43, 44, 45},
-            {46, 47, 48}}}}
+            if (!(is_concurrently_copyable_v<Copied> && ...) || work < parallel_threshold) {
+                func(std::int64_t{ 0 }, count);
+                return;
+            }
+            thread_pool::current().parallel_for(count, std::forward<Func>(func));
         }
-        S = {24, 12, 6, 3, 1}
-        offset = 0
 
-        Subarray 1:
-        -----------
-        R = {{1,1,1}, {0,1,2}, {0,0,1}, {0,1,1}, {1,2,2}}
-        D = {1, 1, 1, 2, 1}
-        N = 5
-        Data =
+        /**
+        * @note Large buffers are written by partitions on the current thread pool (as by for_each_partition), so that with first touch
+        * page placement each partition tends to be local to the worker that processes it in later parallel operations (see thread_pool).
+        */
+        template <typename InputIt, typename OutputIt>
+        inline void parallel_copy_n(InputIt first, std::int64_t count, OutputIt dst)
         {
-            {{{{26},
-               {29}}}}
+            for_each_partition<std::iter_value_t<InputIt>, std::iter_value_t<OutputIt>>(count, count, [&](std::int64_t pfirst, std::int64_t plast) {
+                std::copy(first + pfirst, first + plast, dst + pfirst);
+            });
         }
-        S = {24, 24, 6, 3, 2}
-        offset = 25
 
-        Subarray 2 (from subarray 1):
-        -----------------------------
-        R = {{0,0,1}, {0,0,1}, {0,0,1}, {1,1,2}, {0,0,1}}
-        D = {1, 1, 1, 1, 1}
-        N = 5
-        Data =
+        template <typename OutputIt, typename T>
+        inline void parallel_fill_n(OutputIt dst, std::int64_t count, const T& value)
         {
-            {{{{29}}}}
+            for_each_partition<T, std::iter_value_t<OutputIt>>(count, count, [&](std::int64_t pfirst, std::int64_t plast) {
+                std::fill(dst + pfirst, dst + plast, value);
+            });
         }
-        S = {24, 24, 6, 6, 2}
-        offset = 28
-        */
-
-        template <typename Storage = simple_dynamic_vector<std::int64_t>>
-        class arrnd_header {
-        public:
-            using storage_type = Storage;
-
-            arrnd_header() = default;
 
-            arrnd_header(std::span<const std::int64_t> dims)
-            {
-                if ((count_ = numel(dims)) <= 0) {
+        /**
+        * @note Copies the run src[i * src_stride] to dst[i * dst_stride] for i in [0, length).
+        * Contiguous runs of trivially copyable elements are copied by memmove (by partitions on the current thread pool if large and not overlapping).
+        */
+        template <typename T, typename U>
+        inline void copy_run(const T* src, std::int64_t src_stride, std::int64_t length, U* dst, std::int64_t dst_stride)
+        {
+            if constexpr (std::is_same_v<T, U> && std::is_trivially_copyable_v<U>) {
+                if (src_stride == 1 && dst_stride == 1) {
+                    if (length >= parallel_threshold && (std::less<>{}(src + length - 1, dst) || std::less<>{}(dst + length - 1, src))) {
+                        for_each_partition(length, length, [&](std::int64_t first, std::int64_t last) {
+                            std::memcpy(dst + first, src + first, (last - first) * sizeof(U));
+                        });
+                        return;
+                    }
+                    std::memmove(dst, src, length * sizeof(U));
                     return;
                 }
+            }
 
-                dims_ = storage_type(dims.begin(), dims.end());
-
-                strides_ = storage_type(dims.size());
-                compute_strides(dims, strides_);
-
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
+            for (std::int64_t i = 0; i < length; ++i) {
+                dst[i * dst_stride] = src[i * src_stride];
             }
+        }
 
-            arrnd_header(const arrnd_header& previous_hdr, std::span<const Interval<std::int64_t>> intervals)
-            {
-                if (numel(previous_hdr.dims()) <= 0) {
-                    return;
+        /**
+        * @note Result of an asynchronous operation. It can be waited for by get(), or awaited by a coroutine (co_await),
+        * in which case the coroutine is resumed by the thread that completed the operation.
+        * It is also a coroutine return type, i.e. a coroutine that returns async_result<T> runs eagerly until its first suspension.
+        * Copies refer to the same result.
+        */
+        template <typename T>
+        requires (!std::is_void_v<T> && !std::is_reference_v<T>)
+        class async_result final {
+        private:
+            struct shared_state {
+                void set_value(T value)
+                {
+                    complete([&]() { value_.emplace(std::move(value)); });
                 }
 
-                storage_type dims = storage_type(previous_hdr.dims().size());
+                void set_error(std::exception_ptr error)
+                {
+                    complete([&]() { error_ = error; });
+                }
 
-                if (compute_dims(previous_hdr.dims(), intervals, dims) <= 0) {
-                    return;
+                template <typename Func>
+                void complete(Func&& store)
+                {
+                    std::coroutine_handle<> continuation{};
+                    {
+                        std::scoped_lock lock(mutex_);
+                        store();
+                        ready_ = true;
+                        continuation = std::exchange(continuation_, std::coroutine_handle<>{});
+                    }
+                    cv_.notify_all();
+                    if (continuation) {
+                        continuation.resume();
+                    }
                 }
 
-                dims_ = std::move(dims);
-                
-                count_ = numel(dims_);
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                bool ready_{ false };
+                std::optional<T> value_{};
+                std::exception_ptr error_{ nullptr };
+                std::coroutine_handle<> continuation_{};
+            };
 
-                strides_ = storage_type(previous_hdr.dims().size());
-                compute_strides(previous_hdr.dims(), previous_hdr.strides(), intervals, strides_);
+        public:
+            using value_type = T;
 
-                offset_ = compute_offset(previous_hdr.dims(), previous_hdr.offset(), previous_hdr.strides(), intervals);
+            struct promise_type {
+                async_result get_return_object()
+                {
+                    return async_result(state_);
+                }
 
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
+                std::suspend_never initial_suspend() noexcept
+                {
+                    return {};
+                }
 
-                is_subarray_ = previous_hdr.is_subarray() || !std::equal(previous_hdr.dims().begin(), previous_hdr.dims().end(), dims_.begin());
-            }
+                std::suspend_never final_suspend() noexcept
+                {
+                    return {};
+                }
 
-            arrnd_header(const arrnd_header& previous_hdr, std::int64_t omitted_axis)
-                : is_subarray_(previous_hdr.is_subarray())
-            {
-                if (numel(previous_hdr.dims()) <= 0) {
-                    return;
+                void return_value(T value)
+                {
+                    state_->set_value(std::move(value));
                 }
 
-                std::int64_t axis{ modulo(omitted_axis, std::ssize(previous_hdr.dims())) };
-                std::int64_t ndims{ std::ssize(previous_hdr.dims()) > 1 ? std::ssize(previous_hdr.dims()) - 1 : 1 };
+                void unhandled_exception()
+                {
+                    state_->set_error(std::current_exception());
+                }
 
-                dims_ = storage_type(ndims);
+                std::shared_ptr<shared_state> state_{ std::make_shared<shared_state>() };
+            };
 
-                if (previous_hdr.dims().size() > 1) {
-                    for (std::int64_t i = 0; i < axis; ++i) {
-                        dims_[i] = previous_hdr.dims()[i];
+            async_result() = default;
+
+            async_result(const async_result&) = default;
+            async_result& operator=(const async_result&) = default;
+            async_result(async_result&&) noexcept = default;
+            async_result& operator=(async_result&&) noexcept = default;
+
+            ~async_result() = default;
+
+            /**
+            * @note Func is invoked on the shared thread pool, and its result (or exception) is stored in the returned object.
+            */
+            template <typename Func>
+            [[nodiscard]] static async_result run(Func&& func)
+            {
+                auto state = std::make_shared<shared_state>();
+                thread_pool::instance().submit([state, func = std::forward<Func>(func)]() mutable {
+                    try {
+                        state->set_value(func());
                     }
-                    for (std::int64_t i = axis + 1; i < std::ssize(previous_hdr.dims()); ++i) {
-                        dims_[i - 1] = previous_hdr.dims()[i];
+                    catch (...) {
+                        state->set_error(std::current_exception());
                     }
+                });
+                return async_result(state);
+            }
+
+            /**
+            * @note Func is invoked by the calling thread, and the returned object is ready.
+            */
+            template <typename Func>
+            [[nodiscard]] static async_result run_inline(Func&& func)
+            {
+                auto state = std::make_shared<shared_state>();
+                try {
+                    state->set_value(func());
                 }
-                else {
-                    dims_[0] = 1;
+                catch (...) {
+                    state->set_error(std::current_exception());
                 }
+                return async_result(state);
+            }
 
-                strides_ = storage_type(ndims);
-                compute_strides(dims_, strides_);
-
-                count_ = numel(dims_);
+            [[nodiscard]] bool valid() const noexcept
+            {
+                return static_cast<bool>(state_);
+            }
 
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
+            [[nodiscard]] bool ready() const
+            {
+                std::scoped_lock lock(state_->mutex_);
+                return state_->ready_;
             }
 
-            arrnd_header(const arrnd_header& previous_hdr, std::span<const std::int64_t> new_order)
-                : is_subarray_(previous_hdr.is_subarray())
+            /**
+            * @note Pending tasks of the shared thread pool are processed by the calling thread meanwhile, so that waiting inside pool tasks does not block the pool.
+            */
+            void wait() const
             {
-                if (numel(previous_hdr.dims()) <= 0) {
-                    return;
+                while (!ready()) {
+                    if (thread_pool::instance().run_pending_task()) {
+                        continue;
+                    }
+                    // the operation is processed by another thread, which notifies on completion
+                    std::unique_lock lock(state_->mutex_);
+                    state_->cv_.wait(lock, [this]() { return state_->ready_; });
                 }
+            }
 
-                if (new_order.empty()) {
-                    return;
+            /**
+            * @return The operation result, after waiting for it. The exception of a failed operation is rethrown.
+            */
+            [[nodiscard]] T get() const
+            {
+                wait();
+                if (state_->error_) {
+                    std::rethrow_exception(state_->error_);
                 }
+                return *state_->value_;
+            }
 
-                storage_type dims = storage_type(previous_hdr.dims().size());
+            [[nodiscard]] bool await_ready() const
+            {
+                return ready();
+            }
 
-                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
-                    dims[i] = previous_hdr.dims()[modulo(new_order[i], std::ssize(previous_hdr.dims()))];
+            bool await_suspend(std::coroutine_handle<> continuation) const
+            {
+                std::scoped_lock lock(state_->mutex_);
+                if (state_->ready_) {
+                    return false;
                 }
+                state_->continuation_ = continuation;
+                return true;
+            }
 
-                if (numel(previous_hdr.dims()) != numel(dims)) {
-                    return;
-                }
+            [[nodiscard]] T await_resume() const
+            {
+                return get();
+            }
 
-                dims_ = std::move(dims);
-
-                strides_ = storage_type(previous_hdr.dims().size());
-                compute_strides(dims_, strides_);
-
-                count_ = numel(dims_);
-
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
-            }
-
-            arrnd_header(const arrnd_header& previous_hdr, std::int64_t count, std::int64_t axis)
-                : is_subarray_(previous_hdr.is_subarray())
+        private:
+            explicit async_result(std::shared_ptr<shared_state> state)
+                : state_(std::move(state))
             {
-                if (numel(previous_hdr.dims()) <= 0) {
-                    return;
-                }
-
-                storage_type dims = storage_type(previous_hdr.dims().size());
-
-                std::int64_t fixed_axis{ modulo(axis, std::ssize(previous_hdr.dims())) };
-                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
-                    dims[i] = (i != fixed_axis) ? previous_hdr.dims()[i] : previous_hdr.dims()[i] + count;
-                }
-                
-                if ((count_ = numel(dims)) <= 0) {
-                    return;
-                }
-
-                dims_ = std::move(dims);
-
-                strides_ = storage_type(previous_hdr.dims().size());
-                compute_strides(dims_, strides_);
-
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
             }
 
-            arrnd_header(const arrnd_header& previous_hdr, std::span<const std::int64_t> appended_dims, std::int64_t axis)
-                : is_subarray_(previous_hdr.is_subarray())
-            {
-                if (previous_hdr.dims().size() != appended_dims.size()) {
-                    return;
-                }
-
-                if (numel(previous_hdr.dims()) <= 0) {
-                    return;
-                }
+            std::shared_ptr<shared_state> state_{};
+        };
 
-                if (numel(appended_dims) <= 0) {
-                    return;
-                }
+        /**
+        * @return async_result of the value of func(), which is invoked on the shared thread pool.
+        * @tparam Copied Types of the values that func copies or destroys (as for for_each_partition).
+        * func is invoked by the calling thread unless all of them are concurrently copyable.
+        */
+        template <typename... Copied, typename Func>
+        [[nodiscard]] inline auto async_invoke(Func&& func)
+        {
+            using result_type = async_result<std::invoke_result_t<std::decay_t<Func>&>>;
+            if constexpr ((is_concurrently_copyable_v<Copied> && ...)) {
+                return result_type::run(std::forward<Func>(func));
+            }
+            else {
+                return result_type::run_inline(std::forward<Func>(func));
+            }
+        }
+    }
 
-                std::int64_t fixed_axis{ modulo(axis, std::ssize(previous_hdr.dims())) };
+    using details::parallel_threshold;
+    using details::thread_pool;
+    using details::task_group;
+    using details::async_result;
+    using details::async_invoke;
 
-                bool are_dims_valid_for_append{ true };
-                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
-                    if (i != fixed_axis && previous_hdr.dims()[i] != appended_dims[i]) {
-                        are_dims_valid_for_append = false;
-                    }
-                }
-                if (!are_dims_valid_for_append) {
-                    return;
-                }
+    namespace details {
+        struct arrnd_tag {};
 
-                storage_type dims = storage_type(previous_hdr.dims().size());
+        template <typename T>
+        concept arrnd_complient = std::is_same_v<typename T::tag, arrnd_tag>;
+    }
 
-                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
-                    dims[i] = (i != fixed_axis) ? previous_hdr.dims()[i] : previous_hdr.dims()[i] + appended_dims[fixed_axis];
-                }
+    namespace details {
+        template <typename T>
+        [[nodiscard]] inline constexpr T default_atol() noexcept
+        {
+            return T{};
+        }
 
-                if ((count_ = numel(dims)) <= 0) {
-                    return;
-                }
+        template <std::integral T>
+        [[nodiscard]] inline constexpr T default_atol() noexcept
+        {
+            return T{ 0 };
+        }
 
-                dims_ = std::move(dims);
+        template <std::floating_point T>
+        [[nodiscard]] inline constexpr T default_atol() noexcept
+        {
+            return T{ 1e-8 };
+        }
 
-                strides_ = storage_type(previous_hdr.dims().size());
-                compute_strides(dims_, strides_);
+        template <typename T>
+        [[nodiscard]] inline constexpr T default_rtol() noexcept
+        {
+            return T{};
+        }
 
-                last_index_ = offset_ + std::inner_product(dims_.begin(), dims_.end(), strides_.begin(), 0,
-                    [](auto a, auto b) { return a + b; },
-                    [](auto a, auto b) { return (a - 1) * b; });
-            }
+        template <std::integral T>
+        [[nodiscard]] inline constexpr T default_rtol() noexcept
+        {
+            return T{ 0 };
+        }
 
-            arrnd_header(arrnd_header&& other) = default;
-            arrnd_header& operator=(arrnd_header&& other) = default;
+        template <std::floating_point T>
+        [[nodiscard]] inline constexpr T default_rtol() noexcept
+        {
+            return T{ 1e-5 };
+        }
 
-            arrnd_header(const arrnd_header& other) = default;
-            arrnd_header& operator=(const arrnd_header& other) = default;
+        template <typename T1, typename T2> requires (!arrnd_complient<T1> && !arrnd_complient<T2>)
+        [[nodiscard]] inline constexpr bool close(const T1& a, const T2& b, const decltype(T1{} - T2{})& atol = default_atol<decltype(T1{} - T2{}) > (), const decltype(T1{} - T2{})& rtol = default_rtol<decltype(T1{} - T2{}) > ()) noexcept
+        {
+            const decltype(a - b) reps{ rtol * (abs(a) > abs(b) ? abs(a) : abs(b)) };
+            return abs(a - b) <= (atol > reps ? atol : reps);
+        }
 
-            virtual ~arrnd_header() = default;
+        /**
+        * @note Integer divisor of precomputed multiplier and shifts (Granlund-Montgomery, as in libdivide), i.e. n / d is computed by a multiplication,
+        * an addition and shifts instead of a hardware division. For repeated division by the same value (e.g. of the elements of an array).
+        * 64 bit division requires 128 bit multiplication, and falls back to hardware division where it is not available.
+        * Division by zero has no multiplier, and is a hardware division (of undefined behavior, as for the built-in operator).
+        */
+        template <std::integral T>
+        class fast_divisor final {
+        public:
+            using value_type = T;
 
-            [[nodiscard]] std::int64_t count() const noexcept
+            constexpr fast_divisor() noexcept
+                : fast_divisor(T{ 1 })
             {
-                return count_;
             }
 
-            [[nodiscard]] std::span<const std::int64_t> dims() const noexcept
+            explicit constexpr fast_divisor(T d) noexcept
+                : d_(d)
             {
-                return std::span<const std::int64_t>(dims_.data(), dims_.size());
+                if constexpr (is_fast) {
+                    const unsigned_type ad{ d < 0 ? static_cast<unsigned_type>(unsigned_type{ 0 } - static_cast<unsigned_type>(d)) : static_cast<unsigned_type>(d) };
+                    if (ad == 0) {
+                        return;
+                    }
+
+                    int l{ 0 };
+                    while ((wide_type{ 1 } << l) < ad) {
+                        ++l;
+                    }
+
+                    if constexpr (std::is_unsigned_v<T>) {
+                        multiplier_ = static_cast<unsigned_type>((wide_type{ 1 } << bits) * ((wide_type{ 1 } << l) - ad) / ad + 1);
+                        shift1_ = l < 1 ? l : 1;
+                        shift2_ = l > 1 ? l - 1 : 0;
+                    }
+                    else {
+                        l = l > 1 ? l : 1;
+                        multiplier_ = static_cast<unsigned_type>((wide_type{ 1 } << (bits + l - 1)) / ad + 1);
+                        shift2_ = l - 1;
+                    }
+                }
             }
 
-            [[nodiscard]] std::span<const std::int64_t> strides() const noexcept
+            [[nodiscard]] constexpr T divisor() const noexcept
             {
-                return std::span<const std::int64_t>(strides_.data(), strides_.size());
+                return d_;
             }
 
-            [[nodiscard]] std::int64_t offset() const noexcept
+            /**
+            * @return n / d (rounded toward zero).
+            */
+            [[nodiscard]] constexpr T divide(T n) const noexcept
             {
-                return offset_;
+                if constexpr (!is_fast) {
+                    return n / d_;
+                }
+                else if (d_ == 0) {
+                    return n / d_;
+                }
+                else if constexpr (std::is_unsigned_v<T>) {
+                    const unsigned_type t{ static_cast<unsigned_type>((static_cast<wide_type>(multiplier_) * n) >> bits) };
+                    return static_cast<T>((t + static_cast<unsigned_type>(static_cast<unsigned_type>(n - t) >> shift1_)) >> shift2_);
+                }
+                else {
+                    const signed_wide_type product{ static_cast<signed_wide_type>(static_cast<T>(multiplier_)) * n };
+                    const T high{ static_cast<T>(product >> bits) };
+                    T q{ static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(n) + static_cast<unsigned_type>(high))) };
+                    q = static_cast<T>((q >> shift2_) - (n >> (bits - 1)));
+                    return d_ < 0 ? static_cast<T>(-q) : q;
+                }
             }
 
-            [[nodiscard]] bool is_subarray() const noexcept
+            /**
+            * @return n % d (of the sign of n).
+            */
+            [[nodiscard]] constexpr T remainder(T n) const noexcept
             {
-                return is_subarray_;
+                return static_cast<T>(n - divide(n) * d_);
             }
 
-            [[nodiscard]] bool empty() const noexcept
+            [[nodiscard]] friend constexpr T operator/(T n, const fast_divisor& d) noexcept
             {
-                return dims_.empty();
+                return d.divide(n);
             }
 
-            [[nodiscard]] std::int64_t last_index() const noexcept
+            [[nodiscard]] friend constexpr T operator%(T n, const fast_divisor& d) noexcept
             {
-                return last_index_;
+                return d.remainder(n);
             }
 
         private:
-            storage_type dims_{};
-            storage_type strides_{};
-            std::int64_t count_{ 0 };
-            std::int64_t offset_{ 0 };
-            std::int64_t last_index_{ 0 };
-            bool is_subarray_{ false };
+            static constexpr int bits{ std::numeric_limits<std::make_unsigned_t<T>>::digits };
+
+#if defined(__SIZEOF_INT128__)
+            static constexpr bool is_fast{ bits <= 64 };
+            using wide_type = std::conditional_t<(bits <= 32), std::uint64_t, unsigned __int128>;
+            using signed_wide_type = std::conditional_t<(bits <= 32), std::int64_t, __int128>;
+#else
+            static constexpr bool is_fast{ bits <= 32 };
+            using wide_type = std::uint64_t;
+            using signed_wide_type = std::int64_t;
+#endif
+            using unsigned_type = std::make_unsigned_t<T>;
+
+            T d_{ 1 };
+            unsigned_type multiplier_{ 0 };
+            int shift1_{ 0 };
+            int shift2_{ 0 };
         };
 
+        /**
+        * @note Scalars of the same integral type of the array elements divide them by a fast_divisor (no integral promotion is involved).
+        */
+        template <typename T, typename U>
+        concept fast_divisible = std::integral<T> && std::is_same_v<T, U> && (sizeof(T) >= sizeof(int));
 
-        template <typename Storage = simple_dynamic_vector<std::int64_t>, typename Header = arrnd_header<>>
-        class arrnd_general_indexer final
-        {
+        /**
+        * @note Counter-based random number generator (Philox4x32-10 of Salmon et al.), i.e. a keyed bijection of 128 bit counters,
+        * so that the numbers of a counter depend only on the seed and the counter, and can be generated in any order and by any thread.
+        */
+        class philox_generator final {
         public:
-            using storage_type = Storage;
-            using header_type = Header;
+            using result_type = std::array<std::uint32_t, 4>;
 
-            constexpr arrnd_general_indexer(const header_type& hdr, bool backward = false)
-                : arrnd_general_indexer(hdr, std::span<const std::int64_t>{}, backward)
+            explicit constexpr philox_generator(std::uint64_t seed = 0) noexcept
+                : key_{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }
             {
             }
 
-            constexpr arrnd_general_indexer(const header_type& hdr, std::int64_t axis, bool backward = false)
-                : arrnd_general_indexer(hdr, order_from_major_axis(hdr.dims().size(), axis), backward)
+            [[nodiscard]] constexpr result_type operator()(std::uint64_t counter, std::uint64_t stream = 0) const noexcept
             {
-            }
+                std::uint32_t c0{ static_cast<std::uint32_t>(counter) };
+                std::uint32_t c1{ static_cast<std::uint32_t>(counter >> 32) };
+                std::uint32_t c2{ static_cast<std::uint32_t>(stream) };
+                std::uint32_t c3{ static_cast<std::uint32_t>(stream >> 32) };
+                std::uint32_t k0{ key_[0] };
+                std::uint32_t k1{ key_[1] };
 
-            constexpr arrnd_general_indexer(const header_type& hdr, std::span<const std::int64_t> order, bool backward = false)
-                : dims_(hdr.dims().begin(), hdr.dims().end()), strides_(hdr.strides().begin(), hdr.strides().end())
-            {
-                if (!order.empty()) {
-                    dims_ = reorder(dims_, order);
-                    strides_ = reorder(strides_, order);
+                for (int round = 0; round < 10; ++round) {
+                    const std::uint64_t p0{ std::uint64_t{ 0xD2511F53u } * c0 };
+                    const std::uint64_t p1{ std::uint64_t{ 0xCD9E8D57u } * c2 };
+                    c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                    c1 = static_cast<std::uint32_t>(p1);
+                    c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                    c3 = static_cast<std::uint32_t>(p0);
+                    k0 += 0x9E3779B9u;
+                    k1 += 0xBB67AE85u;
                 }
-                std::tie(dims_, strides_) = reduce_dimensions(dims_, strides_);
 
-                first_index_ = hdr.offset();
-                last_index_ = hdr.last_index();
-                last_first_diff_ = static_cast<std::uint64_t>(last_index_ - first_index_);
+                return { c0, c1, c2, c3 };
+            }
 
-                ndims_ = dims_.size();
+        private:
+            std::array<std::uint32_t, 2> key_;
+        };
 
-                if (ndims_ > 0) {
-                    first_dim_ = dims_[ndims_ - 1];
-                    first_stride_ = strides_[ndims_ - 1];
-                    first_ind_ = backward ? first_dim_ - 1 : 0;
-                }
+        /**
+        * @return Uniform value in [0, 1) of the first words of r (24 random bits for float, 53 otherwise).
+        */
+        template <std::floating_point T>
+        [[nodiscard]] inline constexpr T unit_uniform(const philox_generator::result_type& r) noexcept
+        {
+            if constexpr (std::is_same_v<T, float>) {
+                return static_cast<float>(r[0] >> 8) * 0x1p-24f;
+            }
+            else {
+                const std::uint64_t x{ (std::uint64_t{ r[1] } << 32) | r[0] };
+                return static_cast<T>(static_cast<double>(x >> 11) * 0x1p-53);
+            }
+        }
 
-                if (ndims_ > 1) {
-                    second_dim_ = dims_[ndims_ - 2];
-                    second_stride_ = strides_[ndims_ - 2];
-                    second_ind_ = backward ? second_dim_ - 1 : 0;
-                }
+        /**
+        * @return Uniform integer in [low, high] of the first words of r (by multiplication and shift, of negligible bias).
+        */
+        template <std::integral T>
+        [[nodiscard]] inline constexpr T uniform_integer(const philox_generator::result_type& r, T low, T high) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            const std::uint64_t x{ (std::uint64_t{ r[1] } << 32) | r[0] };
+            const std::uint64_t range{ static_cast<std::uint64_t>(static_cast<unsigned_type>(high) - static_cast<unsigned_type>(low)) + 1 };
+            if (range == 0) {
+                return static_cast<T>(x);
+            }
+#if defined(__SIZEOF_INT128__)
+            const std::uint64_t offset{ static_cast<std::uint64_t>((static_cast<unsigned __int128>(x) * range) >> 64) };
+#else
+            const std::uint64_t offset{ x % range };
+#endif
+            return static_cast<T>(static_cast<unsigned_type>(static_cast<unsigned_type>(low) + offset));
+        }
 
-                if (ndims_ > 2) {
-                    third_dim_ = dims_[ndims_ - 3];
-                    third_stride_ = strides_[ndims_ - 3];
-                    third_ind_ = backward ? third_dim_ - 1 : 0;
-                }
+        /**
+        * @return Standard normal value of r (Box-Muller transform of its two 64 bit halves).
+        */
+        [[nodiscard]] inline double standard_normal(const philox_generator::result_type& r) noexcept
+        {
+            const std::uint64_t x1{ (std::uint64_t{ r[1] } << 32) | r[0] };
+            const std::uint64_t x2{ (std::uint64_t{ r[3] } << 32) | r[2] };
+            const double u1{ static_cast<double>((x1 >> 11) + 1) * 0x1p-53 };
+            const double u2{ static_cast<double>(x2 >> 11) * 0x1p-53 };
+            return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * std::numbers::pi * u2);
+        }
 
-                if (ndims_ > 3) {
-                    indices_.resize(ndims_ - 3);
-                    for (std::int64_t i = 0; i < indices_.size(); ++i) {
-                        indices_[i] = backward ? dims_[i] - 1 : 0;
-                    }
-                }
+        template <std::integral T1, std::integral T2>
+        [[nodiscard]] inline constexpr auto modulo(const T1& value, const T2& modulus) noexcept -> decltype((value% modulus) + modulus)
+        {
+            return ((value % modulus) + modulus) % modulus;
+        }
 
-                current_index_ = backward ? last_index_ : first_index_;
-            }
+        /**
+        * @note Modulo of a fixed modulus, e.g. of many values.
+        */
+        template <std::integral T>
+        [[nodiscard]] inline constexpr T modulo(const T& value, const fast_divisor<T>& modulus) noexcept
+        {
+            const T r{ modulus.remainder(value) };
+            return (r != 0 && ((r < 0) != (modulus.divisor() < 0))) ? static_cast<T>(r + modulus.divisor()) : r;
+        }
+    }
 
-            constexpr arrnd_general_indexer() = default;
+    using details::default_atol;
+    using details::default_rtol;
 
-            constexpr arrnd_general_indexer(const arrnd_general_indexer& other) = default;
-            constexpr arrnd_general_indexer& operator=(const arrnd_general_indexer& other) = default;
+    using details::close;
+    using details::modulo;
+    using details::fast_divisor;
 
-            constexpr arrnd_general_indexer(arrnd_general_indexer&& other) noexcept = default;
-            constexpr arrnd_general_indexer& operator=(arrnd_general_indexer&& other) noexcept = default;
 
-            constexpr ~arrnd_general_indexer() = default;
 
-            constexpr arrnd_general_indexer& operator++() noexcept
-            {
-                if (current_index_ < first_index_) {
-                    current_index_ = first_index_;
-                    return *this;
-                }
-                if (current_index_ >= last_index_) {
-                    current_index_ = last_index_ + 1;
-                    return *this;
-                }
-                ++first_ind_;
-                current_index_ += first_stride_;
-                if (first_ind_ < first_dim_) {
-                    return *this;
-                }
-                current_index_ -= first_ind_ * first_stride_;
-                first_ind_ = 0;
-                if (ndims_ > 1) {
-                    ++second_ind_;
-                    current_index_ += second_stride_;
-                    if (second_ind_ < second_dim_) {
-                        return *this;
-                    }
-                    current_index_ -= second_ind_ * second_stride_;
-                    second_ind_ = 0;
-                }
-                if (ndims_ > 2) {
-                    ++third_ind_;
-                    current_index_ += third_stride_;
-                    if (third_ind_ < third_dim_) {
-                        return *this;
+    namespace details {
+        template <std::integral T = std::int64_t>
+        struct Interval {
+            Interval(const T& nstart, const T& nstop, const T& nstep) noexcept
+                : start(nstart), stop(nstop), step(nstep) {}
+
+            Interval(const T& nstart, const T& nstop) noexcept
+                : Interval(nstart, nstop, 1) {}
+
+            Interval(const T& nstart) noexcept
+                : Interval(nstart, nstart, 1) {}
+
+            Interval() = default;
+            Interval(const Interval&) = default;
+            Interval& operator=(const Interval&) = default;
+            Interval(Interval&) = default;
+            Interval& operator=(Interval&) = default;
+
+            T start{ 0 };
+            T stop{ 0 };
+            T step{ 1 };
+        };
+
+        template <std::integral T>
+        [[nodiscard]] inline Interval<T> reverse(const Interval<T>& i) noexcept
+        {
+            return { i.stop, i.start, -i.step };
+        }
+
+        template <std::integral T>
+        [[nodiscard]] inline Interval<T> modulo(const Interval<T>& i, const T& modulus) noexcept
+        {
+            return { modulo(i.start, modulus), modulo(i.stop, modulus), i.step };
+        }
+
+        template <std::integral T>
+        [[nodiscard]] inline Interval<T> forward(const Interval<T>& i) noexcept
+        {
+            return i.step < T{ 0 } ? reverse(i) : i;
+        }
+    }
+
+    using details::Interval;
+
+    using details::modulo;
+
+    using details::reverse;
+    using details::forward;
+
+
+
+    namespace details {
+
+        /*
+        * Summation policies:
+        * ===================
+        *
+        * pairwise_summation      - blocks of fixed size are summed by independent lanes, and block results are merged as a binary tree.
+        * kahan_babuska_summation - each lane carries a Neumaier compensation term.
+        * widened_summation<Acc>  - each lane accumulates in a wider type (Acc, or a default wider type of the value type).
+        *
+        * All policies split the input into independent lanes, so the inner loops have no loop carried dependency and can be vectorized.
+        */
+
+        struct pairwise_summation {};
+
+        struct kahan_babuska_summation {};
+
+        template <typename Acc = void>
+        struct widened_summation {};
+
+        template <typename T>
+        struct widened_accumulator {
+            using type = T;
+        };
+
+        template <>
+        struct widened_accumulator<float> {
+            using type = double;
+        };
+
+        template <>
+        struct widened_accumulator<double> {
+            using type = long double;
+        };
+
+        template <std::signed_integral T>
+        struct widened_accumulator<T> {
+            using type = std::int64_t;
+        };
+
+        template <std::unsigned_integral T>
+        struct widened_accumulator<T> {
+            using type = std::uint64_t;
+        };
+
+        template <typename T, typename Policy>
+        class summation_accumulator;
+
+        template <typename T>
+        class summation_accumulator<T, pairwise_summation> final {
+        public:
+            static constexpr std::int64_t lanes = 8;
+            static constexpr std::int64_t block_size = 16 * lanes;
+
+            constexpr void accumulate(const T* first, std::int64_t count) noexcept
+            {
+                while (count > 0) {
+                    if (block_count_ == 0 && count >= block_size) {
+                        push(sum_block(first, block_size));
+                        first += block_size;
+                        count -= block_size;
+                        continue;
                     }
-                    current_index_ -= third_ind_ * third_stride_;
-                    third_ind_ = 0;
-                }
-                for (std::int64_t i = ndims_ - 4; i >= 0; --i) {
-                    ++indices_[i];
-                    current_index_ += strides_[i];
-                    if (indices_[i] < dims_[i]) {
-                        return *this;
+
+                    std::int64_t n{ std::min(block_size - block_count_, count) };
+                    std::copy_n(first, n, block_ + block_count_);
+                    block_count_ += n;
+                    first += n;
+                    count -= n;
+
+                    if (block_count_ == block_size) {
+                        push(sum_block(block_, block_size));
+                        block_count_ = 0;
                     }
-                    current_index_ -= indices_[i] * strides_[i];
-                    indices_[i] = 0;
                 }
-                return *this;
             }
 
-            constexpr arrnd_general_indexer operator++(int) noexcept
+            [[nodiscard]] constexpr T result() const noexcept
             {
-                arrnd_general_indexer<storage_type, header_type> temp{ *this };
-                ++(*this);
-                return temp;
+                T res{ block_count_ > 0 ? sum_block(block_, block_count_) : T{} };
+                for (std::int64_t i = num_partials_ - 1; i >= 0; --i) {
+                    res = partials_[i] + res;
+                }
+                return res;
             }
 
-            constexpr arrnd_general_indexer& operator+=(std::int64_t count) noexcept
+        private:
+            [[nodiscard]] static constexpr T sum_block(const T* first, std::int64_t count) noexcept
             {
-                for (std::int64_t i = 0; i < count; ++i) {
-                    ++(*this);
+                T acc[lanes]{};
+                const std::int64_t full{ count - count % lanes };
+                for (std::int64_t i = 0; i < full; i += lanes) {
+                    for (std::int64_t j = 0; j < lanes; ++j) {
+                        acc[j] += first[i + j];
+                    }
                 }
-                return *this;
+                for (std::int64_t i = full; i < count; ++i) {
+                    acc[0] += first[i];
+                }
+                return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
             }
 
-            arrnd_general_indexer operator+(std::int64_t count) noexcept
+            // blocks sums are merged like a binary counter, so that only partial sums of the same level are added
+            constexpr void push(T value) noexcept
             {
-                arrnd_general_indexer<storage_type, header_type> temp{ *this };
-                temp += count;
-                return temp;
+                std::int64_t level{ 0 };
+                while (num_partials_ > 0 && levels_[num_partials_ - 1] == level) {
+                    value = partials_[--num_partials_] + value;
+                    ++level;
+                }
+                partials_[num_partials_] = value;
+                levels_[num_partials_] = level;
+                ++num_partials_;
             }
 
-            constexpr arrnd_general_indexer& operator--() noexcept
+            T block_[block_size]{};
+            std::int64_t block_count_{ 0 };
+
+            T partials_[64]{};
+            std::int64_t levels_[64]{};
+            std::int64_t num_partials_{ 0 };
+        };
+
+        template <typename T>
+        class summation_accumulator<T, kahan_babuska_summation> final {
+        public:
+            static constexpr std::int64_t lanes = 8;
+            static constexpr std::int64_t block_size = 16 * lanes;
+
+            constexpr void accumulate(const T* first, std::int64_t count) noexcept
             {
-                if (current_index_ <= first_index_) {
-                    current_index_ = first_index_ - 1;
-                    return *this;
-                }
-                if (current_index_ == last_index_ + 1) {
-                    current_index_ = last_index_;
-                    return *this;
-                }
-                --first_ind_;
-                current_index_ -= first_stride_;
-                if (first_ind_ > -1) {
-                    return *this;
-                }
-                first_ind_ = first_dim_ - 1;
-                current_index_ += (first_ind_ + 1) * first_stride_;
-                if (ndims_ > 1) {
-                    --second_ind_;
-                    current_index_ -= second_stride_;
-                    if (second_ind_ > -1) {
-                        return *this;
-                    }
-                    second_ind_ = second_dim_ - 1;
-                    current_index_ += (second_ind_ + 1) * second_stride_;
-                }
-                if (ndims_ > 2) {
-                    --third_ind_;
-                    current_index_ -= third_stride_;
-                    if (third_ind_ > -1) {
-                        return *this;
+                const std::int64_t full{ count - count % lanes };
+                for (std::int64_t i = 0; i < full; i += lanes) {
+                    for (std::int64_t j = 0; j < lanes; ++j) {
+                        add(sums_[j], compensations_[j], first[i + j]);
                     }
-                    third_ind_ = third_dim_ - 1;
-                    current_index_ += (third_ind_ + 1) * third_stride_;
                 }
-                for (std::int64_t i = ndims_ - 4; i >= 0; --i) {
-                    --indices_[i];
-                    current_index_ -= strides_[i];
-                    if (indices_[i] > -1) {
-                        return *this;
-                    }
-                    indices_[i] = dims_[i] - 1;
-                    current_index_ += (indices_[i] + 1) * strides_[i];
+                for (std::int64_t i = full; i < count; ++i) {
+                    add(sums_[0], compensations_[0], first[i]);
                 }
-                return *this;
-            }
-
-            constexpr arrnd_general_indexer operator--(int) noexcept
-            {
-                arrnd_general_indexer<storage_type, header_type> temp{ *this };
-                --(*this);
-                return temp;
             }
 
-            constexpr arrnd_general_indexer& operator-=(std::int64_t count) noexcept
+            [[nodiscard]] constexpr T result() const noexcept
             {
-                for (std::int64_t i = 0; i < count; ++i) {
-                    --(*this);
+                T sum{};
+                T compensation{};
+                for (std::int64_t j = 0; j < lanes; ++j) {
+                    add(sum, compensation, sums_[j]);
+                    compensation += compensations_[j];
                 }
-                return *this;
+                return sum + compensation;
             }
 
-            constexpr arrnd_general_indexer operator-(std::int64_t count) noexcept
+        private:
+            static constexpr void add(T& sum, T& compensation, const T& value) noexcept
             {
-                arrnd_general_indexer<storage_type, header_type> temp{ *this };
-                temp -= count;
-                return temp;
+                T t{ sum + value };
+                bool sum_dominates{ (sum < T{} ? -sum : sum) >= (value < T{} ? -value : value) };
+                compensation += sum_dominates ? (sum - t) + value : (value - t) + sum;
+                sum = t;
             }
 
-            [[nodiscard]] explicit constexpr operator bool() const noexcept
-            {
-                return static_cast<std::uint64_t>(current_index_ - first_index_) <= last_first_diff_;
-            }
+            T sums_[lanes]{};
+            T compensations_[lanes]{};
+        };
 
-            [[nodiscard]] constexpr std::int64_t operator*() const noexcept
-            {
-                return current_index_;
-            }
+        template <typename T, typename Acc>
+        class summation_accumulator<T, widened_summation<Acc>> final {
+        public:
+            using accumulator_type = std::conditional_t<std::is_void_v<Acc>, typename widened_accumulator<T>::type, Acc>;
 
-        private:
-            constexpr static storage_type order_from_major_axis(std::int64_t order_size, std::int64_t axis)
+            static constexpr std::int64_t lanes = 8;
+            static constexpr std::int64_t block_size = 16 * lanes;
+
+            constexpr void accumulate(const T* first, std::int64_t count) noexcept
             {
-                storage_type new_ordered_indices(order_size);
-                std::iota(new_ordered_indices.begin(), new_ordered_indices.end(), static_cast<std::int64_t>(0));
-                new_ordered_indices[0] = axis;
-                std::int64_t pos = 1;
-                for (std::int64_t i = 0; i < order_size; ++i) {
-                    if (i != axis) {
-                        new_ordered_indices[pos++] = i;
+                const std::int64_t full{ count - count % lanes };
+                for (std::int64_t i = 0; i < full; i += lanes) {
+                    for (std::int64_t j = 0; j < lanes; ++j) {
+                        acc_[j] += static_cast<accumulator_type>(first[i + j]);
                     }
                 }
-                return new_ordered_indices;
+                for (std::int64_t i = full; i < count; ++i) {
+                    acc_[0] += static_cast<accumulator_type>(first[i]);
+                }
             }
 
-            constexpr static storage_type reorder(std::span<const std::int64_t> vec, std::span<const std::int64_t> indices)
+            [[nodiscard]] constexpr accumulator_type result() const noexcept
             {
-                std::int64_t size = std::min(std::ssize(vec), std::ssize(indices));
-                storage_type res(size);
-                for (std::int64_t i = 0; i < size; ++i) {
-                    res[i] = vec[indices[i]];
-                }
-                return res;
+                return ((acc_[0] + acc_[1]) + (acc_[2] + acc_[3])) + ((acc_[4] + acc_[5]) + (acc_[6] + acc_[7]));
             }
 
-            constexpr static std::tuple<
-                storage_type, storage_type>
-                reduce_dimensions(std::span<const std::int64_t> dims, std::span<const std::int64_t> strides)
-            {
-                std::tuple<
-                    storage_type,
-                    storage_type> reds(dims.size(), dims.size());
+        private:
+            accumulator_type acc_[lanes]{};
+        };
 
-                auto& [rdims, rstrides] = reds;
+        /**
+        * @return Position (relative to first) of the first element e such that no other element o satisfies comp(o, e), or -1 if count is not positive.
+        * @note Each lane tracks its best value and index, and the lanes are merged at the end (ties are resolved by the smaller index).
+        */
+        template <typename T, typename Compare>
+        [[nodiscard]] inline std::int64_t arg_extremum(const T* first, std::int64_t count, Compare comp)
+        {
+            constexpr std::int64_t lanes = 8;
 
-                std::int64_t rndims = 0;
+            if (count <= 0) {
+                return -1;
+            }
 
-                std::int64_t ri = 0;
-                for (std::int64_t i = 0; i < std::ssize(dims); ++i) {
-                    if (dims[i] > 1) {
-                        rdims[ri] = dims[i];
-                        rstrides[ri] = strides[i];
-                        ++ri;
-                        ++rndims;
+            if (count < 2 * lanes) {
+                std::int64_t best{ 0 };
+                for (std::int64_t i = 1; i < count; ++i) {
+                    if (comp(first[i], first[best])) {
+                        best = i;
                     }
                 }
+                return best;
+            }
 
-                for (std::int64_t i = rndims - 1; i >= 1; --i) {
-                    if (rdims[i] == rstrides[i - 1]) {
-                        rdims[i - 1] *= rdims[i];
-                        rstrides[i - 1] = rstrides[i];
-                        --rndims;
-                    }
-                }
+            T best_values[lanes];
+            std::int64_t best_indices[lanes];
+            for (std::int64_t j = 0; j < lanes; ++j) {
+                best_values[j] = first[j];
+                best_indices[j] = j;
+            }
 
-                if (rndims != std::ssize(dims)) {
-                    rdims.resize(rndims);
-                    rstrides.resize(rndims);
+            std::int64_t i = lanes;
+            for (; i + lanes <= count; i += lanes) {
+                for (std::int64_t j = 0; j < lanes; ++j) {
+                    bool better{ comp(first[i + j], best_values[j]) };
+                    best_values[j] = better ? first[i + j] : best_values[j];
+                    best_indices[j] = better ? i + j : best_indices[j];
                 }
+            }
 
-                return reds;
+            std::int64_t best{ best_indices[0] };
+            for (std::int64_t j = 1; j < lanes; ++j) {
+                if (comp(first[best_indices[j]], first[best]) || (!comp(first[best], first[best_indices[j]]) && best_indices[j] < best)) {
+                    best = best_indices[j];
+                }
+            }
+            for (; i < count; ++i) {
+                if (comp(first[i], first[best])) {
+                    best = i;
+                }
             }
 
-            storage_type dims_;
-            storage_type strides_;
-            std::int64_t first_index_;
-            std::int64_t last_index_;
-            std::uint64_t last_first_diff_;
-            std::int64_t ndims_;
-
-            std::int64_t first_stride_;
-            std::int64_t first_dim_;
-            std::int64_t first_ind_;
-
-            std::int64_t second_stride_;
-            std::int64_t second_dim_;
-            std::int64_t second_ind_;
-
-            std::int64_t third_stride_;
-            std::int64_t third_dim_;
-            std::int64_t third_ind_;
-
-            storage_type indices_;
-            std::int64_t current_index_;
-        };
+            return best;
+        }
 
+        /**
+        * @note count, mean and sum of squared deviations from the mean (m2) of a sequence of values.
+        * Two states are combined by the pairwise update of Chan et al., so that partial results can be computed independently (e.g. by lanes or threads) and merged.
+        */
+        template <typename T>
+        struct moments {
+            std::int64_t count{ 0 };
+            T mean{};
+            T m2{};
 
+            constexpr void merge(const moments& other) noexcept
+            {
+                if (other.count == 0) {
+                    return;
+                }
+                if (count == 0) {
+                    *this = other;
+                    return;
+                }
 
+                const std::int64_t total{ count + other.count };
+                const T delta{ other.mean - mean };
+                const T ratio{ static_cast<T>(other.count) / static_cast<T>(total) };
 
-        template <typename Header = arrnd_header<>>
-        class arrnd_fast_indexer final
-        {
-        public:
-            using header_type = Header;
+                mean += delta * ratio;
+                m2 += other.m2 + delta * delta * static_cast<T>(count) * ratio;
+                count = total;
+            }
 
-            constexpr arrnd_fast_indexer(const header_type& hdr, bool backward = false)
-                : arrnd_fast_indexer(hdr, 0, backward)
+            /**
+            * @return NaN if there are no values.
+            */
+            [[nodiscard]] constexpr T average() const noexcept
             {
+                return count > 0 ? mean : std::numeric_limits<T>::quiet_NaN();
             }
 
-            constexpr arrnd_fast_indexer(const header_type& hdr, std::int64_t axis, bool backward = false)
+            /**
+            * @return m2 divided by count - ddof, or NaN if count - ddof is not positive.
+            */
+            [[nodiscard]] constexpr T variance(std::int64_t ddof) const noexcept
             {
-                // data
-
-                last_index_ = hdr.last_index();
-
-                num_super_groups_ = hdr.dims()[axis];
-                step_size_between_super_groups_ = hdr.strides()[axis];
+                return count - ddof > 0 ? m2 / static_cast<T>(count - ddof) : std::numeric_limits<T>::quiet_NaN();
+            }
+        };
 
-                num_groups_in_super_group_ =
-                    std::accumulate(hdr.dims().begin(), hdr.dims().begin() + axis + 1, 1, std::multiplies<>{}) / num_super_groups_;
-                group_size_ = hdr.strides()[axis];
-                step_size_inside_group_ = hdr.strides().back();
-                step_size_between_groups_ = num_super_groups_ * step_size_between_super_groups_;
-
-                // accumulators
-                if (!backward) {
-                    current_index_ = 0;
-
-                    super_groups_counter_ = 0;
+        /**
+        * @note One pass Welford accumulation. Each lane updates its own moments, and since all lanes hold the same number of values
+        * the division by the count is shared between them, which leaves the inner loop without loop carried dependency.
+        * Integral values are accumulated as double.
+        */
+        template <typename T>
+        class moments_accumulator final {
+        public:
+            using value_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+            static constexpr std::int64_t lanes = 8;
+            static constexpr std::int64_t block_size = 16 * lanes;
+
+            constexpr void accumulate(const T* first, std::int64_t count) noexcept
+            {
+                const std::int64_t full{ count - count % lanes };
+                for (std::int64_t i = 0; i < full; i += lanes) {
+                    ++lanes_count_;
+                    const value_type factor{ value_type{ 1 } / static_cast<value_type>(lanes_count_) };
+                    for (std::int64_t j = 0; j < lanes; ++j) {
+                        const value_type value{ static_cast<value_type>(first[i + j]) };
+                        const value_type delta{ value - means_[j] };
+                        means_[j] += delta * factor;
+                        m2s_[j] += delta * (value - means_[j]);
+                    }
+                }
+                for (std::int64_t i = full; i < count; ++i) {
+                    tail_.merge(moments<value_type>{ 1, static_cast<value_type>(first[i]), value_type{} });
+                }
+            }
 
-                    group_indices_counter_ = 0;
-                    groups_counter_ = 0;
+            [[nodiscard]] constexpr moments<value_type> result() const noexcept
+            {
+                moments<value_type> res{ tail_ };
+                for (std::int64_t j = 0; j < lanes; ++j) {
+                    res.merge(moments<value_type>{ lanes_count_, means_[j], m2s_[j] });
+                }
+                return res;
+            }
 
-                    super_group_start_index_ = 0;
+        private:
+            std::int64_t lanes_count_{ 0 };
+            value_type means_[lanes]{};
+            value_type m2s_[lanes]{};
+            moments<value_type> tail_{};
+        };
 
-                    group_start_index_ = 0;
-                }
-                else {
-                    group_indices_counter_ = group_size_ - 1;
-                    groups_counter_ = num_groups_in_super_group_ - 1;
-                    super_groups_counter_ = num_super_groups_ - 1;
+        /**
+        * @note Accumulates the first count values of a block that was gathered for acc, where count is at most Accumulator::block_size.
+        * The bound is visible to the compiler, which otherwise cannot tell that the loops of accumulate stay inside the block.
+        */
+        template <typename Accumulator, typename T>
+        constexpr void accumulate_block(Accumulator& acc, std::span<const T, Accumulator::block_size> block, std::int64_t count) noexcept
+        {
+            acc.accumulate(block.data(), std::clamp(count, std::int64_t{ 0 }, Accumulator::block_size));
+        }
+    }
 
-                    super_group_start_index_ = super_groups_counter_ * step_size_between_super_groups_;
-                    group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
+    using details::pairwise_summation;
+    using details::kahan_babuska_summation;
+    using details::widened_summation;
 
-                    current_index_ = last_index_;
-                }
-            }
 
-            constexpr arrnd_fast_indexer() = default;
 
-            constexpr arrnd_fast_indexer(const arrnd_fast_indexer& other) = default;
-            constexpr arrnd_fast_indexer& operator=(const arrnd_fast_indexer& other) = default;
+    namespace details {
 
-            constexpr arrnd_fast_indexer(arrnd_fast_indexer&& other) noexcept = default;
-            constexpr arrnd_fast_indexer& operator=(arrnd_fast_indexer&& other) noexcept = default;
+        template <typename T, typename U>
+        [[nodiscard]] inline bool operator==(const std::span<T>& lhs, const std::span<U>& rhs) {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
 
-            constexpr ~arrnd_fast_indexer() = default;
+        /*
+        * N-dimensional array definitions:
+        * ================================
+        * 
+        * N - number of dimensions
+        * All sizes of defined groups are proportional to N.
+        * 
+        * Dimensions:
+        * -----------
+        * D = {n(1), n(2), ..., n(N)}
+        * The dimensions order is from the larges to the smallest (i.e. columns).
+        * 
+        * Ranges:
+        * -------
+        * R = {(Rs(1),Re(1),Rt(1)), (Rs(2),Re(2),Rt(2)), ..., (Rs(N),Re(N),Rt(N))}
+        * s.t. Rs - start index
+        *      Re - stop index
+        *      Rt - step
+        * 
+        * Strides:
+        * --------
+        * S = {s(1), s(2), ..., s(N)}
+        * s.t. s(i) - the elements count between two consecutive elements of the i(th) dimension.
+        * 
+        * Offset:
+        * -------
+        * The start index of the current array or sub-array.
+        * Has value of 0 for the base array.
+        * 
+        * Subscripts:
+        * -----------
+        * I = {I(1), I(2), ..., I(N)}
+        * s.t. I is a group of subscripts of specific value in the array.
+        */
 
-            constexpr arrnd_fast_indexer& operator++() noexcept
-            {
-                // the algorithm is done by three functions composition:
-                // - index
-                // - group
-                // - super group
+        /*
+        * N-dimensional array indexing:
+        * =============================
+        * 
+        * Dimensions to strides:
+        * ----------------------
+        * Relates to the original array dimensions for the base strides calculation.
+        * s(N) = 1
+        * s(i) = f(S,D) = s(i+1) * n(i+1) - for every i in {1, 2, ..., N-1}
+        * 
+        * Ranges to strides:
+        * ------------------
+        * Relates to calculation of sub-array strides.
+        * s(i) = f(S',Rt) = s'(i) * Rt(i) for every i in {1, 2, ..., N}
+        * s.t. S' are the previously calculted strides.
+        * 
+        * Ranges to dimensions:
+        * ---------------------
+        * n(i) = f(R) = ceil((Re(i) - Rs(i) + 1) / Rt(i)) for every i in {1, 2, ..., N}
+        * 
+        * Offset:
+        * -------
+        * offset = f(offset', S',Rs) = offset' + dot(S',Rs)
+        * s.t. offset' - previously calculated offset
+        *      S'      - vector of previously calculated strides
+        *      Rs      - vector of ranges start indices
+        * 
+        * Index:
+        * ------
+        * index = f(offset, S, I) = offset + dot(S,I)
+        * 
+        * Number of elements in array:
+        * ----------------------------
+        * count = f(D) = n(1) * n(2) * ... n(N)
+        * 
+        * Check if two dimensions are equal:
+        * ----------------------------------
+        * are_equal = f(D1,D2) = D1(1)=D2(1) and D1(2)=D2(2) and ... and D1(N)=D2(N)
+        * 
+        * Check if ranges are valid/legal:
+        * --------------------------------
+        * are_legal - f(R) = Rt(1)>0 and Rt(2)>0 and ... and Rt(N)>0
+        */
 
-                // index function
+        /**
+        * @note If dimensions contain zero or negative dimension value than the number of elements will be 0.
+        */
+        [[nodiscard]] inline std::int64_t numel(std::span<const std::int64_t> dims) noexcept
+        {
+            if (dims.empty()) {
+                return 0;
+            }
 
-                if (current_index_ > last_index_) {
-                    return *this;
+            std::int64_t res{ 1 };
+            for (std::int64_t i = 0; i < std::ssize(dims); ++i) {
+                if (dims[i] <= 0) {
+                    return 0;
                 }
+                res *= dims[i];
+            }
+            return res;
+        }
 
-                ++group_indices_counter_;
-                current_index_ += step_size_inside_group_;
+        /**
+        * @note Memory order of the elements of a newly allocated array.
+        */
+        enum class arrnd_layout {
+            row_major,
+            column_major
+        };
 
-                if (group_indices_counter_ < group_size_) {
-                    return *this;
-                }
+        /**
+        * @param[out] strides An already allocated memory for computed strides.
+        * @return Number of computed strides
+        */
+        inline std::int64_t compute_strides(std::span<const std::int64_t> dims, std::span<std::int64_t> strides) noexcept
+        {
+            std::int64_t num_strides{ std::ssize(dims) > std::ssize(strides) ? std::ssize(strides) : std::ssize(dims) };
+            if (num_strides <= 0) {
+                return 0;
+            }
 
-                // group function
+            strides[num_strides - 1] = 1;
+            for (std::int64_t i = num_strides - 2; i >= 0; --i) {
+                strides[i] = strides[i + 1] * dims[i + 1];
+            }
+            return num_strides;
+        }
 
-                group_indices_counter_ = 0;
+        /**
+        * @param[out] strides An already allocated memory for computed strides.
+        * @return Number of computed strides
+        * @note Column major (Fortran order) strides, i.e. the first dimension is the fastest changing one.
+        */
+        inline std::int64_t compute_column_major_strides(std::span<const std::int64_t> dims, std::span<std::int64_t> strides) noexcept
+        {
+            std::int64_t num_strides{ std::ssize(dims) > std::ssize(strides) ? std::ssize(strides) : std::ssize(dims) };
+            if (num_strides <= 0) {
+                return 0;
+            }
 
-                ++groups_counter_;
-                group_start_index_ += step_size_between_groups_;
+            strides[0] = 1;
+            for (std::int64_t i = 1; i < num_strides; ++i) {
+                strides[i] = strides[i - 1] * dims[i - 1];
+            }
+            return num_strides;
+        }
 
-                current_index_ = group_start_index_;
+        /**
+        * @param[out] strides An already allocated memory for computed strides.
+        * @return Number of computed strides
+        * @note When number of interval is smaller than number of strides, the other strides are the previous strides.
+        */
+        inline std::int64_t compute_strides(std::span<const std::int64_t> previous_dims, std::span<const std::int64_t> previous_strides, std::span<const Interval<std::int64_t>> intervals, std::span<std::int64_t> strides) noexcept
+        {
+            std::int64_t nstrides{ std::ssize(previous_strides) > std::ssize(strides) ? std::ssize(strides) : std::ssize(previous_strides) };
+            if (nstrides <= 0) {
+                return 0;
+            }
 
-                if (groups_counter_ < num_groups_in_super_group_) {
-                    return *this;
-                }
+            std::int64_t ncomp_from_intervals{ nstrides > std::ssize(intervals) ? std::ssize(intervals) : nstrides };
 
-                // super group function
+            // compute strides with interval step, a negative step reverses the axis
+            for (std::int64_t i = 0; i < ncomp_from_intervals; ++i) {
+                strides[i] = previous_strides[i] * intervals[i].step;
+            }
 
-                groups_counter_ = 0;
+            // axes without intervals keep their previous strides
+            for (std::int64_t i = ncomp_from_intervals; i < nstrides && i < std::ssize(previous_dims); ++i) {
+                strides[i] = previous_strides[i];
+            }
 
-                ++super_groups_counter_;
-                super_group_start_index_ += step_size_between_super_groups_;
+            return nstrides;
+        }
 
-                group_start_index_ = super_group_start_index_;
+        /**
+        * @param[out] dims An already allocated memory for computed dimensions.
+        * @return Number of computed dimensions
+        * @note Previous dimensions are used in case of small number of intervals.
+        * An interval of negative step is taken from its start down to its stop (e.g. {-1, 0, -1} is a reversed axis).
+        */
+        inline std::int64_t compute_dims(std::span<const std::int64_t> previous_dims, std::span<const Interval<std::int64_t>> intervals, std::span<std::int64_t> dims) noexcept
+        {
+            std::int64_t ndims{ std::ssize(previous_dims) > std::ssize(dims) ? std::ssize(dims) : std::ssize(previous_dims) };
+            if (ndims <= 0) {
+                return 0;
+            }
 
-                current_index_ = group_start_index_;
+            std::int64_t num_computed_dims{ ndims > std::ssize(intervals) ? std::ssize(intervals) : ndims };
 
-                if (super_groups_counter_ < num_super_groups_) {
-                    return *this;
+            for (std::int64_t i = 0; i < num_computed_dims; ++i) {
+                Interval<std::int64_t> interval{ modulo(intervals[i], previous_dims[i]) };
+                if (interval.step == 0 || (interval.step > 0 ? interval.start > interval.stop : interval.start < interval.stop)) {
+                    return 0;
                 }
+                dims[i] = (interval.stop - interval.start) / interval.step + 1;
+            }
 
-                group_indices_counter_ = group_size_;
-                groups_counter_ = num_groups_in_super_group_ - 1;
-                super_groups_counter_ = num_super_groups_ - 1;
+            for (std::int64_t i = num_computed_dims; i < ndims; ++i) {
+                dims[i] = previous_dims[i];
+            }
 
-                super_group_start_index_ = super_groups_counter_ * step_size_between_super_groups_;
-                group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
+            return ndims;
+        }
 
-                current_index_ = last_index_ + 1;
+        [[nodiscard]] inline std::int64_t compute_offset(std::span<const std::int64_t> previous_dims, std::int64_t previous_offset, std::span<const std::int64_t> previous_strides, std::span<const Interval<std::int64_t>> intervals) noexcept
+        {
+            std::int64_t offset{ previous_offset };
 
-                return *this;
+            if (previous_dims.empty() || previous_strides.empty() || intervals.empty()) {
+                return offset;
             }
 
-            constexpr arrnd_fast_indexer operator++(int) noexcept
-            {
-                arrnd_fast_indexer<header_type> temp{ *this };
-                ++(*this);
-                return temp;
+            std::int64_t num_computations{ std::ssize(previous_dims) > std::ssize(previous_strides) ? std::ssize(previous_strides) : std::ssize(previous_dims) };
+            num_computations = (num_computations > std::ssize(intervals) ? std::ssize(intervals) : num_computations);
+
+            for (std::int64_t i = 0; i < num_computations; ++i) {
+                offset += previous_strides[i] * modulo(intervals[i], previous_dims[i]).start;
             }
+            return offset;
+        }
 
-            constexpr arrnd_fast_indexer& operator+=(std::int64_t count) noexcept
-            {
-                for (std::int64_t i = 0; i < count; ++i) {
-                    ++(*this);
+        /**
+        * @return Offset of the first element in a buffer that starts at the lowest index that is required by the strides,
+        * i.e. the offset is moved by the extent of every negative stride.
+        */
+        [[nodiscard]] inline std::int64_t compute_origin_offset(std::span<const std::int64_t> dims, std::span<const std::int64_t> strides) noexcept
+        {
+            std::int64_t offset{ 0 };
+
+            std::int64_t num_computations{ std::ssize(dims) > std::ssize(strides) ? std::ssize(strides) : std::ssize(dims) };
+            for (std::int64_t i = 0; i < num_computations; ++i) {
+                if (strides[i] < 0 && dims[i] > 0) {
+                    offset -= (dims[i] - 1) * strides[i];
                 }
-                return *this;
             }
+            return offset;
+        }
 
-            constexpr arrnd_fast_indexer operator+(std::int64_t count) noexcept
-            {
-                arrnd_fast_indexer<header_type> temp{ *this };
-                temp += count;
-                return temp;
-            }
+        /**
+        * @note Extra subscripts are ignored. If number of subscripts are less than number of strides/dimensions, they are considered as the less significant subscripts.
+        */
+        [[nodiscard]] inline std::int64_t subs2ind(std::int64_t offset, std::span<const std::int64_t> strides, std::span<const std::int64_t> dims, std::span<std::int64_t> subs) noexcept
+        {
+            std::int64_t ind{ offset };
 
-            constexpr arrnd_fast_indexer& operator--() noexcept
-            {
-                // the algorithm is done by inverese of three functions composition:
-                // - super group
-                // - group
-                // - index
+            if (strides.empty() || dims.empty() || subs.empty()) {
+                return ind;
+            }
 
-                if (current_index_ < 0) {
-                    return *this;
-                }
+            std::int64_t num_used_subs{ std::ssize(strides) > std::ssize(dims) ? std::ssize(dims) : std::ssize(strides) };
+            num_used_subs = (num_used_subs > std::ssize(subs) ? std::ssize(subs) : num_used_subs);
 
-                // index function
+            std::int64_t num_ignored_subs{ std::ssize(strides) - num_used_subs};
+            if (num_ignored_subs < 0) { // ignore extra subscripts
+                num_ignored_subs = 0;
+            }
 
-                --group_indices_counter_;
-                current_index_ -= step_size_inside_group_;
+            for (std::int64_t i = num_ignored_subs; i < std::ssize(strides); ++i) {
+                ind += strides[i] * modulo(subs[i - num_ignored_subs], dims[i]);
+            }
 
-                if (group_indices_counter_ >= 0) {
-                    return *this;
-                }
+            return ind;
+        }
 
-                // group function
+        /*
+        Example:
+        ========
+        D = {2, 2, 2, 2, 3}
+        N = 5
+        Data =
+        {
+            {{{{1, 2, 3},
+            {4, 5, 6}},
 
-                group_indices_counter_ = group_size_ - 1;
+            {{7, 8, 9},
+            {10, 11, 12}}},
 
-                --groups_counter_;
-                group_start_index_ -= step_size_between_groups_;
 
-                current_index_ = group_start_index_ + (group_size_-1) * step_size_inside_group_;
+            {{{13, 14, 15},
+            {16, 17, 18}},
 
-                if (groups_counter_ >= 0) {
-                    return *this;
-                }
+            {{19, 20, 21},
+            {22, 23, 24}}}},
 
-                // super group function
 
-                groups_counter_ = num_groups_in_super_group_ - 1;
 
-                --super_groups_counter_;
-                super_group_start_index_ -= step_size_between_super_groups_;
+            {{{{25, <26>, 27},
+            {28, <29>, 30}},
 
-                group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
+            {{31, 32, 33},
+            {34, 35, 36}}},
 
-                current_index_ = group_start_index_ + (group_size_-1) * step_size_inside_group_;
 
-                if (super_groups_counter_ >= 0) {
-                    return *this;
-                }
+            {{{37, 38, 39},
+            {40, 41, 42}},
 
-                group_indices_counter_ = -1;
-                groups_counter_ = 0;
-                super_groups_counter_ = 0;
+            {{43, 44, 45},
+            {46, 47, 48}}}}
+        }
+        S = {24, 12, 6, 3, 1}
+        offset = 0
 
-                super_group_start_index_ = 0;
-                group_start_index_ = 0;
+        Subarray 1:
+        -----------
+        R = {{1,1,1}, {0,1,2}, {0,0,1}, {0,1,1}, {1,2,2}}
+        D = {1, 1, 1, 2, 1}
+        N = 5
+        Data =
+        {
+            {{{{26},
+               {29}}}}
+        }
+        S = {24, 24, 6, 3, 2}
+        offset = 25
 
-                current_index_ = -1;
+        Subarray 2 (from subarray 1):
+        -----------------------------
+        R = {{0,0,1}, {0,0,1}, {0,0,1}, {1,1,2}, {0,0,1}}
+        D = {1, 1, 1, 1, 1}
+        N = 5
+        Data =
+        {
+            {{{{29}}}}
+        }
+        S = {24, 24, 6, 6, 2}
+        offset = 28
+        */
 
-                return *this;
-            }
+        template <typename Storage = simple_dynamic_vector<std::int64_t>>
+        class arrnd_header {
+        public:
+            using storage_type = Storage;
 
-            constexpr arrnd_fast_indexer operator--(int) noexcept
-            {
-                arrnd_fast_indexer<header_type> temp{ *this };
-                --(*this);
-                return temp;
-            }
+            arrnd_header() = default;
 
-            constexpr arrnd_fast_indexer& operator-=(std::int64_t count) noexcept
+            arrnd_header(std::span<const std::int64_t> dims, arrnd_layout layout = arrnd_layout::row_major)
             {
-                for (std::int64_t i = 0; i < count; ++i) {
-                    --(*this);
+                if ((count_ = numel(dims)) <= 0) {
+                    return;
                 }
-                return *this;
-            }
 
-            constexpr arrnd_fast_indexer operator-(std::int64_t count) noexcept
-            {
-                arrnd_fast_indexer<header_type> temp{ *this };
-                temp -= count;
-                return temp;
-            }
+                dims_ = storage_type(dims.begin(), dims.end());
 
-            [[nodiscard]] explicit constexpr operator bool() const noexcept
-            {
-                return static_cast<std::uint64_t>(current_index_) <= static_cast<std::uint64_t>(last_index_);
+                strides_ = storage_type(dims.size());
+                if (layout == arrnd_layout::row_major) {
+                    compute_strides(dims, strides_);
+                }
+                else {
+                    compute_column_major_strides(dims, strides_);
+                }
+
+                compute_layout();
             }
 
-            [[nodiscard]] constexpr std::int64_t operator*() const noexcept
+            /**
+            * @note Arbitrary (non zero) strides, e.g. of a buffer that was created by another library. Negative strides are of reversed axes.
+            * Empty header is created if the number of strides is different from the number of dimensions, if any stride is zero,
+            * or if the offset and strides require a negative buffer index.
+            */
+            arrnd_header(std::span<const std::int64_t> dims, std::span<const std::int64_t> strides, std::int64_t offset = 0)
             {
-                return current_index_;
-            }
+                if (dims.size() != strides.size() || std::any_of(strides.begin(), strides.end(), [](std::int64_t stride) { return stride == 0; })) {
+                    return;
+                }
 
-        private:
-            std::int64_t current_index_ = 0;
+                if ((count_ = numel(dims)) <= 0) {
+                    return;
+                }
 
-            // data
+                dims_ = storage_type(dims.begin(), dims.end());
+                strides_ = storage_type(strides.begin(), strides.end());
+                offset_ = offset;
 
-            std::int64_t last_index_ = 0;
+                compute_layout();
 
-            std::int64_t num_super_groups_ = 0;
-            std::int64_t step_size_between_super_groups_ = 0;
+                if (first_index_ < 0) {
+                    *this = arrnd_header{};
+                }
+            }
 
-            std::int64_t num_groups_in_super_group_ = 0;
-            std::int64_t group_size_ = 0;
-            std::int64_t step_size_inside_group_ = 0;
-            std::int64_t step_size_between_groups_ = 0;
-            
-            // counters
+            arrnd_header(const arrnd_header& previous_hdr, std::span<const Interval<std::int64_t>> intervals)
+            {
+                if (numel(previous_hdr.dims()) <= 0) {
+                    return;
+                }
 
-            std::int64_t super_groups_counter_ = 0;
+                storage_type dims = storage_type(previous_hdr.dims().size());
 
-            std::int64_t group_indices_counter_ = 0;
-            std::int64_t groups_counter_ = 0;
+                if (compute_dims(previous_hdr.dims(), intervals, dims) <= 0) {
+                    return;
+                }
 
-            std::int64_t super_group_start_index_ = 0;
+                dims_ = std::move(dims);
+                
+                count_ = numel(dims_);
 
-            std::int64_t group_start_index_ = 0;
-        };
+                strides_ = storage_type(previous_hdr.dims().size());
+                compute_strides(previous_hdr.dims(), previous_hdr.strides(), intervals, strides_);
 
-        template <typename T, typename Indexer = arrnd_general_indexer<>>
-        class arrnd_iterator final
-        {
-        public:
-            using iterator_category = std::bidirectional_iterator_tag;
-            using difference_type = std::int64_t;
-            using value_type = T;
-            using pointer = T*;
-            using reference = T&;
+                offset_ = compute_offset(previous_hdr.dims(), previous_hdr.offset(), previous_hdr.strides(), intervals);
 
-            using indexer_type = Indexer;
+                compute_layout();
 
-            constexpr arrnd_iterator(pointer data, const indexer_type& gen)
-                : gen_(gen), data_(data)
-            {
+                is_subarray_ = previous_hdr.is_subarray() || !std::equal(previous_hdr.dims().begin(), previous_hdr.dims().end(), dims_.begin());
             }
 
-            constexpr arrnd_iterator() = default;
+            arrnd_header(const arrnd_header& previous_hdr, std::int64_t omitted_axis)
+                : is_subarray_(previous_hdr.is_subarray())
+            {
+                if (numel(previous_hdr.dims()) <= 0) {
+                    return;
+                }
 
-            constexpr arrnd_iterator(const arrnd_iterator& other) = default;
-            constexpr arrnd_iterator& operator=(const arrnd_iterator& other) = default;
+                std::int64_t axis{ modulo(omitted_axis, std::ssize(previous_hdr.dims())) };
+                std::int64_t ndims{ std::ssize(previous_hdr.dims()) > 1 ? std::ssize(previous_hdr.dims()) - 1 : 1 };
 
-            constexpr arrnd_iterator(arrnd_iterator&& other) noexcept = default;
-            constexpr arrnd_iterator& operator=(arrnd_iterator&& other) noexcept = default;
+                dims_ = storage_type(ndims);
 
-            constexpr ~arrnd_iterator() = default;
+                if (previous_hdr.dims().size() > 1) {
+                    for (std::int64_t i = 0; i < axis; ++i) {
+                        dims_[i] = previous_hdr.dims()[i];
+                    }
+                    for (std::int64_t i = axis + 1; i < std::ssize(previous_hdr.dims()); ++i) {
+                        dims_[i - 1] = previous_hdr.dims()[i];
+                    }
+                }
+                else {
+                    dims_[0] = 1;
+                }
 
-            constexpr arrnd_iterator& operator++() noexcept
-            {
-                ++gen_;
-                return *this;
-            }
+                strides_ = storage_type(ndims);
+                compute_strides(dims_, strides_);
 
-            constexpr arrnd_iterator operator++(int) noexcept
-            {
-                arrnd_iterator temp{ *this };
-                ++(*this);
-                return temp;
-            }
+                count_ = numel(dims_);
 
-            constexpr arrnd_iterator& operator+=(difference_type count) noexcept
-            {
-                gen_ += count;
-                return *this;
+                compute_layout();
             }
 
-            constexpr arrnd_iterator operator+(difference_type count) noexcept
+            arrnd_header(const arrnd_header& previous_hdr, std::span<const std::int64_t> new_order)
+                : is_subarray_(previous_hdr.is_subarray())
             {
-                arrnd_iterator temp{ *this };
-                temp += count;
-                return temp;
-            }
+                if (numel(previous_hdr.dims()) <= 0) {
+                    return;
+                }
 
-            constexpr arrnd_iterator& operator--() noexcept
-            {
-                gen_--;
-                return *this;
-            }
+                if (new_order.empty()) {
+                    return;
+                }
 
-            constexpr arrnd_iterator operator--(int) noexcept
-            {
-                arrnd_iterator temp{ *this };
-                --(*this);
-                return temp;
-            }
+                storage_type dims = storage_type(previous_hdr.dims().size());
 
-            constexpr arrnd_iterator& operator-=(difference_type count) noexcept
-            {
-                gen_ -= count;
-                return *this;
-            }
+                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
+                    dims[i] = previous_hdr.dims()[modulo(new_order[i], std::ssize(previous_hdr.dims()))];
+                }
 
-            constexpr arrnd_iterator operator-(difference_type count) noexcept
-            {
-                arrnd_iterator temp{ *this };
-                temp -= count;
-                return temp;
+                if (numel(previous_hdr.dims()) != numel(dims)) {
+                    return;
+                }
+
+                dims_ = std::move(dims);
+
+                strides_ = storage_type(previous_hdr.dims().size());
+                compute_strides(dims_, strides_);
+
+                count_ = numel(dims_);
+
+                compute_layout();
             }
 
-            [[nodiscard]] constexpr reference operator*() const noexcept
+            arrnd_header(const arrnd_header& previous_hdr, std::int64_t count, std::int64_t axis)
+                : is_subarray_(previous_hdr.is_subarray())
             {
-                return data_[*gen_];
+                if (numel(previous_hdr.dims()) <= 0) {
+                    return;
+                }
+
+                storage_type dims = storage_type(previous_hdr.dims().size());
+
+                std::int64_t fixed_axis{ modulo(axis, std::ssize(previous_hdr.dims())) };
+                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
+                    dims[i] = (i != fixed_axis) ? previous_hdr.dims()[i] : previous_hdr.dims()[i] + count;
+                }
+                
+                if ((count_ = numel(dims)) <= 0) {
+                    return;
+                }
+
+                dims_ = std::move(dims);
+
+                strides_ = storage_type(previous_hdr.dims().size());
+                compute_strides(dims_, strides_);
+
+                compute_layout();
             }
 
-            [[nodiscard]] constexpr bool operator==(const arrnd_iterator& iter) const
+            arrnd_header(const arrnd_header& previous_hdr, std::span<const std::int64_t> appended_dims, std::int64_t axis)
+                : is_subarray_(previous_hdr.is_subarray())
             {
-                return *gen_ == *(iter.gen_);
-            }
+                if (previous_hdr.dims().size() != appended_dims.size()) {
+                    return;
+                }
 
-        private:
-            indexer_type gen_;
-            pointer data_ = nullptr;
-        };
+                if (numel(previous_hdr.dims()) <= 0) {
+                    return;
+                }
 
+                if (numel(appended_dims) <= 0) {
+                    return;
+                }
 
+                std::int64_t fixed_axis{ modulo(axis, std::ssize(previous_hdr.dims())) };
 
+                bool are_dims_valid_for_append{ true };
+                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
+                    if (i != fixed_axis && previous_hdr.dims()[i] != appended_dims[i]) {
+                        are_dims_valid_for_append = false;
+                    }
+                }
+                if (!are_dims_valid_for_append) {
+                    return;
+                }
 
-        template <typename T, typename Indexer = arrnd_general_indexer<>>
-        class arrnd_const_iterator final
-        {
-        public:
-            using iterator_category = std::bidirectional_iterator_tag;
-            using difference_type = std::int64_t;
-            using value_type = T;
-            using pointer = T*;
-            using reference = T&;
+                storage_type dims = storage_type(previous_hdr.dims().size());
 
-            using indexer_type = Indexer;
+                for (std::int64_t i = 0; i < std::ssize(previous_hdr.dims()); ++i) {
+                    dims[i] = (i != fixed_axis) ? previous_hdr.dims()[i] : previous_hdr.dims()[i] + appended_dims[fixed_axis];
+                }
 
-            constexpr arrnd_const_iterator(pointer data, const indexer_type& gen)
-                : gen_(gen), data_(data)
-            {
+                if ((count_ = numel(dims)) <= 0) {
+                    return;
+                }
+
+                dims_ = std::move(dims);
+
+                strides_ = storage_type(previous_hdr.dims().size());
+                compute_strides(dims_, strides_);
+
+                compute_layout();
             }
 
-            constexpr arrnd_const_iterator() = default;
+            arrnd_header(arrnd_header&& other) = default;
+            arrnd_header& operator=(arrnd_header&& other) = default;
 
-            constexpr arrnd_const_iterator(const arrnd_const_iterator& other) = default;
-            constexpr arrnd_const_iterator& operator=(const arrnd_const_iterator& other) = default;
+            arrnd_header(const arrnd_header& other) = default;
+            arrnd_header& operator=(const arrnd_header& other) = default;
 
-            constexpr arrnd_const_iterator(arrnd_const_iterator&& other) noexcept = default;
-            constexpr arrnd_const_iterator& operator=(arrnd_const_iterator&& other) noexcept = default;
+            virtual ~arrnd_header() = default;
 
-            constexpr ~arrnd_const_iterator() = default;
+            [[nodiscard]] std::int64_t count() const noexcept
+            {
+                return count_;
+            }
 
-            constexpr arrnd_const_iterator& operator++() noexcept
+            [[nodiscard]] std::span<const std::int64_t> dims() const noexcept
             {
-                ++gen_;
-                return *this;
+                return std::span<const std::int64_t>(dims_.data(), dims_.size());
             }
 
-            constexpr arrnd_const_iterator operator++(int) noexcept
+            [[nodiscard]] std::span<const std::int64_t> strides() const noexcept
             {
-                arrnd_const_iterator temp{ *this };
-                ++(*this);
-                return temp;
+                return std::span<const std::int64_t>(strides_.data(), strides_.size());
             }
 
-            constexpr arrnd_const_iterator& operator+=(difference_type count) noexcept
+            [[nodiscard]] std::int64_t offset() const noexcept
             {
-                gen_ += count;
-                return *this;
+                return offset_;
             }
 
-            constexpr arrnd_const_iterator operator+(difference_type count) noexcept
+            [[nodiscard]] bool is_subarray() const noexcept
             {
-                arrnd_const_iterator temp{ *this };
-                temp += count;
-                return temp;
+                return is_subarray_;
             }
 
-            constexpr arrnd_const_iterator& operator--() noexcept
+            [[nodiscard]] bool empty() const noexcept
             {
-                --gen_;
-                return *this;
+                return dims_.empty();
             }
 
-            constexpr arrnd_const_iterator operator--(int) noexcept
+            /**
+            * @return Lowest buffer index of the elements. Equals to the offset if no stride is negative.
+            */
+            [[nodiscard]] std::int64_t first_index() const noexcept
             {
-                arrnd_const_iterator temp{ *this };
-                --(*this);
-                return temp;
+                return first_index_;
             }
 
-            constexpr arrnd_const_iterator& operator-=(difference_type count) noexcept
+            /**
+            * @return Highest buffer index of the elements.
+            */
+            [[nodiscard]] std::int64_t last_index() const noexcept
             {
-                gen_ -= count;
-                return *this;
+                return last_index_;
             }
 
-            constexpr arrnd_const_iterator operator-(difference_type count) noexcept
+            /**
+            * @return True if the elements occupy [offset, offset + count) in row major order, i.e. the buffer can be accessed linearly in iteration order.
+            */
+            [[nodiscard]] bool is_contiguous() const noexcept
             {
-                arrnd_const_iterator temp{ *this };
-                temp -= count;
-                return temp;
+                return is_contiguous_;
             }
 
-            [[nodiscard]] constexpr const reference operator*() const noexcept
+            /**
+            * @return True if the elements occupy [first index, first index + count) in any order and direction of the axes (e.g. row major, column major or reversed).
+            * Order independent operations can then process the buffer linearly in memory order.
+            */
+            [[nodiscard]] bool is_dense() const noexcept
             {
-                return data_[*gen_];
+                return is_dense_;
             }
 
-            [[nodiscard]] constexpr bool operator==(const arrnd_const_iterator& iter) const
+            /**
+            * @note Moves the elements by delta buffer indices (e.g. to the next slice along an axis) without recomputing the header.
+            */
+            void shift(std::int64_t delta) noexcept
             {
-                return *gen_ == *(iter.gen_);
+                offset_ += delta;
+                first_index_ += delta;
+                last_index_ += delta;
             }
 
         private:
-            indexer_type gen_;
-            pointer data_ = nullptr;
-        };
-
-
+            void compute_layout() noexcept
+            {
+                const std::int64_t ndims{ std::ssize(dims_) };
 
-        template <typename T, typename Indexer = arrnd_general_indexer<>>
-        class arrnd_reverse_iterator final
-        {
-        public:
-            using iterator_category = std::bidirectional_iterator_tag;
-            using difference_type = std::int64_t;
-            using value_type = T;
-            using pointer = T*;
-            using reference = T&;
+                // reversed axes (of negative strides) extend the elements range below the offset
+                first_index_ = offset_;
+                last_index_ = offset_;
+                for (std::int64_t i = 0; i < ndims; ++i) {
+                    const std::int64_t extent{ (dims_[i] - 1) * strides_[i] };
+                    (extent < 0 ? first_index_ : last_index_) += extent;
+                }
 
-            using indexer_type = Indexer;
+                is_contiguous_ = true;
+                for (std::int64_t i = ndims - 1, expected = 1; i >= 0 && is_contiguous_; --i) {
+                    if (dims_[i] > 1) {
+                        is_contiguous_ = strides_[i] == expected;
+                        expected *= dims_[i];
+                    }
+                }
 
-            constexpr arrnd_reverse_iterator(pointer data, const indexer_type& gen)
-                : gen_(gen), data_(data)
-            {
+                // the axes (of more than one element) should form a chain of absolute strides 1, d0, d0 * d1, ... in some order
+                is_dense_ = true;
+                std::int64_t remaining{ std::count_if(dims_.begin(), dims_.end(), [](std::int64_t dim) { return dim > 1; }) };
+                for (std::int64_t expected = 1; remaining > 0 && is_dense_; --remaining) {
+                    std::int64_t i = 0;
+                    while (i < ndims && !(dims_[i] > 1 && std::abs(strides_[i]) == expected)) {
+                        ++i;
+                    }
+                    is_dense_ = i < ndims;
+                    if (is_dense_) {
+                        expected *= dims_[i];
+                    }
+                }
             }
 
-            constexpr arrnd_reverse_iterator() = default;
-
-            constexpr arrnd_reverse_iterator(const arrnd_reverse_iterator& other) = default;
-            constexpr arrnd_reverse_iterator& operator=(const arrnd_reverse_iterator& other) = default;
+            storage_type dims_{};
+            storage_type strides_{};
+            std::int64_t count_{ 0 };
+            std::int64_t offset_{ 0 };
+            std::int64_t first_index_{ 0 };
+            std::int64_t last_index_{ 0 };
+            bool is_subarray_{ false };
+            bool is_contiguous_{ false };
+            bool is_dense_{ false };
+        };
 
-            constexpr arrnd_reverse_iterator(arrnd_reverse_iterator&& other) noexcept = default;
-            constexpr arrnd_reverse_iterator& operator=(arrnd_reverse_iterator&& other) noexcept = default;
+        /**
+        * @note Header of arena allocated dimensions and strides, i.e. slices within an arrnd_arena_scope are created without heap allocations.
+        * Headers are moved along with their storage, so an array that is assigned within the scope to an array declared outside of it
+        * (e.g. farr = arr[ranges]) refers to arena memory that is reused after the scope ends. Such assignments must be made
+        * within an arrnd_arena_scope(nullptr), which allocates from the heap.
+        */
+        using arena_header = arrnd_header<simple_dynamic_vector<std::int64_t, arena_allocator>>;
 
-            constexpr ~arrnd_reverse_iterator() = default;
 
-            constexpr arrnd_reverse_iterator& operator++() noexcept
-            {
-                --gen_;
-                return *this;
-            }
+        /**
+        * @return Number of axes of the loop nest over dims in the specified order (or in their natural order), where order might be shorter than dims.
+        */
+        [[nodiscard]] constexpr std::int64_t loop_nest_axes(std::span<const std::int64_t> dims, std::span<const std::int64_t> order) noexcept
+        {
+            return order.empty() ? std::ssize(dims) : std::min(std::ssize(dims), std::ssize(order));
+        }
 
-            constexpr arrnd_reverse_iterator operator++(int) noexcept
-            {
-                arrnd_reverse_iterator temp{ *this };
-                --(*this);
-                return temp;
+        /**
+        * @note Coalesces the axes of a loop nest, as described by arrnd_iteration_plan. rdims receives the coalesced dimensions,
+        * and rstrides the coalesced strides of operand op from rstrides[op * naxes], where naxes is loop_nest_axes(dims, order).
+        * @return The number of coalesced dimensions.
+        */
+        constexpr std::int64_t coalesce_loop_nest(std::span<const std::int64_t> dims, std::span<const std::span<const std::int64_t>> strides,
+            std::span<const std::int64_t> order, std::int64_t* rdims, std::int64_t* rstrides) noexcept
+        {
+            const std::int64_t naxes{ loop_nest_axes(dims, order) };
+            const std::int64_t num_operands{ std::ssize(strides) };
+
+            std::int64_t rndims{ 0 };
+            for (std::int64_t i = 0; i < naxes; ++i) {
+                const std::int64_t axis{ order.empty() ? i : order[i] };
+                if (dims[axis] <= 1) {
+                    continue;
+                }
+
+                bool mergeable{ rndims > 0 };
+                for (std::int64_t op = 0; op < num_operands && mergeable; ++op) {
+                    mergeable = rstrides[op * naxes + rndims - 1] == dims[axis] * strides[op][axis];
+                }
+
+                if (!mergeable) {
+                    ++rndims;
+                }
+                rdims[rndims - 1] = mergeable ? rdims[rndims - 1] * dims[axis] : dims[axis];
+                for (std::int64_t op = 0; op < num_operands; ++op) {
+                    rstrides[op * naxes + rndims - 1] = strides[op][axis];
+                }
             }
+            return rndims;
+        }
 
-            constexpr arrnd_reverse_iterator& operator+=(difference_type count) noexcept
+        /**
+        * @note Loop nest for iterating one or more operands of the same dimensions (e.g. the headers of the operands of a binary operation).
+        * Axes are taken in the specified order (or in their natural order), dimensions of a single element are dropped,
+        * and an axis is merged into its outer axis if it continues the outer axis for all operands (i.e. the outer stride spans exactly the whole axis).
+        * The innermost (last) dimension of the loop nest is the length of the runs that are accessed with a fixed stride per operand.
+        */
+        template <typename Storage = simple_dynamic_vector<std::int64_t>>
+        class arrnd_iteration_plan final {
+        public:
+            using storage_type = Storage;
+
+            arrnd_iteration_plan() = default;
+
+            /**
+            * @param[in] strides The strides of each operand.
+            * @param[in] order Order of the axes from the outermost to the innermost. If shorter than dims, the extra axes are ignored.
+            */
+            arrnd_iteration_plan(std::span<const std::int64_t> dims, std::span<const std::span<const std::int64_t>> strides, std::span<const std::int64_t> order = {})
+                : num_operands_(std::ssize(strides))
             {
-                gen_ -= count;
-                return *this;
+                const std::int64_t naxes{ loop_nest_axes(dims, order) };
+
+                count_ = naxes > 0 ? 1 : 0;
+                for (std::int64_t i = 0; i < naxes; ++i) {
+                    count_ *= dims[order.empty() ? i : order[i]];
+                }
+
+                storage_type rdims(naxes);
+                storage_type rstrides(naxes * num_operands_);
+
+                const std::int64_t rndims{ coalesce_loop_nest(dims, strides, order, rdims.data(), rstrides.data()) };
+
+                dims_ = storage_type(rndims);
+                std::copy_n(rdims.data(), rndims, dims_.data());
+                strides_ = storage_type(rndims * num_operands_);
+                for (std::int64_t op = 0; op < num_operands_; ++op) {
+                    std::copy_n(rstrides.data() + op * naxes, rndims, strides_.data() + op * rndims);
+                }
             }
 
-            constexpr arrnd_reverse_iterator operator+(difference_type count) noexcept
+            [[nodiscard]] std::int64_t num_operands() const noexcept
             {
-                arrnd_reverse_iterator temp{ *this };
-                temp += count;
-                return temp;
+                return num_operands_;
             }
 
-            constexpr arrnd_reverse_iterator& operator--() noexcept
+            [[nodiscard]] std::int64_t count() const noexcept
             {
-                ++gen_;
-                return *this;
+                return count_;
             }
 
-            constexpr arrnd_reverse_iterator operator--(int) noexcept
+            /**
+            * @return Number of loops, zero for a single element.
+            */
+            [[nodiscard]] std::int64_t ndims() const noexcept
             {
-                arrnd_reverse_iterator temp{ *this };
-                ++(*this);
-                return temp;
+                return dims_.size();
             }
 
-            constexpr arrnd_reverse_iterator& operator-=(difference_type count) noexcept
+            [[nodiscard]] std::span<const std::int64_t> dims() const noexcept
             {
-                gen_ += count;
-                return *this;
+                return std::span<const std::int64_t>(dims_.data(), dims_.size());
             }
 
-            constexpr arrnd_reverse_iterator operator-(difference_type count) noexcept
+            [[nodiscard]] std::span<const std::int64_t> strides(std::int64_t operand) const noexcept
             {
-                arrnd_reverse_iterator temp{ *this };
-                temp -= count;
-                return temp;
+                return std::span<const std::int64_t>(strides_.data() + operand * ndims(), ndims());
             }
 
-            [[nodiscard]] constexpr reference operator*() const noexcept
+            /**
+            * @return Number of elements that are accessed with a fixed stride by the innermost loop.
+            */
+            [[nodiscard]] std::int64_t inner_length() const noexcept
             {
-                return data_[*gen_];
+                return count_ > 0 ? (ndims() > 0 ? dims_[ndims() - 1] : 1) : 0;
             }
 
-            [[nodiscard]] constexpr bool operator==(const arrnd_reverse_iterator& iter) const
+            [[nodiscard]] std::int64_t inner_stride(std::int64_t operand) const noexcept
             {
-                return *gen_ == *(iter.gen_);
+                return ndims() > 0 ? strides_[operand * ndims() + ndims() - 1] : 1;
             }
 
         private:
-            indexer_type gen_;
-            pointer data_ = nullptr;
+            std::int64_t num_operands_{ 0 };
+            std::int64_t count_{ 0 };
+            storage_type dims_{};
+            storage_type strides_{};
         };
 
+        /**
+        * @note Per thread cache of iteration plans by dimensions, strides and order.
+        * The cache is direct mapped, i.e. a plan replaces the plan of another layout with the same hash.
+        */
+        template <typename Plan = arrnd_iteration_plan<>>
+        class arrnd_iteration_plan_cache final {
+        public:
+            using plan_type = Plan;
 
+            [[nodiscard]] static std::shared_ptr<const plan_type> get(std::span<const std::int64_t> dims, std::span<const std::span<const std::int64_t>> strides, std::span<const std::int64_t> order = {})
+            {
+                std::uint64_t hash{ 14695981039346656037ull };
+                auto mix = [&hash](std::int64_t value) {
+                    hash = (hash ^ static_cast<std::uint64_t>(value)) * 1099511628211ull;
+                };
+                visit_key(dims, strides, order, mix);
 
+                entry& e{ entries_[hash % num_entries] };
 
-        template <typename T, typename Indexer = arrnd_general_indexer<>>
-        class arrnd_const_reverse_iterator final
-        {
-        public:
-            using iterator_category = std::bidirectional_iterator_tag;
-            using difference_type = std::int64_t;
-            using value_type = T;
-            using pointer = T*;
-            using reference = T&;
+                std::int64_t pos{ 0 };
+                bool matches{ e.plan != nullptr && std::ssize(e.key) == key_size(dims, strides, order) };
+                if (matches) {
+                    visit_key(dims, strides, order, [&](std::int64_t value) {
+                        matches = matches && e.key[pos++] == value;
+                    });
+                }
 
-            using indexer_type = Indexer;
+                if (!matches) {
+                    e.key.resize(key_size(dims, strides, order));
+                    pos = 0;
+                    visit_key(dims, strides, order, [&](std::int64_t value) {
+                        e.key[pos++] = value;
+                    });
+                    // cached plans outlive the current arena scope
+                    arrnd_arena_scope heap_scope(nullptr);
+                    e.plan = std::make_shared<const plan_type>(dims, strides, order);
+                }
 
-            constexpr arrnd_const_reverse_iterator(pointer data, const indexer_type& gen)
-                : gen_(gen), data_(data)
-            {
+                return e.plan;
             }
 
-            constexpr arrnd_const_reverse_iterator() = default;
-
-            constexpr arrnd_const_reverse_iterator(const arrnd_const_reverse_iterator& other) = default;
-            constexpr arrnd_const_reverse_iterator& operator=(const arrnd_const_reverse_iterator& other) = default;
-
-            constexpr arrnd_const_reverse_iterator(arrnd_const_reverse_iterator&& other) noexcept = default;
-            constexpr arrnd_const_reverse_iterator& operator=(arrnd_const_reverse_iterator&& other) noexcept = default;
+        private:
+            static constexpr std::size_t num_entries{ 64 };
 
-            constexpr ~arrnd_const_reverse_iterator() = default;
+            struct entry {
+                std::vector<std::int64_t> key;
+                std::shared_ptr<const plan_type> plan;
+            };
 
-            constexpr arrnd_const_reverse_iterator& operator++() noexcept
+            [[nodiscard]] static std::int64_t key_size(std::span<const std::int64_t> dims, std::span<const std::span<const std::int64_t>> strides, std::span<const std::int64_t> order) noexcept
             {
-                --gen_;
-                return *this;
+                std::int64_t size{ 3 + std::ssize(dims) + std::ssize(order) };
+                for (const auto& operand_strides : strides) {
+                    size += std::ssize(operand_strides);
+                }
+                return size;
             }
 
-            constexpr arrnd_const_reverse_iterator operator++(int) noexcept
+            template <typename Func>
+            static void visit_key(std::span<const std::int64_t> dims, std::span<const std::span<const std::int64_t>> strides, std::span<const std::int64_t> order, Func&& func)
             {
-                arrnd_const_reverse_iterator temp{ *this };
-                --(*this);
-                return temp;
+                func(std::ssize(dims));
+                func(std::ssize(strides));
+                func(std::ssize(order));
+                std::for_each(dims.begin(), dims.end(), func);
+                for (const auto& operand_strides : strides) {
+                    std::for_each(operand_strides.begin(), operand_strides.end(), func);
+                }
+                std::for_each(order.begin(), order.end(), func);
             }
 
-            constexpr arrnd_const_reverse_iterator& operator+=(difference_type count) noexcept
-            {
-                gen_ -= count;
-                return *this;
-            }
+            inline static thread_local std::array<entry, num_entries> entries_{};
+        };
 
-            constexpr arrnd_const_reverse_iterator operator+(difference_type count) noexcept
-            {
-                arrnd_const_reverse_iterator temp{ *this };
-                temp += count;
-                return temp;
-            }
+        /**
+        * @return Cached iteration plan of operands of the same dimensions, one per header.
+        */
+        template <typename Header, typename... Headers>
+        [[nodiscard]] inline auto iteration_plan_of(const Header& hdr, const Headers&... hdrs)
+        {
+            const std::array<std::span<const std::int64_t>, 1 + sizeof...(Headers)> strides{ hdr.strides(), hdrs.strides()... };
+            return arrnd_iteration_plan_cache<arrnd_iteration_plan<typename Header::storage_type>>::get(hdr.dims(), strides);
+        }
 
-            constexpr arrnd_const_reverse_iterator& operator--() noexcept
-            {
-                ++gen_;
-                return *this;
+        /**
+        * @note Calls func(index, length, stride) for each run of the innermost loop of the iteration plan of hdr, in iteration order,
+        * where index is the buffer index of the first element of the run, i.e. the run elements are at index + i * stride for i in [0, length).
+        */
+        template <typename Header, typename Func>
+        requires (!arrnd_complient<Header>)
+        inline void for_each_run(const Header& hdr, Func&& func)
+        {
+            if (hdr.empty() || hdr.count() <= 0) {
+                return;
             }
 
-            constexpr arrnd_const_reverse_iterator operator--(int) noexcept
-            {
-                arrnd_const_reverse_iterator temp{ *this };
-                ++(*this);
-                return temp;
-            }
+            const auto plan = iteration_plan_of(hdr);
 
-            constexpr arrnd_const_reverse_iterator& operator-=(difference_type count) noexcept
-            {
-                gen_ += count;
-                return *this;
-            }
+            const std::int64_t length{ plan->inner_length() };
+            const std::int64_t stride{ plan->inner_stride(0) };
+            const std::int64_t nouter{ plan->ndims() - 1 };
 
-            constexpr arrnd_const_reverse_iterator operator-(difference_type count) noexcept
-            {
-                arrnd_const_reverse_iterator temp{ *this };
-                temp -= count;
-                return temp;
+            if (nouter <= 0) {
+                func(hdr.offset(), length, stride);
+                return;
             }
 
-            [[nodiscard]] constexpr const reference operator*() const noexcept
-            {
-                return data_[*gen_];
+            const std::int64_t* dims{ plan->dims().data() };
+            const std::int64_t* strides{ plan->strides(0).data() };
+
+            constexpr std::int64_t max_static_outer_loops{ 8 };
+            std::int64_t static_counters[max_static_outer_loops]{};
+            std::vector<std::int64_t> dynamic_counters(nouter > max_static_outer_loops ? nouter : 0, 0);
+            std::int64_t* counters{ nouter > max_static_outer_loops ? dynamic_counters.data() : static_counters };
+
+            std::int64_t index{ hdr.offset() };
+            for (;;) {
+                func(index, length, stride);
+
+                std::int64_t i{ nouter - 1 };
+                for (; i >= 0; --i) {
+                    index += strides[i];
+                    if (++counters[i] < dims[i]) {
+                        break;
+                    }
+                    index -= counters[i] * strides[i];
+                    counters[i] = 0;
+                }
+                if (i < 0) {
+                    return;
+                }
             }
+        }
 
-            [[nodiscard]] constexpr bool operator==(const arrnd_const_reverse_iterator& iter) const
-            {
-                return *gen_ == *(iter.gen_);
+        /**
+        * @note Calls func(indices, length, strides) for each run of the joint iteration plan of headers of the same dimensions (e.g. the operands
+        * and the result of a binary operation), where indices (of the first elements) and strides are arrays of a value per operand.
+        * Dimensions are coalesced only where they are contiguous for all the operands, so that a single loop nest serves all of them.
+        */
+        template <typename Func, typename Header, typename... Headers>
+        inline void for_each_joint_run(Func&& func, const Header& hdr, const Headers&... hdrs)
+        {
+            constexpr std::size_t num_operands{ 1 + sizeof...(Headers) };
+
+            if (hdr.empty() || hdr.count() <= 0) {
+                return;
             }
 
-        private:
-            indexer_type gen_;
-            pointer data_ = nullptr;
-        };
+            const auto plan = iteration_plan_of(hdr, hdrs...);
 
+            const std::int64_t length{ plan->inner_length() };
+            const std::int64_t nouter{ plan->ndims() - 1 };
 
-        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator, typename Header = arrnd_header<>, typename Indexer = arrnd_general_indexer<>>
-        class arrnd {
-        public:
-            using value_type = T;
-            using size_type = std::int64_t;
-            using difference_type = std::int64_t;
-            using reference = T&;
-            using const_reference = const T&;
-            using pointer = T*;
-            using const_pointer = const T*;
+            std::array<std::int64_t, num_operands> indices{ hdr.offset(), hdrs.offset()... };
+            std::array<std::int64_t, num_operands> inner_strides{};
+            std::array<const std::int64_t*, num_operands> strides{};
+            for (std::size_t op = 0; op < num_operands; ++op) {
+                inner_strides[op] = plan->inner_stride(op);
+                strides[op] = plan->strides(op).data();
+            }
 
-            using iterator = arrnd_iterator<T, Indexer>;
-            using const_iterator = arrnd_const_iterator<T, Indexer>;
-            using reverse_iterator = arrnd_reverse_iterator<T, Indexer>;
-            using const_reverse_iterator = arrnd_const_reverse_iterator<T, Indexer>;
+            if (nouter <= 0) {
+                func(std::as_const(indices), length, std::as_const(inner_strides));
+                return;
+            }
 
-            using tag = arrnd_tag;
+            const std::int64_t* dims{ plan->dims().data() };
 
-            using storage_type = Storage;
-            template <typename U>
-            using shared_ref_allocator_type = SharedRefAllocator<T>;
-            using header_type = Header;
-            using indexer_type = Indexer;
+            constexpr std::int64_t max_static_outer_loops{ 8 };
+            std::int64_t static_counters[max_static_outer_loops]{};
+            std::vector<std::int64_t> dynamic_counters(nouter > max_static_outer_loops ? nouter : 0, 0);
+            std::int64_t* counters{ nouter > max_static_outer_loops ? dynamic_counters.data() : static_counters };
 
-            using this_type = arrnd<T, Storage, SharedRefAllocator, Header, Indexer>;
-            template <typename U>
-            using replaced_type = arrnd<U, typename Storage::template replaced_type<U>, SharedRefAllocator, Header, Indexer>;
+            for (;;) {
+                func(std::as_const(indices), length, std::as_const(inner_strides));
 
-            arrnd() = default;
+                std::int64_t i{ nouter - 1 };
+                for (; i >= 0; --i) {
+                    if (++counters[i] < dims[i]) {
+                        for (std::size_t op = 0; op < num_operands; ++op) {
+                            indices[op] += strides[op][i];
+                        }
+                        break;
+                    }
+                    for (std::size_t op = 0; op < num_operands; ++op) {
+                        indices[op] -= (counters[i] - 1) * strides[op][i];
+                    }
+                    counters[i] = 0;
+                }
+                if (i < 0) {
+                    return;
+                }
+            }
+        }
 
-            arrnd(arrnd&& other) = default;
-            template<arrnd_complient ArCo>
-            arrnd(ArCo&& other)
-                : arrnd(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()))
+        /**
+        * @note Forward iteration of N operands of the same dimensions over their joint iteration plan (as NumPy's nditer),
+        * i.e. the buffer index of each operand is advanced by a single shared loop nest.
+        */
+        template <std::size_t N, typename Storage = simple_dynamic_vector<std::int64_t>>
+        class arrnd_multi_indexer final
+        {
+        public:
+            using storage_type = Storage;
+            using plan_type = arrnd_iteration_plan<storage_type>;
+
+            template <typename... Headers> requires (sizeof...(Headers) == N)
+            explicit arrnd_multi_indexer(const Headers&... hdrs)
+                : indices_{ hdrs.offset()... }
             {
-                copy(other, *this);
+                const std::array<std::span<const std::int64_t>, N> strides{ hdrs.strides()... };
+                const std::array<std::span<const std::int64_t>, N> dims{ hdrs.dims()... };
+                plan_ = arrnd_iteration_plan_cache<plan_type>::get(dims[0], strides);
 
-                ArCo dummy{ std::move(other) };
+                count_ = std::get<0>(std::tie(hdrs...)).empty() ? 0 : plan_->count();
+                counters_ = storage_type(plan_->ndims());
+                std::fill(counters_.begin(), counters_.end(), 0);
             }
-            arrnd& operator=(arrnd&& other) & = default;
-            arrnd& operator=(arrnd&& other)&&
+
+            arrnd_multi_indexer& operator++() noexcept
             {
-                if (&other == this) {
+                if (++pos_ >= count_) {
+                    pos_ = count_;
                     return *this;
                 }
 
-                copy(other, *this);
-                arrnd dummy{ std::move(other) };
+                const std::int64_t ndims{ plan_->ndims() };
+                const std::int64_t* dims{ plan_->dims().data() };
+
+                for (std::int64_t i = ndims - 1; i >= 0; --i) {
+                    if (++counters_[i] < dims[i]) {
+                        for (std::size_t op = 0; op < N; ++op) {
+                            indices_[op] += plan_->strides(op)[i];
+                        }
+                        return *this;
+                    }
+                    for (std::size_t op = 0; op < N; ++op) {
+                        indices_[op] -= (counters_[i] - 1) * plan_->strides(op)[i];
+                    }
+                    counters_[i] = 0;
+                }
                 return *this;
             }
-            template<arrnd_complient ArCo>
-            arrnd& operator=(ArCo&& other)&
+
+            [[nodiscard]] explicit operator bool() const noexcept
             {
-                *this = this_type(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()));
-                copy(other, *this);
-                ArCo dummy{ std::move(other) };
-                return *this;
+                return pos_ < count_;
             }
-            template<arrnd_complient ArCo>
-            arrnd& operator=(ArCo&& other)&&
+
+            /**
+            * @return Buffer index of the current element of operand.
+            */
+            [[nodiscard]] std::int64_t operator[](std::size_t operand) const noexcept
             {
-                copy(other, *this);
-                ArCo dummy{ std::move(other) };
-                return *this;
+                return indices_[operand];
             }
 
-            arrnd(const arrnd& other) = default;
-            template<arrnd_complient ArCo>
-            arrnd(const ArCo& other)
-                : arrnd(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()))
+            [[nodiscard]] const std::array<std::int64_t, N>& indices() const noexcept
             {
-                copy(other, *this);
+                return indices_;
             }
-            arrnd& operator=(const arrnd& other) & = default;
-            arrnd& operator=(const arrnd& other)&&
-            {
-                if (&other == this) {
-                    return *this;
-                }
 
-                copy(other, *this);
-                return *this;
-            }
-            template<arrnd_complient ArCo>
-            arrnd& operator=(const ArCo& other)&
+        private:
+            std::shared_ptr<const plan_type> plan_{};
+            storage_type counters_{};
+            std::array<std::int64_t, N> indices_{};
+            std::int64_t count_{ 0 };
+            std::int64_t pos_{ 0 };
+        };
+
+        template <typename Storage = simple_dynamic_vector<std::int64_t>, typename Header = arrnd_header<>>
+        class arrnd_general_indexer final
+        {
+        public:
+            using storage_type = Storage;
+            using header_type = Header;
+            using plan_type = arrnd_iteration_plan<storage_type>;
+
+            constexpr arrnd_general_indexer(const header_type& hdr, bool backward = false)
+                : arrnd_general_indexer(hdr, std::span<const std::int64_t>{}, backward)
             {
-                *this = this_type(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()));
-                copy(other, *this);
-                return *this;
             }
-            template<arrnd_complient ArCo>
-            arrnd& operator=(const ArCo& other)&&
+
+            constexpr arrnd_general_indexer(const header_type& hdr, std::int64_t axis, bool backward = false)
+                : arrnd_general_indexer(hdr, order_from_major_axis(hdr.dims().size(), axis), backward)
             {
-                copy(other, *this);
-                return *this;
             }
 
-            template <typename U>
-            arrnd& operator=(const U& value)
+            /**
+            * @note The (coalesced) loop nest of more than max_unrolled_axes axes is taken from the per thread cache of iteration plans,
+            * so that iterating arrays of the same layout does not recompute it. Smaller loop nests are iterated by the unrolled loops alone,
+            * and are built in place, without hashing and shared ownership of a cached plan.
+            */
+            constexpr arrnd_general_indexer(const header_type& hdr, std::span<const std::int64_t> order, bool backward = false)
             {
-                if (empty(*this)) {
-                    return *this;
+                const std::span<const std::int64_t> hdr_strides{ hdr.strides() };
+                const std::span<const std::span<const std::int64_t>> strides(&hdr_strides, 1);
+
+                std::int64_t unrolled_dims[max_unrolled_axes]{};
+                std::int64_t unrolled_strides[max_unrolled_axes]{};
+
+                const std::int64_t* loop_dims{ unrolled_dims };
+                const std::int64_t* loop_strides{ unrolled_strides };
+                if (loop_nest_axes(hdr.dims(), order) <= max_unrolled_axes) {
+                    ndims_ = coalesce_loop_nest(hdr.dims(), strides, order, unrolled_dims, unrolled_strides);
                 }
+                else {
+                    plan_ = arrnd_iteration_plan_cache<plan_type>::get(hdr.dims(), strides, order);
+                    dims_ = plan_->dims().data();
+                    strides_ = plan_->strides(0).data();
+                    ndims_ = plan_->ndims();
+                    loop_dims = dims_;
+                    loop_strides = strides_;
+                }
+
+                // iteration is bounded by position rather than by buffer index, since reversed axes (of negative strides) do not iterate in ascending index order.
+                // the ends are at indices out of the elements range, so that they are not equal to any element index.
+                first_index_ = hdr.offset();
+                last_index_ = std::inner_product(loop_dims, loop_dims + ndims_, loop_strides, first_index_,
+                    [](auto a, auto b) { return a + b; },
+                    [](auto a, auto b) { return (a - 1) * b; });
+                end_index_ = hdr.last_index() + 1;
+                rend_index_ = hdr.first_index() - 1;
 
-                for (indexer_type gen(hdr_); gen; ++gen) {
-                    (*this)[*gen] = value;
+                count_ = hdr.count();
+                pos_ = backward ? count_ - 1 : 0;
+
+                if (ndims_ > 0) {
+                    first_dim_ = loop_dims[ndims_ - 1];
+                    first_stride_ = loop_strides[ndims_ - 1];
+                    first_ind_ = backward ? first_dim_ - 1 : 0;
                 }
 
-                return *this;
-            }
+                if (ndims_ > 1) {
+                    second_dim_ = loop_dims[ndims_ - 2];
+                    second_stride_ = loop_strides[ndims_ - 2];
+                    second_ind_ = backward ? second_dim_ - 1 : 0;
+                }
 
-            virtual ~arrnd() = default;
+                if (ndims_ > 2) {
+                    third_dim_ = loop_dims[ndims_ - 3];
+                    third_stride_ = loop_strides[ndims_ - 3];
+                    third_ind_ = backward ? third_dim_ - 1 : 0;
+                }
 
-            explicit arrnd(std::span<const std::int64_t> dims, const_pointer data = nullptr)
-                : hdr_(dims), buffsp_(std::allocate_shared<storage_type>(shared_ref_allocator_type<storage_type>(), hdr_.count()))
-            {
-                if (data) {
-                    std::copy(data, data + hdr_.count(), buffsp_->data());
+                if (ndims_ > 3) {
+                    indices_.resize(ndims_ - 3);
+                    for (std::int64_t i = 0; i < indices_.size(); ++i) {
+                        indices_[i] = backward ? dims_[i] - 1 : 0;
+                    }
                 }
+
+                current_index_ = backward ? last_index_ : first_index_;
             }
-            explicit arrnd(std::span<const std::int64_t> dims, std::initializer_list<value_type> data)
-                : arrnd(dims, data.begin())
-            {
-            }
-            explicit arrnd(std::initializer_list<std::int64_t> dims, const_pointer data = nullptr)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data)
-            {
-            }
-            explicit arrnd(std::initializer_list<std::int64_t> dims, std::initializer_list<value_type> data)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data.begin())
-            {
-            }
-            template <typename U>
-            explicit arrnd(std::span<const std::int64_t> dims, const U* data = nullptr)
-                : hdr_(dims), buffsp_(std::allocate_shared<storage_type>(shared_ref_allocator_type < storage_type>(), hdr_.count()))
-            {
-                std::copy(data, data + hdr_.count(), buffsp_->data());
-            }
-            template <typename U>
-            explicit arrnd(std::span<const std::int64_t> dims, std::initializer_list<U> data)
-                : arrnd(dims, data.begin())
-            {
-            }
-            template <typename U>
-            explicit arrnd(std::initializer_list<std::int64_t> dims, const U* data = nullptr)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data)
-            {
-            }
-            template <typename U>
-            explicit arrnd(std::initializer_list<std::int64_t> dims, std::initializer_list<U> data = nullptr)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data.begin())
-            {
-            }
 
+            constexpr arrnd_general_indexer() = default;
+
+            constexpr arrnd_general_indexer(const arrnd_general_indexer& other) = default;
+            constexpr arrnd_general_indexer& operator=(const arrnd_general_indexer& other) = default;
 
-            explicit arrnd(std::span<const std::int64_t> dims, const_reference value)
-                : hdr_(dims), buffsp_(std::allocate_shared<storage_type>(shared_ref_allocator_type < storage_type>(), hdr_.count()))
-            {
-                std::fill(buffsp_->data(), buffsp_->data() + buffsp_->size(), value);
-            }
-            explicit arrnd(std::initializer_list<std::int64_t> dims, const_reference value)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, value)
-            {
-            }
-            template <typename U>
-            explicit arrnd(std::span<const std::int64_t> dims, const U& value)
-                : hdr_(dims), buffsp_(std::allocate_shared<storage_type>(shared_ref_allocator_type < storage_type>(), hdr_.count()))
-            {
-                std::fill(buffsp_->data(), buffsp_->data() + buffsp_->size(), value);
-            }
-            template <typename U>
-            explicit arrnd(std::initializer_list<std::int64_t> dims, const U& value)
-                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, value)
+            constexpr arrnd_general_indexer(arrnd_general_indexer&& other) noexcept = default;
+            constexpr arrnd_general_indexer& operator=(arrnd_general_indexer&& other) noexcept = default;
+
+            constexpr ~arrnd_general_indexer() = default;
+
+            constexpr arrnd_general_indexer& operator++() noexcept
             {
+                if (pos_ < 0) {
+                    pos_ = 0;
+                    current_index_ = first_index_;
+                    return *this;
+                }
+                if (pos_ >= count_ - 1) {
+                    pos_ = count_;
+                    current_index_ = end_index_;
+                    return *this;
+                }
+                ++pos_;
+                ++first_ind_;
+                current_index_ += first_stride_;
+                if (first_ind_ < first_dim_) {
+                    return *this;
+                }
+                current_index_ -= first_ind_ * first_stride_;
+                first_ind_ = 0;
+                if (ndims_ > 1) {
+                    ++second_ind_;
+                    current_index_ += second_stride_;
+                    if (second_ind_ < second_dim_) {
+                        return *this;
+                    }
+                    current_index_ -= second_ind_ * second_stride_;
+                    second_ind_ = 0;
+                }
+                if (ndims_ > 2) {
+                    ++third_ind_;
+                    current_index_ += third_stride_;
+                    if (third_ind_ < third_dim_) {
+                        return *this;
+                    }
+                    current_index_ -= third_ind_ * third_stride_;
+                    third_ind_ = 0;
+                }
+                for (std::int64_t i = ndims_ - 4; i >= 0; --i) {
+                    ++indices_[i];
+                    current_index_ += strides_[i];
+                    if (indices_[i] < dims_[i]) {
+                        return *this;
+                    }
+                    current_index_ -= indices_[i] * strides_[i];
+                    indices_[i] = 0;
+                }
+                return *this;
             }
 
-            [[nodiscard]] const header_type& header() const noexcept
+            constexpr arrnd_general_indexer operator++(int) noexcept
             {
-                return hdr_;
+                arrnd_general_indexer<storage_type, header_type> temp{ *this };
+                ++(*this);
+                return temp;
             }
 
-            [[nodiscard]] header_type& header() noexcept
+            constexpr arrnd_general_indexer& operator+=(std::int64_t count) noexcept
             {
-                return hdr_;
+                for (std::int64_t i = 0; i < count; ++i) {
+                    ++(*this);
+                }
+                return *this;
             }
 
-            [[nodiscard]] pointer data() const noexcept
+            arrnd_general_indexer operator+(std::int64_t count) noexcept
             {
-                return buffsp_ ? buffsp_->data() : nullptr;
+                arrnd_general_indexer<storage_type, header_type> temp{ *this };
+                temp += count;
+                return temp;
             }
 
-            [[nodiscard]] const_reference operator[](std::int64_t index) const noexcept
+            constexpr arrnd_general_indexer& operator--() noexcept
             {
-                return buffsp_->data()[modulo(index, hdr_.last_index() + 1)];
+                if (pos_ >= count_) {
+                    pos_ = count_ - 1;
+                    current_index_ = last_index_;
+                    return *this;
+                }
+                if (pos_ <= 0) {
+                    pos_ = -1;
+                    current_index_ = rend_index_;
+                    return *this;
+                }
+                --pos_;
+                --first_ind_;
+                current_index_ -= first_stride_;
+                if (first_ind_ > -1) {
+                    return *this;
+                }
+                first_ind_ = first_dim_ - 1;
+                current_index_ += (first_ind_ + 1) * first_stride_;
+                if (ndims_ > 1) {
+                    --second_ind_;
+                    current_index_ -= second_stride_;
+                    if (second_ind_ > -1) {
+                        return *this;
+                    }
+                    second_ind_ = second_dim_ - 1;
+                    current_index_ += (second_ind_ + 1) * second_stride_;
+                }
+                if (ndims_ > 2) {
+                    --third_ind_;
+                    current_index_ -= third_stride_;
+                    if (third_ind_ > -1) {
+                        return *this;
+                    }
+                    third_ind_ = third_dim_ - 1;
+                    current_index_ += (third_ind_ + 1) * third_stride_;
+                }
+                for (std::int64_t i = ndims_ - 4; i >= 0; --i) {
+                    --indices_[i];
+                    current_index_ -= strides_[i];
+                    if (indices_[i] > -1) {
+                        return *this;
+                    }
+                    indices_[i] = dims_[i] - 1;
+                    current_index_ += (indices_[i] + 1) * strides_[i];
+                }
+                return *this;
             }
-            [[nodiscard]] reference operator[](std::int64_t index) noexcept
+
+            constexpr arrnd_general_indexer operator--(int) noexcept
             {
-                return buffsp_->data()[modulo(index, hdr_.last_index() + 1)];
+                arrnd_general_indexer<storage_type, header_type> temp{ *this };
+                --(*this);
+                return temp;
             }
 
-            [[nodiscard]] const_reference operator[](std::span<std::int64_t> subs) const noexcept
+            constexpr arrnd_general_indexer& operator-=(std::int64_t count) noexcept
             {
-                return buffsp_->data()[subs2ind(hdr_.offset(), hdr_.strides(), hdr_.dims(), subs)];
+                for (std::int64_t i = 0; i < count; ++i) {
+                    --(*this);
+                }
+                return *this;
             }
-            [[nodiscard]] const_reference operator[](std::initializer_list<std::int64_t> subs) const noexcept
+
+            constexpr arrnd_general_indexer operator-(std::int64_t count) noexcept
             {
-                return (*this)[std::span<std::int64_t>{ const_cast<std::int64_t*>(subs.begin()), subs.size() }];
+                arrnd_general_indexer<storage_type, header_type> temp{ *this };
+                temp -= count;
+                return temp;
             }
 
-            [[nodiscard]] reference operator[](std::span<std::int64_t> subs) noexcept
+            [[nodiscard]] explicit constexpr operator bool() const noexcept
             {
-                return buffsp_->data()[subs2ind(hdr_.offset(), hdr_.strides(), hdr_.dims(), subs)];
+                return static_cast<std::uint64_t>(pos_) < static_cast<std::uint64_t>(count_);
             }
-            [[nodiscard]] reference operator[](std::initializer_list<std::int64_t> subs) noexcept
+
+            [[nodiscard]] constexpr std::int64_t operator*() const noexcept
             {
-                return (*this)[std::span<std::int64_t>{ const_cast<std::int64_t*>(subs.begin()), subs.size() }];
+                return current_index_;
             }
 
-            [[nodiscard]] arrnd operator[](std::span<const Interval<std::int64_t>> ranges) const
-            {
-                if (ranges.empty() || empty(*this)) {
-                    return (*this);
-                }
+        private:
+            // number of axes that are iterated by the unrolled loops of operator++ and operator--
+            static constexpr std::int64_t max_unrolled_axes{ 3 };
 
-                this_type slice{};
-                slice.hdr_ = header_type{ hdr_, ranges };
-                slice.buffsp_ = slice.hdr_.empty() ? nullptr : buffsp_;
-                return slice;
-            }
-            [[nodiscard]] arrnd operator[](std::initializer_list<Interval<std::int64_t>> ranges) const
+            constexpr static storage_type order_from_major_axis(std::int64_t order_size, std::int64_t axis)
             {
-                return (*this)[std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()}];
+                storage_type new_ordered_indices(order_size);
+                std::iota(new_ordered_indices.begin(), new_ordered_indices.end(), static_cast<std::int64_t>(0));
+                new_ordered_indices[0] = axis;
+                std::int64_t pos = 1;
+                for (std::int64_t i = 0; i < order_size; ++i) {
+                    if (i != axis) {
+                        new_ordered_indices[pos++] = i;
+                    }
+                }
+                return new_ordered_indices;
             }
 
-            template <arrnd_complient ArCo> requires std::is_integral_v<typename ArCo::value_type>
-            [[nodiscard]] arrnd operator[](const ArCo& indices) const noexcept
-            {
-                this_type res(std::span<const std::int64_t>(indices.header().dims().data(), indices.header().dims().size()));
+            std::shared_ptr<const plan_type> plan_{};
+            const std::int64_t* dims_{ nullptr };
+            const std::int64_t* strides_{ nullptr };
+            std::int64_t first_index_{ 0 };
+            std::int64_t last_index_{ 0 };
+            std::int64_t end_index_{ 0 };
+            std::int64_t rend_index_{ 0 };
+            std::int64_t count_{ 0 };
+            std::int64_t pos_{ 0 };
+            std::int64_t ndims_{ 0 };
 
-                indexer_type res_gen(res.header());
-                typename ArCo::indexer_type ind_gen(indices.header());
+            std::int64_t first_stride_{ 0 };
+            std::int64_t first_dim_{ 0 };
+            std::int64_t first_ind_{ 0 };
 
-                for (; res_gen && ind_gen; ++res_gen, ++ind_gen) {
-                    res[*res_gen] = (*this)[indices[*ind_gen]];
-                }
+            std::int64_t second_stride_{ 0 };
+            std::int64_t second_dim_{ 0 };
+            std::int64_t second_ind_{ 0 };
 
-                return res;
+            std::int64_t third_stride_{ 0 };
+            std::int64_t third_dim_{ 0 };
+            std::int64_t third_ind_{ 0 };
+
+            storage_type indices_{};
+            std::int64_t current_index_{ 0 };
+        };
+
+
+
+
+        /**
+        * @note Requires a contiguous (row major) header.
+        */
+        template <typename Header = arrnd_header<>>
+        class arrnd_fast_indexer final
+        {
+        public:
+            using header_type = Header;
+
+            constexpr arrnd_fast_indexer(const header_type& hdr, bool backward = false)
+                : arrnd_fast_indexer(hdr, 0, backward)
+            {
             }
 
-            /**
-            * @note copy this array to dst partially or full depending on the arrays size
-            */
-            template <arrnd_complient ArCo>
-            const arrnd& copy_to(ArCo& dst) const
+            constexpr arrnd_fast_indexer(const header_type& hdr, std::int64_t axis, bool backward = false)
             {
-                if (empty(*this) || empty(dst)) {
-                    return *this;
+                // data
+
+                last_index_ = hdr.last_index();
+
+                num_super_groups_ = hdr.dims()[axis];
+                step_size_between_super_groups_ = hdr.strides()[axis];
+
+                num_groups_in_super_group_ =
+                    std::accumulate(hdr.dims().begin(), hdr.dims().begin() + axis + 1, 1, std::multiplies<>{}) / num_super_groups_;
+                group_size_ = hdr.strides()[axis];
+                step_size_inside_group_ = hdr.strides().back();
+                step_size_between_groups_ = num_super_groups_ * step_size_between_super_groups_;
+
+                // accumulators
+                if (!backward) {
+                    current_index_ = 0;
+
+                    super_groups_counter_ = 0;
+
+                    group_indices_counter_ = 0;
+                    groups_counter_ = 0;
+
+                    super_group_start_index_ = 0;
+
+                    group_start_index_ = 0;
                 }
+                else {
+                    group_indices_counter_ = group_size_ - 1;
+                    groups_counter_ = num_groups_in_super_group_ - 1;
+                    super_groups_counter_ = num_super_groups_ - 1;
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type dst_gen(dst.header());
+                    super_group_start_index_ = super_groups_counter_ * step_size_between_super_groups_;
+                    group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
 
-                for (; gen && dst_gen; ++gen, ++dst_gen) {
-                    dst[*dst_gen] = (*this)[*gen];
+                    current_index_ = last_index_;
                 }
-                
-                return *this;
             }
 
-            template <arrnd_complient ArCo1, arrnd_complient ArCo2> requires std::is_integral_v<typename ArCo2::value_type>
-            const arrnd& copy_to(ArCo1& dst, const ArCo2& indices) const
+            constexpr arrnd_fast_indexer() = default;
+
+            constexpr arrnd_fast_indexer(const arrnd_fast_indexer& other) = default;
+            constexpr arrnd_fast_indexer& operator=(const arrnd_fast_indexer& other) = default;
+
+            constexpr arrnd_fast_indexer(arrnd_fast_indexer&& other) noexcept = default;
+            constexpr arrnd_fast_indexer& operator=(arrnd_fast_indexer&& other) noexcept = default;
+
+            constexpr ~arrnd_fast_indexer() = default;
+
+            constexpr arrnd_fast_indexer& operator++() noexcept
             {
-                if (empty(*this) || empty(dst) || empty(indices)) {
+                // the algorithm is done by three functions composition:
+                // - index
+                // - group
+                // - super group
+
+                // index function
+
+                if (current_index_ > last_index_) {
                     return *this;
                 }
 
-                indexer_type gen(header());
-                typename ArCo2::indexer_type ind_gen(indices.header());
+                ++group_indices_counter_;
+                current_index_ += step_size_inside_group_;
 
-                for (;gen && ind_gen; ++gen, ++ind_gen) {
-                    dst[indices[*ind_gen]] = (*this)[*gen];
+                if (group_indices_counter_ < group_size_) {
+                    return *this;
                 }
 
-                return *this;
-            }
+                // group function
 
-            template <arrnd_complient ArCo>
-            const arrnd& copy_to(ArCo& dst, std::span<const Interval<std::int64_t>> ranges) const
-            {
-                auto slice = dst[ranges];
-                copy_to(slice);
-                return *this;
-            }
-            template <arrnd_complient ArCo>
-            const arrnd& copy_to(ArCo& dst, std::initializer_list<Interval<std::int64_t>> ranges) const
-            {
-                return copy_to(dst, std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()});
-            }
+                group_indices_counter_ = 0;
 
-            /**
-            * @note if buffer reallocation not required use copy_to function
-            */
-            template <arrnd_complient ArCo>
-            const arrnd& set_to(ArCo& dst) const
-            {
-                if (empty(*this)) {
-                    dst = ArCo{};
+                ++groups_counter_;
+                group_start_index_ += step_size_between_groups_;
+
+                current_index_ = group_start_index_;
+
+                if (groups_counter_ < num_groups_in_super_group_) {
                     return *this;
                 }
 
-                if (empty(dst)) {
-                    dst = ArCo{ header().dims() };
-                    return copy_to(dst);
-                }
+                // super group function
 
-                if (header().count() == dst.header().count()) {
-                    if (header().dims() != dst.header().dims()) {
-                        dst.header() = header_type{ header().dims() };
-                    }
-                    return copy_to(dst);
+                groups_counter_ = 0;
+
+                ++super_groups_counter_;
+                super_group_start_index_ += step_size_between_super_groups_;
+
+                group_start_index_ = super_group_start_index_;
+
+                current_index_ = group_start_index_;
+
+                if (super_groups_counter_ < num_super_groups_) {
+                    return *this;
                 }
 
-                dst = ArCo{ header().dims() };
-                return copy_to(dst);
-            }
+                group_indices_counter_ = group_size_;
+                groups_counter_ = num_groups_in_super_group_ - 1;
+                super_groups_counter_ = num_super_groups_ - 1;
+
+                super_group_start_index_ = super_groups_counter_ * step_size_between_super_groups_;
+                group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
+
+                current_index_ = last_index_ + 1;
 
-            template <arrnd_complient ArCo>
-            arrnd& copy_from(const ArCo& src)
-            {
-                src.copy_to(*this);
                 return *this;
             }
 
-            template <arrnd_complient ArCo1, arrnd_complient ArCo2> requires std::is_integral_v<typename ArCo2::value_type>
-            arrnd& copy_from(const ArCo1& src, const ArCo2& indices)
+            constexpr arrnd_fast_indexer operator++(int) noexcept
             {
-                src.copy_to(*this, indices);
-                return *this;
+                arrnd_fast_indexer<header_type> temp{ *this };
+                ++(*this);
+                return temp;
             }
 
-            template <arrnd_complient ArCo>
-            arrnd& copy_from(const ArCo& src, std::span<const Interval<std::int64_t>> ranges)
+            constexpr arrnd_fast_indexer& operator+=(std::int64_t count) noexcept
             {
-                src.copy_to(*this, ranges);
+                for (std::int64_t i = 0; i < count; ++i) {
+                    ++(*this);
+                }
                 return *this;
             }
-            template <arrnd_complient ArCo>
-            arrnd& copy_from(const ArCo& src, std::initializer_list<Interval<std::int64_t>> ranges)
-            {
-                return copy_from(src, std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()});
-            }
 
-            template <arrnd_complient ArCo>
-            arrnd& set_from(const ArCo& src)
+            constexpr arrnd_fast_indexer operator+(std::int64_t count) noexcept
             {
-                src.set_to(*this);
-                return *this;
+                arrnd_fast_indexer<header_type> temp{ *this };
+                temp += count;
+                return temp;
             }
 
-            [[nodiscard]] auto clone() const
+            constexpr arrnd_fast_indexer& operator--() noexcept
             {
-                if (empty(*this)) {
-                    return this_type();
+                // the algorithm is done by inverese of three functions composition:
+                // - super group
+                // - group
+                // - index
+
+                if (current_index_ < 0) {
+                    return *this;
                 }
 
-                this_type clone(std::span<const std::int64_t>(header().dims().data(), header().dims().size()));
+                // index function
 
-                indexer_type gen(header());
-                indexer_type clone_gen(clone.header());
+                --group_indices_counter_;
+                current_index_ -= step_size_inside_group_;
 
-                for (; gen && clone_gen; ++gen, ++clone_gen) {
-                    clone[*clone_gen] = (*this)[*gen];
+                if (group_indices_counter_ >= 0) {
+                    return *this;
                 }
 
-                return clone;
-            }
+                // group function
 
+                group_indices_counter_ = group_size_ - 1;
 
-            /**
-            * @note Returning a reference to the input array and no allocation performed. If empty array, subarray, or different dimensions resizing.
-            */
-            [[nodiscard]] auto reshape(std::span<const std::int64_t> new_dims) const
-            {
-                if (header().count() != numel(new_dims) || header().is_subarray()) {
-                    return resize(new_dims);
-                }
+                --groups_counter_;
+                group_start_index_ -= step_size_between_groups_;
 
-                if (header().dims() == new_dims) {
+                current_index_ = group_start_index_ + (group_size_-1) * step_size_inside_group_;
+
+                if (groups_counter_ >= 0) {
                     return *this;
                 }
 
-                typename this_type::header_type new_header(new_dims);
-                if (new_header.empty()) {
-                    return this_type();
-                }
+                // super group function
 
-                this_type res(*this);
-                res.header() = std::move(new_header);
+                groups_counter_ = num_groups_in_super_group_ - 1;
 
-                return res;
-            }
-            [[nodiscard]] auto reshape(std::initializer_list<std::int64_t> new_dims) const
-            {
-                return reshape(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
-            }
+                --super_groups_counter_;
+                super_group_start_index_ -= step_size_between_super_groups_;
 
-            /*
-            * @note Other references to this array buffer are not modified. Resize is not performed if dims and new_dims are equal.
-            */
-            [[nodiscard]] auto resize(std::span<const std::int64_t> new_dims) const
-            {
-                if (empty(*this)) {
-                    return this_type(std::span<const std::int64_t>(new_dims.data(), new_dims.size()));
-                }
+                group_start_index_ = super_group_start_index_ + groups_counter_ * step_size_between_groups_;
 
-                if (header().dims() == new_dims) {
+                current_index_ = group_start_index_ + (group_size_-1) * step_size_inside_group_;
+
+                if (super_groups_counter_ >= 0) {
                     return *this;
                 }
 
-                if (numel(new_dims) <= 0) {
-                    return this_type();
-                }
+                group_indices_counter_ = -1;
+                groups_counter_ = 0;
+                super_groups_counter_ = 0;
 
-                this_type res(std::span<const std::int64_t>(new_dims.data(), new_dims.size()));
+                super_group_start_index_ = 0;
+                group_start_index_ = 0;
 
-                indexer_type gen(header());
-                indexer_type res_gen(res.header());
+                current_index_ = -1;
 
-                while (gen && res_gen) {
-                    res[*res_gen] = (*this)[*gen];
-                    ++gen;
-                    ++res_gen;
-                }
+                return *this;
+            }
 
-                return res;
+            constexpr arrnd_fast_indexer operator--(int) noexcept
+            {
+                arrnd_fast_indexer<header_type> temp{ *this };
+                --(*this);
+                return temp;
             }
-            [[nodiscard]] auto resize(std::initializer_list<std::int64_t> new_dims) const
+
+            constexpr arrnd_fast_indexer& operator-=(std::int64_t count) noexcept
             {
-                return resize(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+                for (std::int64_t i = 0; i < count; ++i) {
+                    --(*this);
+                }
+                return *this;
             }
 
+            constexpr arrnd_fast_indexer operator-(std::int64_t count) noexcept
+            {
+                arrnd_fast_indexer<header_type> temp{ *this };
+                temp -= count;
+                return temp;
+            }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto append(const ArCo& arr) const
+            [[nodiscard]] explicit constexpr operator bool() const noexcept
             {
-                if (empty(*this)) {
-                    this_type res(arr);
-                    return res.clone();
-                }
+                return static_cast<std::uint64_t>(current_index_) <= static_cast<std::uint64_t>(last_index_);
+            }
 
-                if (empty(arr)) {
-                    return *this;
-                }
+            [[nodiscard]] constexpr std::int64_t operator*() const noexcept
+            {
+                return current_index_;
+            }
 
-                this_type res(resize({ header().count() + arr.header().count() }));
+        private:
+            std::int64_t current_index_ = 0;
 
-                ArCo rarr(arr.reshape({ arr.header().count() }));
+            // data
 
-                for (std::int64_t i = header().count(); i < res.header().count(); ++i) {
-                    res[{ i }] = arr[{ i - header().count() }];
-                }
+            std::int64_t last_index_ = 0;
 
-                return res;
-            }
+            std::int64_t num_super_groups_ = 0;
+            std::int64_t step_size_between_super_groups_ = 0;
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto append(const ArCo& arr, std::int64_t axis) const
-            {
-                if (empty(*this)) {
-                    this_type res(arr);
-                    return res.clone();
-                }
+            std::int64_t num_groups_in_super_group_ = 0;
+            std::int64_t group_size_ = 0;
+            std::int64_t step_size_inside_group_ = 0;
+            std::int64_t step_size_between_groups_ = 0;
+            
+            // counters
 
-                if (empty(arr)) {
-                    return *this;
-                }
+            std::int64_t super_groups_counter_ = 0;
 
-                header_type new_header(header(), arr.header().dims(), axis);
-                if (new_header.empty()) {
-                    return this_type{};
-                }
+            std::int64_t group_indices_counter_ = 0;
+            std::int64_t groups_counter_ = 0;
 
-                this_type res({ header().count() + arr.header().count() });
-                res.header() = std::move(new_header);
+            std::int64_t super_group_start_index_ = 0;
 
-                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+            std::int64_t group_start_index_ = 0;
+        };
 
-                indexer_type gen(header(), fixed_axis);
-                typename ArCo::indexer_type arr_gen(arr.header(), fixed_axis);
-                indexer_type res_gen(res.header(), fixed_axis);
+        template <typename T, typename Indexer = arrnd_general_indexer<>>
+        class arrnd_iterator final
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::int64_t;
+            using value_type = T;
+            using pointer = T*;
+            using reference = T&;
 
-                for (; gen && res_gen; ++gen, ++res_gen) {
-                    res.data()[*res_gen] = data()[*gen];
-                }
-                for (; arr_gen && res_gen; ++arr_gen, ++res_gen) {
-                    res.data()[*res_gen] = arr.data()[*arr_gen];
-                }
+            using indexer_type = Indexer;
 
-                return res;
+            constexpr arrnd_iterator(pointer data, const indexer_type& gen)
+                : gen_(gen), data_(data)
+            {
             }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto insert(const ArCo& arr, std::int64_t ind) const
+            constexpr arrnd_iterator() = default;
+
+            constexpr arrnd_iterator(const arrnd_iterator& other) = default;
+            constexpr arrnd_iterator& operator=(const arrnd_iterator& other) = default;
+
+            constexpr arrnd_iterator(arrnd_iterator&& other) noexcept = default;
+            constexpr arrnd_iterator& operator=(arrnd_iterator&& other) noexcept = default;
+
+            constexpr ~arrnd_iterator() = default;
+
+            constexpr arrnd_iterator& operator++() noexcept
             {
-                if (empty(*this)) {
-                    this_type res(arr);
-                    return res.clone();
-                }
+                ++gen_;
+                return *this;
+            }
 
-                if (empty(arr)) {
-                    return *this;
-                }
+            constexpr arrnd_iterator operator++(int) noexcept
+            {
+                arrnd_iterator temp{ *this };
+                ++(*this);
+                return temp;
+            }
 
-                this_type res({ header().count() + arr.header().count() });
+            constexpr arrnd_iterator& operator+=(difference_type count) noexcept
+            {
+                gen_ += count;
+                return *this;
+            }
 
-                this_type rlhs(reshape({ header().count() }));
-                ArCo rarr(arr.reshape({ arr.header().count() }));
+            constexpr arrnd_iterator operator+(difference_type count) noexcept
+            {
+                arrnd_iterator temp{ *this };
+                temp += count;
+                return temp;
+            }
 
-                std::int64_t fixed_ind{ modulo(ind, header().count() + 1) };
+            constexpr arrnd_iterator& operator--() noexcept
+            {
+                gen_--;
+                return *this;
+            }
 
-                for (std::int64_t i = 0; i < fixed_ind; ++i) {
-                    res[{ i }] = rlhs[{ i }];
-                }
-                for (std::int64_t i = 0; i < arr.header().count(); ++i) {
-                    res[{ fixed_ind + i }] = rarr[{ i }];
-                }
-                for (std::int64_t i = 0; i < header().count() - fixed_ind; ++i) {
-                    res[{ fixed_ind + arr.header().count() + i }] = rlhs[{ fixed_ind + i }];
-                }
+            constexpr arrnd_iterator operator--(int) noexcept
+            {
+                arrnd_iterator temp{ *this };
+                --(*this);
+                return temp;
+            }
 
-                return res;
+            constexpr arrnd_iterator& operator-=(difference_type count) noexcept
+            {
+                gen_ -= count;
+                return *this;
             }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto insert(const ArCo& arr, std::int64_t ind, std::int64_t axis) const
+            constexpr arrnd_iterator operator-(difference_type count) noexcept
             {
-                if (empty(*this)) {
-                    this_type res(arr);
-                    return res.clone();
-                }
+                arrnd_iterator temp{ *this };
+                temp -= count;
+                return temp;
+            }
 
-                if (empty(arr)) {
-                    return *this;
-                }
+            [[nodiscard]] constexpr reference operator*() const noexcept
+            {
+                return data_[*gen_];
+            }
 
-                header_type new_header(header(), arr.header().dims(), axis);
-                if (new_header.empty()) {
-                    return this_type();
-                }
+            [[nodiscard]] constexpr bool operator==(const arrnd_iterator& iter) const
+            {
+                return *gen_ == *(iter.gen_);
+            }
 
-                this_type res({ header().count() + arr.header().count() });
-                res.header() = std::move(new_header);
+        private:
+            indexer_type gen_;
+            pointer data_ = nullptr;
+        };
 
-                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
 
-                indexer_type gen(header(), fixed_axis);
-                typename ArCo::indexer_type arr_gen(arr.header(), fixed_axis);
-                indexer_type res_gen(res.header(), fixed_axis);
 
-                std::int64_t fixed_ind{ modulo(ind, header().dims()[fixed_axis]) };
-                std::int64_t cycle = fixed_ind *
-                    (std::accumulate(res.header().dims().begin(), res.header().dims().end(), 1, std::multiplies<>{}) / res.header().dims()[fixed_axis]);
 
-                for (; gen && res_gen && cycle; --cycle, ++gen, ++res_gen) {
-                    res.data()[*res_gen] = data()[*gen];
-                }
-                for (; arr_gen && res_gen; ++arr_gen, ++res_gen) {
-                    res.data()[*res_gen] = arr.data()[*arr_gen];
-                }
-                for (; gen && res_gen; ++gen, ++res_gen) {
-                    res.data()[*res_gen] = data()[*gen];
-                }
+        template <typename T, typename Indexer = arrnd_general_indexer<>>
+        class arrnd_const_iterator final
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::int64_t;
+            using value_type = T;
+            using pointer = T*;
+            using reference = T&;
 
-                return res;
-            }
+            using indexer_type = Indexer;
 
-            /**
-            * @note All elements starting from ind are being removed in case that count value is too big.
-            */
-            [[nodiscard]] auto remove(std::int64_t ind, std::int64_t count) const
+            constexpr arrnd_const_iterator(pointer data, const indexer_type& gen)
+                : gen_(gen), data_(data)
             {
-                if (empty(*this)) {
-                    return *this;
-                }
-
-                std::int64_t fixed_ind{ modulo(ind, header().count()) };
-                std::int64_t fixed_count{ fixed_ind + count < header().count() ? count : (header().count() - fixed_ind) };
-
-                this_type res({ header().count() - fixed_count });
-                this_type rarr(reshape({ header().count() }));
-
-                for (std::int64_t i = 0; i < fixed_ind; ++i) {
-                    res[{ i }] = rarr[{ i }];
-                }
-                for (std::int64_t i = fixed_ind + fixed_count; i < header().count(); ++i) {
-                    res[{ i - fixed_count }] = rarr[{ i }];
-                }
-
-                return res;
             }
 
-            /**
-            * @note All elements starting from ind are being removed in case that count value is too big.
-            */
-            [[nodiscard]] auto remove(std::int64_t ind, std::int64_t count, std::int64_t axis) const
-            {
-                if (empty(*this)) {
-                    return *this;
-                }
-
-                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
-                std::int64_t fixed_ind{ modulo(ind, header().dims()[fixed_axis]) };
-                std::int64_t fixed_count{ fixed_ind + count <= header().dims()[fixed_axis] ? count : (header().dims()[fixed_axis] - fixed_ind) };
-
-                header_type new_header(header(), -fixed_count, fixed_axis);
-                if (new_header.empty()) {
-                    return this_type();
-                }
+            constexpr arrnd_const_iterator() = default;
 
-                this_type res({ header().count() - (header().count() / header().dims()[fixed_axis]) * fixed_count });
-                res.header() = std::move(new_header);
+            constexpr arrnd_const_iterator(const arrnd_const_iterator& other) = default;
+            constexpr arrnd_const_iterator& operator=(const arrnd_const_iterator& other) = default;
 
-                indexer_type gen(header(), fixed_axis);
-                indexer_type res_gen(res.header(), fixed_axis);
+            constexpr arrnd_const_iterator(arrnd_const_iterator&& other) noexcept = default;
+            constexpr arrnd_const_iterator& operator=(arrnd_const_iterator&& other) noexcept = default;
 
-                std::int64_t cycle = fixed_ind *
-                    (std::accumulate(res.header().dims().begin(), res.header().dims().end(), 1, std::multiplies<>{}) / res.header().dims()[fixed_axis]);
+            constexpr ~arrnd_const_iterator() = default;
 
-                std::int64_t removals = header().count() - res.header().count();
+            constexpr arrnd_const_iterator& operator++() noexcept
+            {
+                ++gen_;
+                return *this;
+            }
 
-                for (; gen && res_gen && cycle; --cycle, ++gen, ++res_gen) {
-                    res.data()[*res_gen] = data()[*gen];
-                }
-                for (; gen && removals; --removals, ++gen) {
-                    //data()[*gen] = arr.data()[*arr_gen];
-                }
-                for (; gen && res_gen; ++gen, ++res_gen) {
-                    res.data()[*res_gen] = data()[*gen];
-                }
+            constexpr arrnd_const_iterator operator++(int) noexcept
+            {
+                arrnd_const_iterator temp{ *this };
+                ++(*this);
+                return temp;
+            }
 
-                return res;
+            constexpr arrnd_const_iterator& operator+=(difference_type count) noexcept
+            {
+                gen_ += count;
+                return *this;
             }
 
+            constexpr arrnd_const_iterator operator+(difference_type count) noexcept
+            {
+                arrnd_const_iterator temp{ *this };
+                temp += count;
+                return temp;
+            }
 
-            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
-            [[nodiscard]] auto transform(Unary_op&& op) const
+            constexpr arrnd_const_iterator& operator--() noexcept
             {
-                using U = decltype(op(data()[0]));
+                --gen_;
+                return *this;
+            }
 
-                if (empty(*this)) {
-                    return replaced_type<U>();
-                }
+            constexpr arrnd_const_iterator operator--(int) noexcept
+            {
+                arrnd_const_iterator temp{ *this };
+                --(*this);
+                return temp;
+            }
 
-                replaced_type<U> res(std::span<const std::int64_t>(header().dims().data(), header().dims().size()));
+            constexpr arrnd_const_iterator& operator-=(difference_type count) noexcept
+            {
+                gen_ -= count;
+                return *this;
+            }
 
-                for (indexer_type gen(header()); gen; ++gen) {
-                    res[*gen] = op((*this)[*gen]);
-                }
+            constexpr arrnd_const_iterator operator-(difference_type count) noexcept
+            {
+                arrnd_const_iterator temp{ *this };
+                temp -= count;
+                return temp;
+            }
 
-                return res;
+            [[nodiscard]] constexpr const reference operator*() const noexcept
+            {
+                return data_[*gen_];
             }
 
-            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
-            [[nodiscard]] auto transform(const ArCo& arr, Binary_op&& op) const
+            [[nodiscard]] constexpr bool operator==(const arrnd_const_iterator& iter) const
             {
-                using U = decltype(op(data()[0], arr.data()[0]));
+                return *gen_ == *(iter.gen_);
+            }
 
-                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
-                    return replaced_type<U>();
-                }
+        private:
+            indexer_type gen_;
+            pointer data_ = nullptr;
+        };
 
-                replaced_type<U> res(std::span<const std::int64_t>(header().dims().data(), header().dims().size()));
 
-                indexer_type gen(header());
-                typename replaced_type<U>::indexer_type arr_gen(arr.header());
 
-                for (; gen && arr_gen; ++gen, ++arr_gen) {
-                    res[*gen] = op((*this)[*gen], arr[*arr_gen]);
-                }
+        template <typename T, typename Indexer = arrnd_general_indexer<>>
+        class arrnd_reverse_iterator final
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::int64_t;
+            using value_type = T;
+            using pointer = T*;
+            using reference = T&;
 
-                return res;
-            }
+            using indexer_type = Indexer;
 
-            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
-            [[nodiscard]] auto transform(const V& value, Binary_op&& op) const
+            constexpr arrnd_reverse_iterator(pointer data, const indexer_type& gen)
+                : gen_(gen), data_(data)
             {
-                using U = decltype(op(data()[0], value));
+            }
 
-                replaced_type<U> res(std::span<const std::int64_t>(header().dims().data(), header().dims().size()));
+            constexpr arrnd_reverse_iterator() = default;
 
-                for (indexer_type gen(header()); gen; ++gen) {
-                    res[*gen] = op((*this)[*gen], value);
-                }
+            constexpr arrnd_reverse_iterator(const arrnd_reverse_iterator& other) = default;
+            constexpr arrnd_reverse_iterator& operator=(const arrnd_reverse_iterator& other) = default;
 
-                return res;
-            }
+            constexpr arrnd_reverse_iterator(arrnd_reverse_iterator&& other) noexcept = default;
+            constexpr arrnd_reverse_iterator& operator=(arrnd_reverse_iterator&& other) noexcept = default;
 
+            constexpr ~arrnd_reverse_iterator() = default;
 
-            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
-            auto& apply(Unary_op&& op)
+            constexpr arrnd_reverse_iterator& operator++() noexcept
             {
-                if (empty(*this)) {
-                    return *this;
-                }
-
-                for (indexer_type gen(header()); gen; ++gen) {
-                    (*this)[*gen] = op((*this)[*gen]);
-                }
-
+                --gen_;
                 return *this;
             }
 
-            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
-            auto& apply(const ArCo& arr, Binary_op&& op)
+            constexpr arrnd_reverse_iterator operator++(int) noexcept
             {
-                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
-                    return *this;
-                }
+                arrnd_reverse_iterator temp{ *this };
+                --(*this);
+                return temp;
+            }
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type arr_gen(arr.header());
+            constexpr arrnd_reverse_iterator& operator+=(difference_type count) noexcept
+            {
+                gen_ -= count;
+                return *this;
+            }
 
-                for (; gen && arr_gen; ++gen, ++arr_gen) {
-                    (*this)[*gen] = op((*this)[*gen], arr[*arr_gen]);
-                }
+            constexpr arrnd_reverse_iterator operator+(difference_type count) noexcept
+            {
+                arrnd_reverse_iterator temp{ *this };
+                temp += count;
+                return temp;
+            }
 
+            constexpr arrnd_reverse_iterator& operator--() noexcept
+            {
+                ++gen_;
                 return *this;
             }
 
-            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
-            auto& apply(const V& value, Binary_op&& op)
+            constexpr arrnd_reverse_iterator operator--(int) noexcept
             {
-                for (indexer_type gen(header()); gen; ++gen) {
-                    (*this)[*gen] = op((*this)[*gen], value);
-                }
+                arrnd_reverse_iterator temp{ *this };
+                ++(*this);
+                return temp;
+            }
 
+            constexpr arrnd_reverse_iterator& operator-=(difference_type count) noexcept
+            {
+                gen_ += count;
                 return *this;
             }
 
+            constexpr arrnd_reverse_iterator operator-(difference_type count) noexcept
+            {
+                arrnd_reverse_iterator temp{ *this };
+                temp -= count;
+                return temp;
+            }
 
+            [[nodiscard]] constexpr reference operator*() const noexcept
+            {
+                return data_[*gen_];
+            }
 
-            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
-            [[nodiscard]] auto reduce(Binary_op&& op) const
+            [[nodiscard]] constexpr bool operator==(const arrnd_reverse_iterator& iter) const
             {
-                using U = decltype(op(data()[0], data()[0]));
+                return *gen_ == *(iter.gen_);
+            }
 
-                if (empty(*this)) {
-                    return U{};
-                }
+        private:
+            indexer_type gen_;
+            pointer data_ = nullptr;
+        };
 
-                indexer_type gen{ header() };
 
-                U res{ static_cast<U>((*this)[*gen]) };
-                ++gen;
 
-                while (gen) {
-                    res = op(res, (*this)[*gen]);
-                    ++gen;
-                }
 
-                return res;
-            }
+        template <typename T, typename Indexer = arrnd_general_indexer<>>
+        class arrnd_const_reverse_iterator final
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using difference_type = std::int64_t;
+            using value_type = T;
+            using pointer = T*;
+            using reference = T&;
 
-            template <typename U, typename Binary_op> requires std::is_invocable_v<Binary_op, U, T>
-            [[nodiscard]] auto reduce(const U& init_value, Binary_op&& op) const
+            using indexer_type = Indexer;
+
+            constexpr arrnd_const_reverse_iterator(pointer data, const indexer_type& gen)
+                : gen_(gen), data_(data)
             {
-                if (empty(*this)) {
-                    return init_value;
-                }
+            }
 
-                U res{ init_value };
-                for (indexer_type gen{ header() }; gen; ++gen) {
-                    res = op(res, (*this)[*gen]);
-                }
+            constexpr arrnd_const_reverse_iterator() = default;
 
-                return res;
-            }
+            constexpr arrnd_const_reverse_iterator(const arrnd_const_reverse_iterator& other) = default;
+            constexpr arrnd_const_reverse_iterator& operator=(const arrnd_const_reverse_iterator& other) = default;
 
-            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
-            [[nodiscard]] auto reduce(Binary_op&& op, std::int64_t axis) const
+            constexpr arrnd_const_reverse_iterator(arrnd_const_reverse_iterator&& other) noexcept = default;
+            constexpr arrnd_const_reverse_iterator& operator=(arrnd_const_reverse_iterator&& other) noexcept = default;
+
+            constexpr ~arrnd_const_reverse_iterator() = default;
+
+            constexpr arrnd_const_reverse_iterator& operator++() noexcept
             {
-                using U = decltype(op(data()[0], data()[0]));
+                --gen_;
+                return *this;
+            }
 
-                if (empty(*this)) {
-                    return replaced_type<U>();
-                }
+            constexpr arrnd_const_reverse_iterator operator++(int) noexcept
+            {
+                arrnd_const_reverse_iterator temp{ *this };
+                --(*this);
+                return temp;
+            }
 
-                const std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+            constexpr arrnd_const_reverse_iterator& operator+=(difference_type count) noexcept
+            {
+                gen_ -= count;
+                return *this;
+            }
 
-                typename replaced_type<U>::header_type new_header(header(), fixed_axis);
-                if (new_header.empty()) {
-                    return replaced_type<U>();
-                }
+            constexpr arrnd_const_reverse_iterator operator+(difference_type count) noexcept
+            {
+                arrnd_const_reverse_iterator temp{ *this };
+                temp += count;
+                return temp;
+            }
 
-                replaced_type<U> res({ new_header.count() });
-                res.header() = std::move(new_header);
+            constexpr arrnd_const_reverse_iterator& operator--() noexcept
+            {
+                ++gen_;
+                return *this;
+            }
 
-                indexer_type gen(header(), std::ssize(header().dims()) - fixed_axis - 1);
-                indexer_type res_gen(res.header());
+            constexpr arrnd_const_reverse_iterator operator--(int) noexcept
+            {
+                arrnd_const_reverse_iterator temp{ *this };
+                ++(*this);
+                return temp;
+            }
 
-                const std::int64_t reduction_iteration_cycle{ header().dims()[fixed_axis] };
+            constexpr arrnd_const_reverse_iterator& operator-=(difference_type count) noexcept
+            {
+                gen_ += count;
+                return *this;
+            }
 
-                while (gen && res_gen) {
-                    U res_element{ static_cast<U>((*this)[*gen]) };
-                    ++gen;
-                    for (std::int64_t i = 0; i < reduction_iteration_cycle - 1; ++i, ++gen) {
-                        res_element = op(res_element, (*this)[*gen]);
-                    }
-                    res[*res_gen] = res_element;
-                    ++res_gen;
-                }
+            constexpr arrnd_const_reverse_iterator operator-(difference_type count) noexcept
+            {
+                arrnd_const_reverse_iterator temp{ *this };
+                temp -= count;
+                return temp;
+            }
 
-                return res;
+            [[nodiscard]] constexpr const reference operator*() const noexcept
+            {
+                return data_[*gen_];
             }
 
-            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, T>
-            [[nodiscard]] auto reduce(const ArCo& init_values, Binary_op&& op, std::int64_t axis) const
+            [[nodiscard]] constexpr bool operator==(const arrnd_const_reverse_iterator& iter) const
             {
-                using U = decltype(op(init_values.data()[0], data()[0]));
+                return *gen_ == *(iter.gen_);
+            }
 
-                if (empty(*this)) {
-                    return replaced_type<U>();
-                }
+        private:
+            indexer_type gen_;
+            pointer data_ = nullptr;
+        };
 
-                const std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
 
-                if (init_values.header().dims().size() != 1 && init_values.header().dims()[fixed_axis] != header().dims()[fixed_axis]) {
-                    return replaced_type<U>();
-                }
+        /**
+        * @note Shared reference of a T allocated together with its reference count (i.e. a single allocation without a control block or a weak count).
+        * Count is either an integer (non-atomic, for references used by a single thread) or an atomic integer.
+        */
+        template <typename T, typename Count, template<typename> typename Allocator = lightweight_allocator>
+        class intrusive_shared_ref final {
+        public:
+            using element_type = T;
 
-                typename replaced_type<U>::header_type new_header(header(), axis);
-                if (new_header.empty()) {
-                    return replaced_type<U>();
+            constexpr intrusive_shared_ref() noexcept = default;
+            constexpr intrusive_shared_ref(std::nullptr_t) noexcept {}
+
+            template <typename... Args>
+            [[nodiscard]] static intrusive_shared_ref make(Args&&... args)
+            {
+                block_allocator_type alloc{};
+                block* b{ alloc.allocate(1) };
+                try {
+                    std::construct_at(b, std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    alloc.deallocate(b, 1);
+                    throw;
                 }
 
-                replaced_type<U> res({ new_header.count() });
-                res.header() = std::move(new_header);
+                intrusive_shared_ref ref{};
+                ref.block_ = b;
+                return ref;
+            }
 
-                indexer_type gen(header(), std::ssize(header().dims()) - fixed_axis - 1);
-                indexer_type res_gen(res.header());
-                typename ArCo::indexer_type init_gen(init_values.header());
+            intrusive_shared_ref(const intrusive_shared_ref& other) noexcept
+                : block_(other.block_)
+            {
+                retain();
+            }
 
-                const std::int64_t reduction_iteration_cycle{ header().dims()[fixed_axis] };
+            intrusive_shared_ref(intrusive_shared_ref&& other) noexcept
+                : block_(std::exchange(other.block_, nullptr))
+            {
+            }
 
-                while (gen && res_gen && init_gen) {
-                    U res_element{ init_values[*init_gen] };
-                    for (std::int64_t i = 0; i < reduction_iteration_cycle; ++i, ++gen) {
-                        res_element = op(res_element, (*this)[*gen]);
-                    }
-                    res[*res_gen] = std::move(res_element);
-                    ++res_gen;
-                    ++init_gen;
-                }
+            intrusive_shared_ref& operator=(const intrusive_shared_ref& other) noexcept
+            {
+                intrusive_shared_ref(other).swap(*this);
+                return *this;
+            }
 
-                return res;
+            intrusive_shared_ref& operator=(intrusive_shared_ref&& other) noexcept
+            {
+                intrusive_shared_ref(std::move(other)).swap(*this);
+                return *this;
             }
 
+            ~intrusive_shared_ref() noexcept
+            {
+                release();
+            }
 
-            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
-            [[nodiscard]] auto filter(Unary_pred pred) const
+            void swap(intrusive_shared_ref& other) noexcept
             {
-                if (empty(*this)) {
-                    return this_type();
-                }
+                std::swap(block_, other.block_);
+            }
 
-                this_type res({ header().count() });
+            [[nodiscard]] T* get() const noexcept
+            {
+                return block_ ? &block_->value : nullptr;
+            }
 
-                indexer_type gen(header());
-                indexer_type res_gen(res.header());
+            [[nodiscard]] T* operator->() const noexcept
+            {
+                return &block_->value;
+            }
 
-                std::int64_t res_count{ 0 };
+            [[nodiscard]] T& operator*() const noexcept
+            {
+                return block_->value;
+            }
 
-                while (gen && res_gen) {
-                    if (pred((*this)[*gen])) {
-                        res[*res_gen] = (*this)[*gen];
-                        ++res_count;
-                        ++res_gen;
-                    }
-                    ++gen;
-                }
+            [[nodiscard]] explicit operator bool() const noexcept
+            {
+                return block_ != nullptr;
+            }
 
-                if (res_count == 0) {
-                    return this_type();
+            [[nodiscard]] std::int64_t use_count() const noexcept
+            {
+                if (!block_) {
+                    return 0;
+                }
+                if constexpr (std::is_integral_v<Count>) {
+                    return block_->count;
+                }
+                else {
+                    return block_->count.load(std::memory_order_relaxed);
                 }
+            }
 
-                if (res_count < header().count()) {
-                    return res.resize({ res_count });
+        private:
+            struct block {
+                template <typename... Args>
+                block(Args&&... args)
+                    : value(std::forward<Args>(args)...)
+                {
                 }
 
-                return res;
-            }
+                Count count{ 1 };
+                T value;
+            };
+            using block_allocator_type = Allocator<block>;
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto filter(const ArCo& mask) const
+            void retain() noexcept
             {
-                if (empty(*this)) {
-                    return this_type();
+                if (!block_) {
+                    return;
                 }
+                if constexpr (std::is_integral_v<Count>) {
+                    ++block_->count;
+                }
+                else {
+                    block_->count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
 
-                if (!std::equal(header().dims().begin(), header().dims().end(), mask.header().dims().begin(), mask.header().dims().end())) {
-                    return this_type();
+            void release() noexcept
+            {
+                block* b{ std::exchange(block_, nullptr) };
+                if (!b) {
+                    return;
                 }
+                bool last{ false };
+                if constexpr (std::is_integral_v<Count>) {
+                    last = --b->count == 0;
+                }
+                else {
+                    last = b->count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+                }
+                if (last) {
+                    dispose(b);
+                }
+            }
 
-                this_type res({ header().count() });
+            // out of line, so that the (rare) deallocation is not inlined into every copy and destruction of a reference
+            [[gnu::noinline]] static void dispose(block* b) noexcept
+            {
+                block_allocator_type alloc{};
+                std::destroy_at(b);
+                alloc.deallocate(b, 1);
+            }
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type mask_gen(mask.header());
+            block* block_{ nullptr };
+        };
 
-                indexer_type res_gen(res.header());
+        /**
+        * @note Reference count policies of the arrnd buffer, i.e. the type of its shared reference and how it is created.
+        * atomic_ref_count (std::shared_ptr) is the default. non_atomic_ref_count is for arrays (and their copies and slices) used by a single thread,
+        * and parallel algorithms and async operations process such arrays (and arrays of their elements) serially on the calling thread where they would copy them.
+        * intrusive_ref_count keeps an atomic count within the buffer allocation.
+        */
+        struct atomic_ref_count {
+            static constexpr bool is_thread_safe{ true };
 
-                std::int64_t res_count{ 0 };
+            template <typename T, template<typename> typename Allocator>
+            using shared_ref_type = std::shared_ptr<T>;
 
-                while (gen && mask_gen && res_gen) {
-                    if (mask[*mask_gen]) {
-                        res[*res_gen] = (*this)[*gen];
-                        ++res_count;
-                        ++res_gen;
-                    }
-                    ++gen;
-                    ++mask_gen;
-                }
+            template <typename T, template<typename> typename Allocator, typename... Args>
+            [[nodiscard]] static shared_ref_type<T, Allocator> make_shared_ref(Args&&... args)
+            {
+                return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+            }
+        };
 
-                if (res_count == 0) {
-                    return this_type();
-                }
+        struct non_atomic_ref_count {
+            static constexpr bool is_thread_safe{ false };
 
-                if (res_count < header().count()) {
-                    return res.resize({ res_count });
-                }
+            template <typename T, template<typename> typename Allocator>
+            using shared_ref_type = intrusive_shared_ref<T, std::int64_t, Allocator>;
 
-                return res;
+            template <typename T, template<typename> typename Allocator, typename... Args>
+            [[nodiscard]] static shared_ref_type<T, Allocator> make_shared_ref(Args&&... args)
+            {
+                return shared_ref_type<T, Allocator>::make(std::forward<Args>(args)...);
             }
+        };
 
-            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
-            [[nodiscard]] auto find(Unary_pred pred) const
-            {
-                if (empty(*this)) {
-                    return replaced_type<std::int64_t>();
-                }
+        struct intrusive_ref_count {
+            static constexpr bool is_thread_safe{ true };
 
-                replaced_type<std::int64_t> res({ header().count() });
+            template <typename T, template<typename> typename Allocator>
+            using shared_ref_type = intrusive_shared_ref<T, std::atomic<std::int64_t>, Allocator>;
 
-                indexer_type gen(header());
-                typename replaced_type<std::int64_t>::indexer_type res_gen(res.header());
+            template <typename T, template<typename> typename Allocator, typename... Args>
+            [[nodiscard]] static shared_ref_type<T, Allocator> make_shared_ref(Args&&... args)
+            {
+                return shared_ref_type<T, Allocator>::make(std::forward<Args>(args)...);
+            }
+        };
 
-                std::int64_t res_count{ 0 };
+        template <arrnd_complient T>
+        inline constexpr bool is_concurrently_copyable_v<T>{ T::ref_count_policy_type::is_thread_safe && is_concurrently_copyable_v<typename T::value_type> };
 
-                while (gen && res_gen) {
-                    if (pred((*this)[*gen])) {
-                        res[*res_gen] = *gen;
-                        ++res_count;
-                        ++res_gen;
-                    }
-                    ++gen;
+        /**
+        * @note Range of the slices of an array along an axis (i.e. the subarrays of a single index of the axis).
+        * The iterator reuses a single slice, whose header is shifted to the next slice, so that bind it by reference to avoid copies.
+        */
+        template <typename Array>
+        class arrnd_slices final {
+        public:
+            class iterator final {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = Array;
+                using difference_type = std::int64_t;
+                using reference = Array&;
+                using pointer = Array*;
+
+                iterator() = default;
+
+                iterator(Array slice, std::int64_t index, std::int64_t stride)
+                    : slice_(std::move(slice)), index_(index), stride_(stride)
+                {
                 }
 
-                if (res_count == 0) {
-                    return replaced_type<std::int64_t>();
+                [[nodiscard]] reference operator*() const noexcept
+                {
+                    return slice_;
                 }
 
-                if (res_count < header().count()) {
-                    return res.resize({ res_count });
+                [[nodiscard]] pointer operator->() const noexcept
+                {
+                    return &slice_;
                 }
 
-                return res;
-            }
+                iterator& operator++() noexcept
+                {
+                    ++index_;
+                    slice_.header().shift(stride_);
+                    return *this;
+                }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] auto find(const ArCo& mask) const
+                iterator operator++(int) noexcept
+                {
+                    iterator temp{ *this };
+                    ++(*this);
+                    return temp;
+                }
+
+                [[nodiscard]] bool operator==(const iterator& other) const noexcept
+                {
+                    return index_ == other.index_;
+                }
+
+                [[nodiscard]] std::int64_t index() const noexcept
+                {
+                    return index_;
+                }
+
+            private:
+                mutable Array slice_{};
+                std::int64_t index_{ 0 };
+                std::int64_t stride_{ 0 };
+            };
+
+            arrnd_slices(const Array& arr, std::int64_t axis)
             {
-                if (empty(*this)) {
-                    return replaced_type<std::int64_t>();
+                if (arr.header().empty()) {
+                    return;
                 }
 
-                if (!std::equal(header().dims().begin(), header().dims().end(), mask.header().dims().begin(), mask.header().dims().end())) {
-                    return replaced_type<std::int64_t>();
+                const std::int64_t ndims{ std::ssize(arr.header().dims()) };
+                axis_ = modulo(axis, ndims);
+                size_ = arr.header().dims()[axis_];
+                stride_ = arr.header().strides()[axis_];
+
+                std::vector<Interval<std::int64_t>> ranges(ndims);
+                for (std::int64_t i = 0; i < ndims; ++i) {
+                    ranges[i] = Interval<std::int64_t>{ 0, i == axis_ ? 0 : arr.header().dims()[i] - 1 };
                 }
+                first_ = arr[std::span<const Interval<std::int64_t>>(ranges.data(), ranges.size())];
+            }
 
-                replaced_type<std::int64_t> res({ header().count() });
+            [[nodiscard]] iterator begin() const
+            {
+                return iterator(first_, 0, stride_);
+            }
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type mask_gen(mask.header());
+            [[nodiscard]] iterator end() const
+            {
+                return iterator(Array{}, size_, stride_);
+            }
 
-                typename replaced_type<std::int64_t>::indexer_type res_gen(res.header());
+            [[nodiscard]] std::int64_t size() const noexcept
+            {
+                return size_;
+            }
 
-                std::int64_t res_count{ 0 };
+            /**
+            * @return Buffer distance between consecutive slices.
+            */
+            [[nodiscard]] std::int64_t stride() const noexcept
+            {
+                return stride_;
+            }
 
-                while (gen && mask_gen && res_gen) {
-                    if (mask[*mask_gen]) {
-                        res[*res_gen] = *gen;
-                        ++res_count;
-                        ++res_gen;
-                    }
-                    ++gen;
-                    ++mask_gen;
+            /**
+            * @return Slice of index i, i.e. the first slice shifted i times.
+            */
+            [[nodiscard]] Array slice(std::int64_t i) const
+            {
+                Array slice{ first_ };
+                slice.header().shift(i * stride_);
+                return slice;
+            }
+
+        private:
+            Array first_{};
+            std::int64_t axis_{ 0 };
+            std::int64_t size_{ 0 };
+            std::int64_t stride_{ 0 };
+        };
+
+        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator, typename Header = arrnd_header<>, typename Indexer = arrnd_general_indexer<>, typename RefCountPolicy = atomic_ref_count>
+        class arrnd {
+        public:
+            using value_type = T;
+            using size_type = std::int64_t;
+            using difference_type = std::int64_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+
+            using iterator = arrnd_iterator<T, Indexer>;
+            using const_iterator = arrnd_const_iterator<T, Indexer>;
+            using reverse_iterator = arrnd_reverse_iterator<T, Indexer>;
+            using const_reverse_iterator = arrnd_const_reverse_iterator<T, Indexer>;
+
+            using tag = arrnd_tag;
+
+            using storage_type = Storage;
+            template <typename U>
+            using shared_ref_allocator_type = SharedRefAllocator<U>;
+            using header_type = Header;
+            using indexer_type = Indexer;
+            using ref_count_policy_type = RefCountPolicy;
+            using shared_ref_type = typename RefCountPolicy::template shared_ref_type<storage_type, SharedRefAllocator>;
+
+            using this_type = arrnd<T, Storage, SharedRefAllocator, Header, Indexer, RefCountPolicy>;
+            template <typename U>
+            using replaced_type = arrnd<U, typename Storage::template replaced_type<U>, SharedRefAllocator, Header, Indexer, RefCountPolicy>;
+
+            arrnd() = default;
+
+            arrnd(arrnd&& other) = default;
+            template<arrnd_complient ArCo>
+            arrnd(ArCo&& other)
+                : arrnd(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()))
+            {
+                copy(other, *this);
+
+                ArCo dummy{ std::move(other) };
+            }
+            arrnd& operator=(arrnd&& other) & = default;
+            arrnd& operator=(arrnd&& other)&&
+            {
+                if (&other == this) {
+                    return *this;
                 }
 
-                if (res_count == 0) {
-                    return replaced_type<std::int64_t>();
+                copy(other, *this);
+                arrnd dummy{ std::move(other) };
+                return *this;
+            }
+            template<arrnd_complient ArCo>
+            arrnd& operator=(ArCo&& other)&
+            {
+                *this = this_type(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()));
+                copy(other, *this);
+                ArCo dummy{ std::move(other) };
+                return *this;
+            }
+            template<arrnd_complient ArCo>
+            arrnd& operator=(ArCo&& other)&&
+            {
+                copy(other, *this);
+                ArCo dummy{ std::move(other) };
+                return *this;
+            }
+
+            arrnd(const arrnd& other) = default;
+            template<arrnd_complient ArCo>
+            arrnd(const ArCo& other)
+                : arrnd(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()))
+            {
+                copy(other, *this);
+            }
+            arrnd& operator=(const arrnd& other) & = default;
+            arrnd& operator=(const arrnd& other)&&
+            {
+                if (&other == this) {
+                    return *this;
                 }
 
-                if (res_count < header().count()) {
-                    return res.resize({ res_count });
+                copy(other, *this);
+                return *this;
+            }
+            template<arrnd_complient ArCo>
+            arrnd& operator=(const ArCo& other)&
+            {
+                *this = this_type(std::span<const std::int64_t>(other.header().dims().data(), other.header().dims().size()));
+                copy(other, *this);
+                return *this;
+            }
+            template<arrnd_complient ArCo>
+            arrnd& operator=(const ArCo& other)&&
+            {
+                copy(other, *this);
+                return *this;
+            }
+
+            template <typename U>
+            arrnd& operator=(const U& value)
+            {
+                if (empty(*this)) {
+                    return *this;
                 }
 
-                return res;
+                for_each_run([&value](pointer first, std::int64_t length, std::int64_t stride) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        first[i * stride] = value;
+                    }
+                });
+
+                return *this;
             }
 
+            virtual ~arrnd() = default;
 
-            [[nodiscard]] auto transpose(std::span<const std::int64_t> order) const
+            explicit arrnd(std::span<const std::int64_t> dims, const_pointer data = nullptr)
+                : hdr_(dims), buffsp_(make_shared_buffer(hdr_.count()))
             {
-                if (empty(*this)) {
-                    return this_type();
+                if (data) {
+                    parallel_copy_n(data, hdr_.count(), buffsp_->data());
+                }
+            }
+            explicit arrnd(std::span<const std::int64_t> dims, std::initializer_list<value_type> data)
+                : arrnd(dims, data.begin())
+            {
+            }
+            explicit arrnd(std::initializer_list<std::int64_t> dims, const_pointer data = nullptr)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data)
+            {
+            }
+            explicit arrnd(std::initializer_list<std::int64_t> dims, std::initializer_list<value_type> data)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data.begin())
+            {
+            }
+
+            /**
+            * @note data is copied as is, and its elements are ordered by layout (e.g. column major data from a Fortran library).
+            */
+            explicit arrnd(std::span<const std::int64_t> dims, arrnd_layout layout, const_pointer data = nullptr)
+                : hdr_(dims, layout), buffsp_(make_shared_buffer(hdr_.count()))
+            {
+                if (data) {
+                    parallel_copy_n(data, hdr_.count(), buffsp_->data());
                 }
+            }
+            explicit arrnd(std::initializer_list<std::int64_t> dims, arrnd_layout layout, const_pointer data = nullptr)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, layout, data)
+            {
+            }
+            explicit arrnd(std::initializer_list<std::int64_t> dims, arrnd_layout layout, std::initializer_list<value_type> data)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, layout, data.begin())
+            {
+            }
 
-                header_type new_header(header(), order);
-                if (new_header.empty()) {
-                    return this_type();
+            /**
+            * @note Arbitrary (non zero) strides. The buffer size is the one that is required by the strides (i.e. last index + 1),
+            * and data (if not null) is copied as is and should be of that size. With negative strides the first element is not at the buffer start.
+            */
+            explicit arrnd(std::span<const std::int64_t> dims, std::span<const std::int64_t> strides, const_pointer data = nullptr)
+                : hdr_(dims, strides, compute_origin_offset(dims, strides)), buffsp_(hdr_.empty() ? nullptr : make_shared_buffer(hdr_.last_index() + 1))
+            {
+                if (data && buffsp_) {
+                    parallel_copy_n(data, buffsp_->size(), buffsp_->data());
                 }
+            }
+            template <typename U>
+            explicit arrnd(std::span<const std::int64_t> dims, const U* data = nullptr)
+                : hdr_(dims), buffsp_(make_shared_buffer(hdr_.count()))
+            {
+                parallel_copy_n(data, hdr_.count(), buffsp_->data());
+            }
+            template <typename U>
+            explicit arrnd(std::span<const std::int64_t> dims, std::initializer_list<U> data)
+                : arrnd(dims, data.begin())
+            {
+            }
+            template <typename U>
+            explicit arrnd(std::initializer_list<std::int64_t> dims, const U* data = nullptr)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data)
+            {
+            }
+            template <typename U>
+            explicit arrnd(std::initializer_list<std::int64_t> dims, std::initializer_list<U> data = nullptr)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, data.begin())
+            {
+            }
 
-                this_type res({ header().count() });
-                res.header() = std::move(new_header);
 
-                indexer_type gen(header(), order);
-                indexer_type res_gen(res.header());
+            explicit arrnd(std::span<const std::int64_t> dims, const_reference value)
+                : hdr_(dims), buffsp_(make_shared_buffer(hdr_.count()))
+            {
+                parallel_fill_n(buffsp_->data(), buffsp_->size(), value);
+            }
+            explicit arrnd(std::initializer_list<std::int64_t> dims, const_reference value)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, value)
+            {
+            }
+            template <typename U>
+            explicit arrnd(std::span<const std::int64_t> dims, const U& value)
+                : hdr_(dims), buffsp_(make_shared_buffer(hdr_.count()))
+            {
+                parallel_fill_n(buffsp_->data(), buffsp_->size(), value);
+            }
+            template <typename U>
+            explicit arrnd(std::initializer_list<std::int64_t> dims, const U& value)
+                : arrnd(std::span<const std::int64_t>{dims.begin(), dims.size()}, value)
+            {
+            }
+
+            [[nodiscard]] const header_type& header() const noexcept
+            {
+                return hdr_;
+            }
+
+            [[nodiscard]] header_type& header() noexcept
+            {
+                return hdr_;
+            }
+
+            [[nodiscard]] pointer data() const noexcept
+            {
+                return buffsp_ ? buffsp_->data() : nullptr;
+            }
+
+            /**
+            * @return True if no other array refers to the buffer, i.e. it can be modified in place without affecting other arrays.
+            */
+            [[nodiscard]] bool is_unique() const noexcept
+            {
+                return buffsp_ && buffsp_.use_count() == 1;
+            }
+
+            [[nodiscard]] const_reference operator[](std::int64_t index) const noexcept
+            {
+                return buffsp_->data()[modulo(index, hdr_.last_index() + 1)];
+            }
+            [[nodiscard]] reference operator[](std::int64_t index) noexcept
+            {
+                return buffsp_->data()[modulo(index, hdr_.last_index() + 1)];
+            }
+
+            [[nodiscard]] const_reference operator[](std::span<std::int64_t> subs) const noexcept
+            {
+                return buffsp_->data()[subs2ind(hdr_.offset(), hdr_.strides(), hdr_.dims(), subs)];
+            }
+            [[nodiscard]] const_reference operator[](std::initializer_list<std::int64_t> subs) const noexcept
+            {
+                return (*this)[std::span<std::int64_t>{ const_cast<std::int64_t*>(subs.begin()), subs.size() }];
+            }
+
+            [[nodiscard]] reference operator[](std::span<std::int64_t> subs) noexcept
+            {
+                return buffsp_->data()[subs2ind(hdr_.offset(), hdr_.strides(), hdr_.dims(), subs)];
+            }
+            [[nodiscard]] reference operator[](std::initializer_list<std::int64_t> subs) noexcept
+            {
+                return (*this)[std::span<std::int64_t>{ const_cast<std::int64_t*>(subs.begin()), subs.size() }];
+            }
+
+            [[nodiscard]] arrnd operator[](std::span<const Interval<std::int64_t>> ranges) const
+            {
+                if (ranges.empty() || empty(*this)) {
+                    return (*this);
+                }
+
+                this_type slice{};
+                slice.hdr_ = header_type{ hdr_, ranges };
+                slice.buffsp_ = slice.hdr_.empty() ? nullptr : buffsp_;
+                return slice;
+            }
+            [[nodiscard]] arrnd operator[](std::initializer_list<Interval<std::int64_t>> ranges) const
+            {
+                return (*this)[std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()}];
+            }
+
+            template <arrnd_complient ArCo> requires std::is_integral_v<typename ArCo::value_type>
+            [[nodiscard]] arrnd operator[](const ArCo& indices) const noexcept
+            {
+                this_type res(std::span<const std::int64_t>(indices.header().dims().data(), indices.header().dims().size()));
+
+                indexer_type res_gen(res.header());
+                typename ArCo::indexer_type ind_gen(indices.header());
+
+                for (; res_gen && ind_gen; ++res_gen, ++ind_gen) {
+                    res[*res_gen] = (*this)[indices[*ind_gen]];
+                }
+
+                return res;
+            }
+
+            /**
+            * @note copy this array to dst partially or full depending on the arrays size
+            */
+            template <arrnd_complient ArCo>
+            const arrnd& copy_to(ArCo& dst) const
+            {
+                if (empty(*this) || empty(dst)) {
+                    return *this;
+                }
+
+                // same dimensions, both arrays are traversed by their joint runs
+                if (std::equal(header().dims().begin(), header().dims().end(), dst.header().dims().begin(), dst.header().dims().end())) {
+                    const_pointer src{ data() };
+                    auto* dst_data{ dst.data() };
+                    for_each_joint_run([&](const auto& indices, std::int64_t length, const auto& strides) {
+                        copy_run(src + indices[0], strides[0], length, dst_data + indices[1], strides[1]);
+                    }, header(), dst.header());
+                    return *this;
+                }
+
+                // dst buffer is linear in iteration order, copy the runs of this array until either of them ends
+                if (dst.header().is_contiguous()) {
+                    auto* dst_data{ dst.data() + dst.header().offset() };
+                    std::int64_t remaining{ dst.header().count() };
+                    for_each_run([&dst_data, &remaining](const_pointer first, std::int64_t length, std::int64_t stride) {
+                        const std::int64_t n{ std::min(length, remaining) };
+                        copy_run(first, stride, n, dst_data, 1);
+                        dst_data += n;
+                        remaining -= n;
+                    });
+                    return *this;
+                }
+
+                indexer_type gen(header());
+                typename ArCo::indexer_type dst_gen(dst.header());
+
+                for (; gen && dst_gen; ++gen, ++dst_gen) {
+                    dst[*dst_gen] = (*this)[*gen];
+                }
+                
+                return *this;
+            }
+
+            template <arrnd_complient ArCo1, arrnd_complient ArCo2> requires std::is_integral_v<typename ArCo2::value_type>
+            const arrnd& copy_to(ArCo1& dst, const ArCo2& indices) const
+            {
+                if (empty(*this) || empty(dst) || empty(indices)) {
+                    return *this;
+                }
+
+                indexer_type gen(header());
+                typename ArCo2::indexer_type ind_gen(indices.header());
+
+                for (;gen && ind_gen; ++gen, ++ind_gen) {
+                    dst[indices[*ind_gen]] = (*this)[*gen];
+                }
+
+                return *this;
+            }
+
+            template <arrnd_complient ArCo>
+            const arrnd& copy_to(ArCo& dst, std::span<const Interval<std::int64_t>> ranges) const
+            {
+                auto slice = dst[ranges];
+                copy_to(slice);
+                return *this;
+            }
+            template <arrnd_complient ArCo>
+            const arrnd& copy_to(ArCo& dst, std::initializer_list<Interval<std::int64_t>> ranges) const
+            {
+                return copy_to(dst, std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()});
+            }
+
+            /**
+            * @note if buffer reallocation not required use copy_to function
+            */
+            template <arrnd_complient ArCo>
+            const arrnd& set_to(ArCo& dst) const
+            {
+                if (empty(*this)) {
+                    dst = ArCo{};
+                    return *this;
+                }
+
+                if (empty(dst)) {
+                    dst = ArCo{ header().dims() };
+                    return copy_to(dst);
+                }
+
+                if (header().count() == dst.header().count()) {
+                    if (header().dims() != dst.header().dims()) {
+                        dst.header() = header_type{ header().dims() };
+                    }
+                    return copy_to(dst);
+                }
+
+                dst = ArCo{ header().dims() };
+                return copy_to(dst);
+            }
+
+            template <arrnd_complient ArCo>
+            arrnd& copy_from(const ArCo& src)
+            {
+                src.copy_to(*this);
+                return *this;
+            }
+
+            template <arrnd_complient ArCo1, arrnd_complient ArCo2> requires std::is_integral_v<typename ArCo2::value_type>
+            arrnd& copy_from(const ArCo1& src, const ArCo2& indices)
+            {
+                src.copy_to(*this, indices);
+                return *this;
+            }
+
+            template <arrnd_complient ArCo>
+            arrnd& copy_from(const ArCo& src, std::span<const Interval<std::int64_t>> ranges)
+            {
+                src.copy_to(*this, ranges);
+                return *this;
+            }
+            template <arrnd_complient ArCo>
+            arrnd& copy_from(const ArCo& src, std::initializer_list<Interval<std::int64_t>> ranges)
+            {
+                return copy_from(src, std::span<const Interval<std::int64_t>>{ranges.begin(), ranges.size()});
+            }
+
+            template <arrnd_complient ArCo>
+            arrnd& set_from(const ArCo& src)
+            {
+                src.set_to(*this);
+                return *this;
+            }
+
+            /**
+            * @note Calls func(first, length, stride) for each run of elements in iteration order, where the run elements are first[i * stride] for i in [0, length).
+            * Runs are as long as the layout allows (e.g. a single run for contiguous arrays), so that func can process them by its own (e.g. vectorized) kernel.
+            */
+            template <typename Func>
+            void for_each_run(Func&& func) const
+            {
+                if (empty(*this)) {
+                    return;
+                }
+
+                details::for_each_run(header(), [this, &func](std::int64_t index, std::int64_t length, std::int64_t stride) {
+                    func(data() + index, length, stride);
+                });
+            }
+
+            /**
+            * @note Fills the array with uniform values in [low, high) for floating point elements, or in [low, high] for integral elements,
+            * of a counter-based generator, i.e. the value of each element depends only on the seed and its position in iteration order
+            * (and not on the number of threads). Arrays are filled by partitions on the current thread pool.
+            */
+            auto& fill_random_uniform(const T& low, const T& high, std::uint64_t seed)
+            {
+                const philox_generator gen(seed);
+                if constexpr (std::is_integral_v<T>) {
+                    return fill_by_position([gen, low, high](std::int64_t position) {
+                        return uniform_integer<T>(gen(static_cast<std::uint64_t>(position)), low, high);
+                    });
+                }
+                else {
+                    // low + scale * u might round up to high
+                    return fill_by_position([gen, low, scale = high - low, last = std::nextafter(high, low)](std::int64_t position) {
+                        return std::min(static_cast<T>(low + scale * unit_uniform<T>(gen(static_cast<std::uint64_t>(position)))), last);
+                    });
+                }
+            }
+
+            /**
+            * @note Fills the array with normal values of a counter-based generator (as fill_random_uniform).
+            */
+            auto& fill_random_normal(const T& mean, const T& stddev, std::uint64_t seed)
+            {
+                const philox_generator gen(seed);
+                return fill_by_position([gen, mean, stddev](std::int64_t position) {
+                    return static_cast<T>(mean + stddev * standard_normal(gen(static_cast<std::uint64_t>(position))));
+                });
+            }
+
+            /**
+            * @return Range of the slices along axis, e.g. the rows of a matrix for axis 0.
+            */
+            [[nodiscard]] auto slices(std::int64_t axis = 0) const
+            {
+                return arrnd_slices<this_type>(*this, axis);
+            }
+
+            /**
+            * @note Calls func(slice) or func(index, slice) for each slice along axis. Slices are distributed by partitions over the current thread pool
+            * (if the array is large, and its references can be copied concurrently), and each partition shifts the header of a single slice,
+            * i.e. a partition adds a single reference to the buffer, however many slices it has.
+            */
+            template <typename Func>
+            void for_each_slice(std::int64_t axis, Func&& func) const
+            {
+                const arrnd_slices<this_type> range(*this, axis);
+
+                for_each_partition<this_type>(range.size(), header().count(), [&range, &func](std::int64_t first, std::int64_t last) {
+                    this_type slice{ range.slice(first) };
+                    for (std::int64_t i = first; i < last; ++i, slice.header().shift(range.stride())) {
+                        if constexpr (std::is_invocable_v<Func, std::int64_t, this_type&>) {
+                            func(i, slice);
+                        }
+                        else {
+                            func(slice);
+                        }
+                    }
+                });
+            }
+
+            [[nodiscard]] auto clone() const
+            {
+                if (empty(*this)) {
+                    return this_type();
+                }
+
+                this_type clone(std::span<const std::int64_t>(header().dims().data(), header().dims().size()));
+
+                pointer dst{ clone.data() };
+                for_each_run([&dst](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    copy_run(first, stride, length, dst, 1);
+                    dst += length;
+                });
+
+                return clone;
+            }
+
+
+            /**
+            * @note Returning a reference to the input array and no allocation performed. If empty array, subarray, or different dimensions resizing.
+            */
+            [[nodiscard]] auto reshape(std::span<const std::int64_t> new_dims) const
+            {
+                if (header().count() != numel(new_dims) || header().is_subarray() || !header().is_contiguous()) {
+                    return resize(new_dims);
+                }
+
+                if (header().dims() == new_dims) {
+                    return *this;
+                }
+
+                typename this_type::header_type new_header(new_dims);
+                if (new_header.empty()) {
+                    return this_type();
+                }
+
+                this_type res(*this);
+                res.header() = std::move(new_header);
+
+                return res;
+            }
+            [[nodiscard]] auto reshape(std::initializer_list<std::int64_t> new_dims) const
+            {
+                return reshape(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+            }
+
+            /*
+            * @note Other references to this array buffer are not modified. Resize is not performed if dims and new_dims are equal.
+            */
+            [[nodiscard]] auto resize(std::span<const std::int64_t> new_dims) const
+            {
+                if (empty(*this)) {
+                    return this_type(std::span<const std::int64_t>(new_dims.data(), new_dims.size()));
+                }
+
+                if (header().dims() == new_dims) {
+                    return *this;
+                }
+
+                if (numel(new_dims) <= 0) {
+                    return this_type();
+                }
+
+                this_type res(std::span<const std::int64_t>(new_dims.data(), new_dims.size()));
+
+                // res is contiguous, copy the runs of this array until either of them ends
+                pointer dst{ res.data() };
+                std::int64_t remaining{ res.header().count() };
+                for_each_run([&dst, &remaining](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    const std::int64_t n{ std::min(length, remaining) };
+                    copy_run(first, stride, n, dst, 1);
+                    dst += n;
+                    remaining -= n;
+                });
+
+                return res;
+            }
+            [[nodiscard]] auto resize(std::initializer_list<std::int64_t> new_dims) const
+            {
+                return resize(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+            }
+
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto append(const ArCo& arr) const
+            {
+                if (empty(*this)) {
+                    this_type res(arr);
+                    return res.clone();
+                }
+
+                if (empty(arr)) {
+                    return *this;
+                }
+
+                this_type res(resize({ header().count() + arr.header().count() }));
+
+                ArCo rarr(arr.reshape({ arr.header().count() }));
+
+                for (std::int64_t i = header().count(); i < res.header().count(); ++i) {
+                    res[{ i }] = arr[{ i - header().count() }];
+                }
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto append(const ArCo& arr, std::int64_t axis) const
+            {
+                if (empty(*this)) {
+                    this_type res(arr);
+                    return res.clone();
+                }
+
+                if (empty(arr)) {
+                    return *this;
+                }
+
+                header_type new_header(header(), arr.header().dims(), axis);
+                if (new_header.empty()) {
+                    return this_type{};
+                }
+
+                this_type res({ header().count() + arr.header().count() });
+                res.header() = std::move(new_header);
+
+                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+
+                indexer_type gen(header(), fixed_axis);
+                typename ArCo::indexer_type arr_gen(arr.header(), fixed_axis);
+                indexer_type res_gen(res.header(), fixed_axis);
+
+                for (; gen && res_gen; ++gen, ++res_gen) {
+                    res.data()[*res_gen] = data()[*gen];
+                }
+                for (; arr_gen && res_gen; ++arr_gen, ++res_gen) {
+                    res.data()[*res_gen] = arr.data()[*arr_gen];
+                }
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto insert(const ArCo& arr, std::int64_t ind) const
+            {
+                if (empty(*this)) {
+                    this_type res(arr);
+                    return res.clone();
+                }
+
+                if (empty(arr)) {
+                    return *this;
+                }
+
+                this_type res({ header().count() + arr.header().count() });
+
+                this_type rlhs(reshape({ header().count() }));
+                ArCo rarr(arr.reshape({ arr.header().count() }));
+
+                std::int64_t fixed_ind{ modulo(ind, header().count() + 1) };
+
+                for (std::int64_t i = 0; i < fixed_ind; ++i) {
+                    res[{ i }] = rlhs[{ i }];
+                }
+                for (std::int64_t i = 0; i < arr.header().count(); ++i) {
+                    res[{ fixed_ind + i }] = rarr[{ i }];
+                }
+                for (std::int64_t i = 0; i < header().count() - fixed_ind; ++i) {
+                    res[{ fixed_ind + arr.header().count() + i }] = rlhs[{ fixed_ind + i }];
+                }
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto insert(const ArCo& arr, std::int64_t ind, std::int64_t axis) const
+            {
+                if (empty(*this)) {
+                    this_type res(arr);
+                    return res.clone();
+                }
+
+                if (empty(arr)) {
+                    return *this;
+                }
+
+                header_type new_header(header(), arr.header().dims(), axis);
+                if (new_header.empty()) {
+                    return this_type();
+                }
+
+                this_type res({ header().count() + arr.header().count() });
+                res.header() = std::move(new_header);
+
+                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+
+                indexer_type gen(header(), fixed_axis);
+                typename ArCo::indexer_type arr_gen(arr.header(), fixed_axis);
+                indexer_type res_gen(res.header(), fixed_axis);
+
+                std::int64_t fixed_ind{ modulo(ind, header().dims()[fixed_axis]) };
+                std::int64_t cycle = fixed_ind *
+                    (std::accumulate(res.header().dims().begin(), res.header().dims().end(), 1, std::multiplies<>{}) / res.header().dims()[fixed_axis]);
+
+                for (; gen && res_gen && cycle; --cycle, ++gen, ++res_gen) {
+                    res.data()[*res_gen] = data()[*gen];
+                }
+                for (; arr_gen && res_gen; ++arr_gen, ++res_gen) {
+                    res.data()[*res_gen] = arr.data()[*arr_gen];
+                }
+                for (; gen && res_gen; ++gen, ++res_gen) {
+                    res.data()[*res_gen] = data()[*gen];
+                }
+
+                return res;
+            }
+
+            /**
+            * @note All elements starting from ind are being removed in case that count value is too big.
+            */
+            [[nodiscard]] auto remove(std::int64_t ind, std::int64_t count) const
+            {
+                if (empty(*this)) {
+                    return *this;
+                }
+
+                std::int64_t fixed_ind{ modulo(ind, header().count()) };
+                std::int64_t fixed_count{ fixed_ind + count < header().count() ? count : (header().count() - fixed_ind) };
+
+                this_type res({ header().count() - fixed_count });
+                this_type rarr(reshape({ header().count() }));
+
+                for (std::int64_t i = 0; i < fixed_ind; ++i) {
+                    res[{ i }] = rarr[{ i }];
+                }
+                for (std::int64_t i = fixed_ind + fixed_count; i < header().count(); ++i) {
+                    res[{ i - fixed_count }] = rarr[{ i }];
+                }
+
+                return res;
+            }
+
+            /**
+            * @note All elements starting from ind are being removed in case that count value is too big.
+            */
+            [[nodiscard]] auto remove(std::int64_t ind, std::int64_t count, std::int64_t axis) const
+            {
+                if (empty(*this)) {
+                    return *this;
+                }
+
+                std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+                std::int64_t fixed_ind{ modulo(ind, header().dims()[fixed_axis]) };
+                std::int64_t fixed_count{ fixed_ind + count <= header().dims()[fixed_axis] ? count : (header().dims()[fixed_axis] - fixed_ind) };
+
+                header_type new_header(header(), -fixed_count, fixed_axis);
+                if (new_header.empty()) {
+                    return this_type();
+                }
+
+                this_type res({ header().count() - (header().count() / header().dims()[fixed_axis]) * fixed_count });
+                res.header() = std::move(new_header);
+
+                indexer_type gen(header(), fixed_axis);
+                indexer_type res_gen(res.header(), fixed_axis);
+
+                std::int64_t cycle = fixed_ind *
+                    (std::accumulate(res.header().dims().begin(), res.header().dims().end(), 1, std::multiplies<>{}) / res.header().dims()[fixed_axis]);
+
+                std::int64_t removals = header().count() - res.header().count();
+
+                for (; gen && res_gen && cycle; --cycle, ++gen, ++res_gen) {
+                    res.data()[*res_gen] = data()[*gen];
+                }
+                for (; gen && removals; --removals, ++gen) {
+                    //data()[*gen] = arr.data()[*arr_gen];
+                }
+                for (; gen && res_gen; ++gen, ++res_gen) {
+                    res.data()[*res_gen] = data()[*gen];
+                }
+
+                return res;
+            }
+
+
+            /**
+            * @note Dense arrays (of any axes order) are transformed linearly in memory order, and the result has the same strides.
+            */
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            [[nodiscard]] auto transform(Unary_op&& op) const
+            {
+                using U = decltype(op(data()[0]));
+
+                if (empty(*this)) {
+                    return replaced_type<U>();
+                }
+
+                if (header().is_dense()) {
+                    auto res = allocate_like<U>();
+
+                    const_pointer src{ data() + header().first_index() };
+                    U* dst{ res.data() + res.header().first_index() };
+                    for (std::int64_t i = 0; i < header().count(); ++i) {
+                        dst[i] = op(src[i]);
+                    }
+
+                    return res;
+                }
+
+                replaced_type<U> res(header().dims());
+
+                U* dst{ res.data() };
+                for_each_run([&dst, &op](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        *dst++ = op(first[i * stride]);
+                    }
+                });
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
+            [[nodiscard]] auto transform(const ArCo& arr, Binary_op&& op) const
+            {
+                using U = decltype(op(data()[0], arr.data()[0]));
+
+                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
+                    return replaced_type<U>();
+                }
+
+                // same dense layout, both buffers are processed linearly in memory order
+                if (header().is_dense() && arr.header().is_dense()
+                    && std::equal(header().strides().begin(), header().strides().end(), arr.header().strides().begin(), arr.header().strides().end())) {
+                    auto res = allocate_like<U>();
+
+                    const_pointer lhs{ data() + header().first_index() };
+                    const auto* rhs{ arr.data() + arr.header().first_index() };
+                    U* dst{ res.data() + res.header().first_index() };
+                    for (std::int64_t i = 0; i < header().count(); ++i) {
+                        dst[i] = op(lhs[i], rhs[i]);
+                    }
+
+                    return res;
+                }
+
+                replaced_type<U> res(header().dims());
+
+                const_pointer lhs{ data() };
+                const auto* rhs{ arr.data() };
+                U* dst{ res.data() };
+                for_each_joint_run([&](const auto& indices, std::int64_t length, const auto& strides) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        dst[indices[2] + i * strides[2]] = op(lhs[indices[0] + i * strides[0]], rhs[indices[1] + i * strides[1]]);
+                    }
+                }, header(), arr.header(), res.header());
+
+                return res;
+            }
+
+            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
+            [[nodiscard]] auto transform(const V& value, Binary_op&& op) const
+            {
+                // the value is copied, so that it is not reloaded per element (e.g. as it might alias the result)
+                return transform([value, &op](const_reference element) {
+                    return op(element, value);
+                });
+            }
+
+
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            auto& apply(Unary_op&& op)
+            {
+                if (empty(*this)) {
+                    return *this;
+                }
+
+                if (header().is_dense()) {
+                    pointer first{ data() + header().first_index() };
+                    for (std::int64_t i = 0; i < header().count(); ++i) {
+                        first[i] = op(first[i]);
+                    }
+                    return *this;
+                }
+
+                for_each_run([&op](pointer first, std::int64_t length, std::int64_t stride) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        first[i * stride] = op(first[i * stride]);
+                    }
+                });
+
+                return *this;
+            }
+
+            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
+            auto& apply(const ArCo& arr, Binary_op&& op)
+            {
+                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
+                    return *this;
+                }
+
+                pointer lhs{ data() };
+                const auto* rhs{ arr.data() };
+                for_each_joint_run([&](const auto& indices, std::int64_t length, const auto& strides) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        pointer element{ lhs + indices[0] + i * strides[0] };
+                        *element = op(*element, rhs[indices[1] + i * strides[1]]);
+                    }
+                }, header(), arr.header());
+
+                return *this;
+            }
+
+            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
+            auto& apply(const V& value, Binary_op&& op)
+            {
+                return apply([value, &op](const_reference element) {
+                    return op(element, value);
+                });
+            }
+
+
+
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op) const
+            {
+                using U = decltype(op(data()[0], data()[0]));
+
+                if (empty(*this)) {
+                    return U{};
+                }
+
+                std::optional<U> res{};
+                for_each_run([&res, &op](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    std::int64_t i{ 0 };
+                    if (!res) {
+                        res.emplace(static_cast<U>(first[0]));
+                        ++i;
+                    }
+                    U acc{ std::move(*res) };
+                    for (; i < length; ++i) {
+                        acc = op(acc, first[i * stride]);
+                    }
+                    *res = std::move(acc);
+                });
+
+                return *res;
+            }
+
+            template <typename U, typename Binary_op> requires std::is_invocable_v<Binary_op, U, T>
+            [[nodiscard]] auto reduce(const U& init_value, Binary_op&& op) const
+            {
+                if (empty(*this)) {
+                    return init_value;
+                }
+
+                U res{ init_value };
+                for_each_run([&res, &op](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        res = op(res, first[i * stride]);
+                    }
+                });
+
+                return res;
+            }
+
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op, std::int64_t axis) const
+            {
+                return reduce(op, std::span<const std::int64_t>(&axis, 1));
+            }
+
+            /**
+            * @note All axes are reduced in a single traversal. Reduced axes are removed from the result dimensions, or kept with size 1 if keepdims is set.
+            * If axes is empty, each element is reduced alone, i.e. the result is a copy of the array (converted to the result type of op).
+            */
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op, std::span<const std::int64_t> axes, bool keepdims = false) const
+            {
+                using U = decltype(op(data()[0], data()[0]));
+
+                if (empty(*this)) {
+                    return replaced_type<U>();
+                }
+
+                if (axes.empty()) {
+                    return transform([](const_reference value) {
+                        return static_cast<U>(value);
+                    });
+                }
+
+                auto [order, res_dims, reduction_iteration_cycle] = reduction_layout(axes, keepdims);
+
+                replaced_type<U> res(std::span<const std::int64_t>(res_dims.data(), res_dims.size()));
+
+                indexer_type gen(header(), std::span<const std::int64_t>(order.data(), order.size()));
+
+                for (std::int64_t i = 0; i < res.header().count(); ++i) {
+                    U res_element{ static_cast<U>((*this)[*gen]) };
+                    ++gen;
+                    for (std::int64_t j = 1; j < reduction_iteration_cycle; ++j, ++gen) {
+                        res_element = op(res_element, (*this)[*gen]);
+                    }
+                    res.data()[i] = std::move(res_element);
+                }
+
+                return res;
+            }
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op, std::initializer_list<std::int64_t> axes, bool keepdims = false) const
+            {
+                return reduce(op, std::span<const std::int64_t>(axes.begin(), axes.size()), keepdims);
+            }
+
+            template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, T>
+            [[nodiscard]] auto reduce(const ArCo& init_values, Binary_op&& op, std::int64_t axis) const
+            {
+                using U = decltype(op(init_values.data()[0], data()[0]));
+
+                if (empty(*this)) {
+                    return replaced_type<U>();
+                }
+
+                const std::int64_t fixed_axis{ modulo(axis, std::ssize(header().dims())) };
+
+                if (init_values.header().dims().size() != 1 && init_values.header().dims()[fixed_axis] != header().dims()[fixed_axis]) {
+                    return replaced_type<U>();
+                }
+
+                typename replaced_type<U>::header_type new_header(header(), axis);
+                if (new_header.empty()) {
+                    return replaced_type<U>();
+                }
+
+                replaced_type<U> res({ new_header.count() });
+                res.header() = std::move(new_header);
+
+                indexer_type gen(header(), std::ssize(header().dims()) - fixed_axis - 1);
+                indexer_type res_gen(res.header());
+                typename ArCo::indexer_type init_gen(init_values.header());
+
+                const std::int64_t reduction_iteration_cycle{ header().dims()[fixed_axis] };
+
+                while (gen && res_gen && init_gen) {
+                    U res_element{ init_values[*init_gen] };
+                    for (std::int64_t i = 0; i < reduction_iteration_cycle; ++i, ++gen) {
+                        res_element = op(res_element, (*this)[*gen]);
+                    }
+                    res[*res_gen] = std::move(res_element);
+                    ++res_gen;
+                    ++init_gen;
+                }
+
+                return res;
+            }
+
+            /**
+            * @note Dense arrays are accumulated linearly in memory order, and elements of other arrays (e.g. strided subarrays) are gathered into blocks before accumulation.
+            */
+            template <typename Summation_policy = pairwise_summation>
+            [[nodiscard]] auto sum() const
+            {
+                summation_accumulator<T, Summation_policy> acc{};
+                accumulate_to(acc);
+                return acc.result();
+            }
+
+            template <typename Summation_policy = pairwise_summation>
+            [[nodiscard]] auto sum(std::span<const std::int64_t> axes, bool keepdims = false) const
+            {
+                return reduce_by_accumulator<summation_accumulator<T, Summation_policy>>(axes, keepdims, [](const auto& acc) {
+                    return acc.result();
+                });
+            }
+            template <typename Summation_policy = pairwise_summation>
+            [[nodiscard]] auto sum(std::initializer_list<std::int64_t> axes, bool keepdims = false) const
+            {
+                return sum<Summation_policy>(std::span<const std::int64_t>(axes.begin(), axes.size()), keepdims);
+            }
+
+            /**
+            * @return NaN for an empty array. Integral elements result in double.
+            * @note Large arrays are partitioned over the thread pool, and the partial results are merged.
+            */
+            [[nodiscard]] auto mean() const
+            {
+                return moments_of().average();
+            }
+
+            [[nodiscard]] auto mean(std::span<const std::int64_t> axes, bool keepdims = false) const
+            {
+                return reduce_by_accumulator<moments_accumulator<T>>(axes, keepdims, [](const auto& acc) {
+                    return acc.result().average();
+                });
+            }
+            [[nodiscard]] auto mean(std::initializer_list<std::int64_t> axes, bool keepdims = false) const
+            {
+                return mean(std::span<const std::int64_t>(axes.begin(), axes.size()), keepdims);
+            }
+
+            /**
+            * @param ddof The divisor is the number of elements minus ddof.
+            * @return NaN if the number of elements is not greater than ddof.
+            */
+            [[nodiscard]] auto var(std::int64_t ddof = 0) const
+            {
+                return moments_of().variance(ddof);
+            }
+
+            [[nodiscard]] auto var(std::span<const std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false) const
+            {
+                return reduce_by_accumulator<moments_accumulator<T>>(axes, keepdims, [ddof](const auto& acc) {
+                    return acc.result().variance(ddof);
+                });
+            }
+            [[nodiscard]] auto var(std::initializer_list<std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false) const
+            {
+                return var(std::span<const std::int64_t>(axes.begin(), axes.size()), ddof, keepdims);
+            }
+
+            [[nodiscard]] auto stddev(std::int64_t ddof = 0) const
+            {
+                return std::sqrt(var(ddof));
+            }
+
+            [[nodiscard]] auto stddev(std::span<const std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false) const
+            {
+                return reduce_by_accumulator<moments_accumulator<T>>(axes, keepdims, [ddof](const auto& acc) {
+                    return std::sqrt(acc.result().variance(ddof));
+                });
+            }
+            [[nodiscard]] auto stddev(std::initializer_list<std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false) const
+            {
+                return stddev(std::span<const std::int64_t>(axes.begin(), axes.size()), ddof, keepdims);
+            }
+
+            /**
+            * @return Buffer index (as returned by find) of the first minimal element, or -1 for an empty array.
+            */
+            [[nodiscard]] std::int64_t argmin() const
+            {
+                return arg_extremum_of(std::less<>{});
+            }
+
+            /**
+            * @return Buffer index (as returned by find) of the first maximal element, or -1 for an empty array.
+            */
+            [[nodiscard]] std::int64_t argmax() const
+            {
+                return arg_extremum_of(std::greater<>{});
+            }
+
+            /**
+            * @return Buffer indices of the first minimal elements along axis. The array can be indexed by the result to get the minimal values.
+            */
+            [[nodiscard]] auto argmin(std::int64_t axis) const
+            {
+                return arg_extremum_of(std::less<>{}, axis);
+            }
+
+            /**
+            * @return Buffer indices of the first maximal elements along axis. The array can be indexed by the result to get the maximal values.
+            */
+            [[nodiscard]] auto argmax(std::int64_t axis) const
+            {
+                return arg_extremum_of(std::greater<>{}, axis);
+            }
+
+
+            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
+            [[nodiscard]] auto filter(Unary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return this_type();
+                }
+
+                this_type res({ header().count() });
+
+                indexer_type gen(header());
+                indexer_type res_gen(res.header());
+
+                std::int64_t res_count{ 0 };
+
+                while (gen && res_gen) {
+                    if (pred((*this)[*gen])) {
+                        res[*res_gen] = (*this)[*gen];
+                        ++res_count;
+                        ++res_gen;
+                    }
+                    ++gen;
+                }
+
+                if (res_count == 0) {
+                    return this_type();
+                }
+
+                if (res_count < header().count()) {
+                    return res.resize({ res_count });
+                }
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto filter(const ArCo& mask) const
+            {
+                if (empty(*this)) {
+                    return this_type();
+                }
+
+                if (!std::equal(header().dims().begin(), header().dims().end(), mask.header().dims().begin(), mask.header().dims().end())) {
+                    return this_type();
+                }
+
+                this_type res({ header().count() });
+
+                indexer_type gen(header());
+                typename ArCo::indexer_type mask_gen(mask.header());
+
+                indexer_type res_gen(res.header());
+
+                std::int64_t res_count{ 0 };
+
+                while (gen && mask_gen && res_gen) {
+                    if (mask[*mask_gen]) {
+                        res[*res_gen] = (*this)[*gen];
+                        ++res_count;
+                        ++res_gen;
+                    }
+                    ++gen;
+                    ++mask_gen;
+                }
+
+                if (res_count == 0) {
+                    return this_type();
+                }
+
+                if (res_count < header().count()) {
+                    return res.resize({ res_count });
+                }
+
+                return res;
+            }
+
+            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
+            [[nodiscard]] auto find(Unary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return replaced_type<std::int64_t>();
+                }
+
+                replaced_type<std::int64_t> res({ header().count() });
+
+                indexer_type gen(header());
+                typename replaced_type<std::int64_t>::indexer_type res_gen(res.header());
+
+                std::int64_t res_count{ 0 };
+
+                while (gen && res_gen) {
+                    if (pred((*this)[*gen])) {
+                        res[*res_gen] = *gen;
+                        ++res_count;
+                        ++res_gen;
+                    }
+                    ++gen;
+                }
+
+                if (res_count == 0) {
+                    return replaced_type<std::int64_t>();
+                }
+
+                if (res_count < header().count()) {
+                    return res.resize({ res_count });
+                }
+
+                return res;
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto find(const ArCo& mask) const
+            {
+                if (empty(*this)) {
+                    return replaced_type<std::int64_t>();
+                }
+
+                if (!std::equal(header().dims().begin(), header().dims().end(), mask.header().dims().begin(), mask.header().dims().end())) {
+                    return replaced_type<std::int64_t>();
+                }
+
+                replaced_type<std::int64_t> res({ header().count() });
+
+                indexer_type gen(header());
+                typename ArCo::indexer_type mask_gen(mask.header());
+
+                typename replaced_type<std::int64_t>::indexer_type res_gen(res.header());
+
+                std::int64_t res_count{ 0 };
+
+                while (gen && mask_gen && res_gen) {
+                    if (mask[*mask_gen]) {
+                        res[*res_gen] = *gen;
+                        ++res_count;
+                        ++res_gen;
+                    }
+                    ++gen;
+                    ++mask_gen;
+                }
+
+                if (res_count == 0) {
+                    return replaced_type<std::int64_t>();
+                }
+
+                if (res_count < header().count()) {
+                    return res.resize({ res_count });
+                }
+
+                return res;
+            }
+
+
+            [[nodiscard]] auto transpose(std::span<const std::int64_t> order) const
+            {
+                if (empty(*this)) {
+                    return this_type();
+                }
+
+                header_type new_header(header(), order);
+                if (new_header.empty()) {
+                    return this_type();
+                }
+
+                this_type res({ header().count() });
+                res.header() = std::move(new_header);
+
+                indexer_type gen(header(), order);
+                indexer_type res_gen(res.header());
+
+                while (gen && res_gen) {
+                    res[*res_gen] = (*this)[*gen];
+                    ++gen;
+                    ++res_gen;
+                }
+
+                return res;
+            }
+
+            [[nodiscard]] auto transpose(std::initializer_list<std::int64_t> order) const
+            {
+                return transpose(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            /**
+            * @return A view of this array with the order of the elements along axis reversed, sharing the buffer of this array.
+            * @note The axis is taken by modulo of the number of dimensions.
+            */
+            [[nodiscard]] arrnd flip(std::int64_t axis) const
+            {
+                if (empty(*this)) {
+                    return this_type();
+                }
+
+                const std::int64_t ndims{ std::ssize(header().dims()) };
+
+                simple_dynamic_vector<Interval<std::int64_t>> ranges(ndims);
+                for (std::int64_t i = 0; i < ndims; ++i) {
+                    ranges[i] = Interval<std::int64_t>{ 0, -1 };
+                }
+                ranges[modulo(axis, ndims)] = Interval<std::int64_t>{ -1, 0, -1 };
+
+                return (*this)[std::span<const Interval<std::int64_t>>(ranges.data(), ranges.size())];
+            }
+
+
+            template <arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
+            [[nodiscard]] bool all_match(const ArCo& arr, Binary_pred pred) const
+            {
+                if (empty(*this) && empty(arr)) {
+                    return true;
+                }
+
+                if (empty(*this) || empty(arr)) {
+                    return false;
+                }
+
+                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
+                    return false;
+                }
+
+                for (arrnd_multi_indexer<2, typename header_type::storage_type> gen(header(), arr.header()); gen; ++gen) {
+                    if (!pred(data()[gen[0]], arr.data()[gen[1]])) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <typename U, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, U>
+            [[nodiscard]] bool all_match(const U& value, Binary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return true;
+                }
+
+                for (indexer_type gen(header()); gen; ++gen) {
+                    if (!pred((*this)[*gen], value)) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
+            [[nodiscard]] bool all_match(Unary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return true;
+                }
+
+                for (indexer_type gen(header()); gen; ++gen) {
+                    if (!pred((*this)[*gen])) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
+            [[nodiscard]] bool any_match(const ArCo& arr, Binary_pred pred) const
+            {
+                if (empty(*this) && empty(arr)) {
+                    return true;
+                }
+
+                if (empty(*this) || empty(arr)) {
+                    return false;
+                }
+
+                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
+                    return false;
+                }
+
+                indexer_type gen(header());
+                typename ArCo::indexer_type arr_gen(arr.header());
+
+                for (; gen && arr_gen; ++gen, ++arr_gen) {
+                    if (pred((*this)[*gen], arr[*arr_gen])) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            template <typename U, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, U>
+            [[nodiscard]] bool any_match(const U& value, Binary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return true;
+                }
+
+                for (indexer_type gen(header()); gen; ++gen) {
+                    if (pred((*this)[*gen], value)) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
+            [[nodiscard]] bool any_match(Unary_pred pred) const
+            {
+                if (empty(*this)) {
+                    return true;
+                }
+
+                for (indexer_type gen(header()); gen; ++gen) {
+                    if (pred((*this)[*gen])) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+
+            [[nodiscard]] bool all() const
+            {
+                return all_match([](const value_type& value) { return static_cast<bool>(value); });
+            }
+
+            [[nodiscard]] auto all(std::int64_t axis) const
+            {
+                return reduce([](const value_type& a, const value_type& b) { return a && b; }, axis);
+            }
+
+            [[nodiscard]] bool any() const
+            {
+                return any_match([](const value_type& value) { return static_cast<bool>(value); });
+            }
+
+            [[nodiscard]] auto any(std::int64_t axis) const
+            {
+                return reduce([](const value_type& a, const value_type& b) { return a || b; }, axis);
+            }
+
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] replaced_type<bool> close(const ArCo& arr, const decltype(value_type{} - typename ArCo::value_type{})& atol = default_atol<decltype(value_type{} - typename ArCo::value_type{}) > (), const decltype(value_type{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(value_type{} - typename ArCo::value_type{}) > ()) const
+            {
+                return transform(arr, [&atol, &rtol](const value_type& a, const typename ArCo::value_type& b) { return oc::details::close(a, b, atol, rtol); });
+            }
+
+            template <typename U> requires (!arrnd_complient<U>)
+            [[nodiscard]] replaced_type<bool> close(const U& value, const decltype(value_type{} - U{})& atol = default_atol<decltype(value_type{} - U{}) > (), const decltype(value_type{} - U{})& rtol = default_rtol<decltype(value_type{} - U{}) > ()) const
+            {
+                return transform(value, [&atol, &rtol](const value_type& a, const U& b) { return oc::details::close(a, b, atol, rtol); });
+            }
+
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] bool all_equal(const ArCo& arr) const
+            {
+                return all_match(arr, [](const value_type& a, const typename ArCo::value_type& b) { return a == b; });
+            }
+
+            template <typename U>
+            [[nodiscard]] bool all_equal(const U& value) const
+            {
+                return all_match(value, [](const value_type& a, const U& b) { return a == b; });
+            }
+
+            template <arrnd_complient ArCo>
+            [[nodiscard]] bool all_close(const ArCo& arr, const decltype(value_type{} - typename ArCo::value_type{})& atol = default_atol<decltype(value_type{} - typename ArCo::value_type{}) > (), const decltype(value_type{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(value_type{} - typename ArCo::value_type{}) > ()) const
+            {
+                return all_match(arr, [&atol, &rtol](const value_type& a, const typename ArCo::value_type& b) { return oc::details::close(a, b, atol, rtol); });
+            }
+
+            template <typename U> requires (!arrnd_complient<U>)
+            [[nodiscard]] bool all_close(const U& value, const decltype(value_type{} - U{})& atol = default_atol<decltype(value_type{} - U{}) > (), const decltype(value_type{} - U{})& rtol = default_rtol<decltype(value_type{} - U{}) > ()) const
+            {
+                return all_match(value, [&atol, &rtol](const value_type& a, const U& b) { return oc::details::close(a, b, atol, rtol); });
+            }
+
+            auto begin(std::int64_t axis = 0)
+            {
+                return iterator(buffsp_->data(), indexer_type(hdr_, axis));
+            }
+
+            auto end(std::int64_t axis = 0)
+            {
+                return iterator(buffsp_->data(), indexer_type(hdr_, axis, true) + 1);
+            }
+
+
+            auto cbegin(std::int64_t axis = 0) const
+            {
+                return const_iterator(buffsp_->data(), indexer_type(hdr_, axis));
+            }
+
+            auto cend(std::int64_t axis = 0) const
+            {
+                return const_iterator(buffsp_->data() , indexer_type(hdr_, axis, true) + 1);
+            }
+
+
+            auto rbegin(std::int64_t axis = 0)
+            {
+                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis, true));
+            }
+
+            auto rend(std::int64_t axis = 0)
+            {
+                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis) - 1);
+            }
+
+            auto crbegin(std::int64_t axis = 0) const
+            {
+                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis, true));
+            }
+
+            auto crend(std::int64_t axis = 0) const
+            {
+                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis) - 1);
+            }
+
+
+            auto begin(std::span<const std::int64_t> order)
+            {
+                return iterator(buffsp_->data(), indexer_type(hdr_, order));
+            }
+
+            auto end(std::span<const std::int64_t> order)
+            {
+                return iterator(buffsp_->data(), indexer_type(hdr_, order, true) + 1);
+            }
+
+
+            auto cbegin(std::span<const std::int64_t> order) const
+            {
+                return const_iterator(buffsp_->data(), indexer_type(hdr_, order));
+            }
+
+            auto cend(std::span<const std::int64_t> order) const
+            {
+                return const_iterator(buffsp_->data(), indexer_type(hdr_, order, true) + 1);
+            }
+
+
+            auto rbegin(std::span<const std::int64_t> order)
+            {
+                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, order, true));
+            }
+
+            auto rend(std::span<const std::int64_t> order)
+            {
+                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, order) - 1);
+            }
+
+            auto crbegin(std::span<const std::int64_t> order) const
+            {
+                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, order, true));
+            }
+
+            auto crend(std::span<const std::int64_t> order) const
+            {
+                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, order) - 1);
+            }
+
+
+
+            auto begin(std::initializer_list<std::int64_t> order)
+            {
+                return begin(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            auto end(std::initializer_list<std::int64_t> order)
+            {
+                return end(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+
+            auto cbegin(std::initializer_list<std::int64_t> order) const
+            {
+                return cbegin(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            auto cend(std::initializer_list<std::int64_t> order) const
+            {
+                return cend(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+
+            auto rbegin(std::initializer_list<std::int64_t> order)
+            {
+                return rbegin(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            auto rend(std::initializer_list<std::int64_t> order)
+            {
+                return rend(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            auto crbegin(std::initializer_list<std::int64_t> order) const
+            {
+                return crbegin(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+            auto crend(std::initializer_list<std::int64_t> order) const
+            {
+                return crend(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
+
+
+
+            [[nodiscard]] auto abs() const
+            {
+                return transform([](const value_type& a) { return ::abs(a); });
+            }
+
+            
+            [[nodiscard]] auto acos() const
+            {
+                return transform([](const value_type& a) { return ::acos(a); });
+            }
+
+            
+            [[nodiscard]] auto acosh() const
+            {
+                return transform([](const value_type& a) { return ::acosh(a); });
+            }
+
+            
+            [[nodiscard]] auto asin() const
+            {
+                return transform([](const value_type& a) { return ::asin(a); });
+            }
+
+            
+            [[nodiscard]] auto asinh() const
+            {
+                return transform([](const value_type& a) { return ::asinh(a); });
+            }
+
+            
+            [[nodiscard]] auto atan() const
+            {
+                return transform([](const value_type& a) { return ::atan(a); });
+            }
+
+            
+            [[nodiscard]] auto atanh() const
+            {
+                return transform([](const value_type& a) { return ::atanh(a); });
+            }
+
+            
+            [[nodiscard]] auto cos() const
+            {
+                return transform([](const value_type& a) { return ::cos(a); });
+            }
+
+            
+            [[nodiscard]] auto cosh() const
+            {
+                return transform([](const value_type& a) { return ::cosh(a); });
+            }
+
+            
+            [[nodiscard]] auto exp() const
+            {
+                return transform([](const value_type& a) { return ::exp(a); });
+            }
+
+            
+            [[nodiscard]] auto log() const
+            {
+                return transform([](const value_type& a) { return ::log(a); });
+            }
+
+            
+            [[nodiscard]] auto log10() const
+            {
+                return transform([](const value_type& a) { return ::log10(a); });
+            }
+
+            
+            template <typename U>
+            [[nodiscard]] auto pow(const U& exponent) const
+            {
+                return transform([&exponent](const value_type& a) { return ::pow(a, exponent); });
+            }
+
+            
+            [[nodiscard]] auto sin() const
+            {
+                return transform([](const value_type& a) { return ::sin(a); });
+            }
+
+            
+            [[nodiscard]] auto sinh() const
+            {
+                return transform([](const value_type& a) { return ::sinh(a); });
+            }
+
+            
+            [[nodiscard]] auto sqrt() const
+            {
+                return transform([](const value_type& a) { return ::sqrt(a); });
+            }
+
+            
+            [[nodiscard]] auto tan() const
+            {
+                return transform([](const value_type& a) { return ::tan(a); });
+            }
+
+            
+            [[nodiscard]] auto tanh() const
+            {
+                return transform([](const value_type& a) { return ::tanh(a); });
+            }
+
+            /*
+            * Asynchronous operations:
+            * ========================
+            * The operation is processed on the shared thread pool, with a copy of this array (sharing its buffer) and copies of the arguments,
+            * and its result is returned as async_result, which can be waited for or awaited (co_await).
+            * The array should not be modified by others until the operation is completed, and referenced arguments (e.g. spans of axes) should outlive it.
+            * Arrays that are not concurrently copyable (e.g. of non_atomic_ref_count) are processed by the calling thread, and the result is ready on return.
+            */
+
+            template <typename... Args>
+            [[nodiscard]] auto async_transform(Args&&... args) const
+            {
+                return async_invoke<this_type>([self = *this, ...args = std::forward<Args>(args)]() {
+                    return self.transform(args...);
+                });
+            }
+
+            template <typename... Args>
+            [[nodiscard]] auto async_apply(Args&&... args) const
+            {
+                return async_invoke<this_type>([self = *this, ...args = std::forward<Args>(args)]() mutable {
+                    return this_type{ self.apply(args...) };
+                });
+            }
+
+            template <typename... Args>
+            [[nodiscard]] auto async_reduce(Args&&... args) const
+            {
+                return async_invoke<this_type>([self = *this, ...args = std::forward<Args>(args)]() {
+                    return self.reduce(args...);
+                });
+            }
+
+            template <typename Summation_policy = pairwise_summation, typename... Args>
+            [[nodiscard]] auto async_sum(Args&&... args) const
+            {
+                return async_invoke<this_type>([self = *this, ...args = std::forward<Args>(args)]() {
+                    return self.template sum<Summation_policy>(args...);
+                });
+            }
+
+            template <typename... Args>
+            [[nodiscard]] auto async_filter(Args&&... args) const
+            {
+                return async_invoke<this_type>([self = *this, ...args = std::forward<Args>(args)]() {
+                    return self.filter(args...);
+                });
+            }
+
+
+
+        private:
+            [[nodiscard]] static shared_ref_type make_shared_buffer(std::int64_t size)
+            {
+                return RefCountPolicy::template make_shared_ref<storage_type, SharedRefAllocator>(size);
+            }
+
+            /**
+            * @return Array with the dimensions of this array. A dense array of any axes order and direction is allocated with the same strides,
+            * so that the result buffer can be written linearly in the memory order of this array.
+            */
+            template <typename U>
+            [[nodiscard]] auto allocate_like() const
+            {
+                if (header().is_dense() && !header().is_contiguous()) {
+                    return replaced_type<U>(header().dims(), header().strides());
+                }
+                return replaced_type<U>(header().dims());
+            }
+
+            /**
+            * @note Sets each element to generate(position), where position is the element index in iteration order.
+            * The runs of a non contiguous array are partitioned, and each partition starts at the outer indices of its first run.
+            */
+            template <typename Generate>
+            auto& fill_by_position(Generate&& generate)
+            {
+                if (empty(*this)) {
+                    return *this;
+                }
+
+                if (header().is_contiguous()) {
+                    pointer first{ data() + header().offset() };
+                    for_each_partition<T>(header().count(), header().count(), [first, &generate](std::int64_t pfirst, std::int64_t plast) {
+                        for (std::int64_t i = pfirst; i < plast; ++i) {
+                            first[i] = generate(i);
+                        }
+                    });
+                    return *this;
+                }
+
+                const auto plan = iteration_plan_of(header());
+
+                const std::int64_t length{ plan->inner_length() };
+                const std::int64_t stride{ plan->inner_stride(0) };
+                const std::int64_t nouter{ plan->ndims() - 1 };
+                const std::int64_t* dims{ plan->dims().data() };
+                const std::int64_t* strides{ plan->strides(0).data() };
+                const std::int64_t offset{ header().offset() };
+                pointer buffer{ data() };
+
+                for_each_partition<T>(header().count() / length, header().count(), [&](std::int64_t rfirst, std::int64_t rlast) {
+                    constexpr std::int64_t max_static_outer_loops{ 8 };
+                    std::int64_t static_counters[max_static_outer_loops]{};
+                    std::vector<std::int64_t> dynamic_counters(nouter > max_static_outer_loops ? nouter : 0, 0);
+                    std::int64_t* counters{ nouter > max_static_outer_loops ? dynamic_counters.data() : static_counters };
+
+                    std::int64_t index{ offset };
+                    for (std::int64_t i = nouter - 1, run = rfirst; i >= 0; --i) {
+                        counters[i] = run % dims[i];
+                        index += counters[i] * strides[i];
+                        run /= dims[i];
+                    }
+
+                    for (std::int64_t run = rfirst; run < rlast; ++run) {
+                        for (std::int64_t j = 0; j < length; ++j) {
+                            buffer[index + j * stride] = generate(run * length + j);
+                        }
+
+                        for (std::int64_t i = nouter - 1; i >= 0; --i) {
+                            index += strides[i];
+                            if (++counters[i] < dims[i]) {
+                                break;
+                            }
+                            index -= counters[i] * strides[i];
+                            counters[i] = 0;
+                        }
+                    }
+                });
+                return *this;
+            }
+
+            /**
+            * @return Iteration order with the reduced axes as the innermost ones, dimensions of the reduction result, and the number of reduced elements per result element.
+            * @note Axes are taken by modulo of the number of dimensions, and repeated axes are ignored.
+            */
+            [[nodiscard]] auto reduction_layout(std::span<const std::int64_t> axes, bool keepdims) const
+            {
+                using header_storage_type = typename header_type::storage_type;
+
+                const std::int64_t ndims{ std::ssize(header().dims()) };
+
+                header_storage_type reduced(ndims);
+                std::fill(reduced.begin(), reduced.end(), 0);
+                for (std::int64_t axis : axes) {
+                    reduced[modulo(axis, ndims)] = 1;
+                }
+
+                header_storage_type order(ndims);
+                header_storage_type res_dims(ndims);
+                std::int64_t num_kept{ 0 };
+                std::int64_t num_res_dims{ 0 };
+                std::int64_t reduction_iteration_cycle{ 1 };
+
+                for (std::int64_t i = 0; i < ndims; ++i) {
+                    if (!reduced[i]) {
+                        order[num_kept++] = i;
+                        res_dims[num_res_dims++] = header().dims()[i];
+                    }
+                    else if (keepdims) {
+                        res_dims[num_res_dims++] = 1;
+                    }
+                }
+                for (std::int64_t i = 0, pos = num_kept; i < ndims; ++i) {
+                    if (reduced[i]) {
+                        order[pos++] = i;
+                        reduction_iteration_cycle *= header().dims()[i];
+                    }
+                }
+
+                if (num_res_dims == 0) {
+                    res_dims[num_res_dims++] = 1;
+                }
+                res_dims.resize(num_res_dims);
+
+                return std::make_tuple(std::move(order), std::move(res_dims), reduction_iteration_cycle);
+            }
+
+            /**
+            * @note Accumulates all the elements. Dense arrays are accumulated in memory order, and elements of other arrays are gathered into blocks of the accumulator block size.
+            */
+            template <typename Accumulator>
+            void accumulate_to(Accumulator& acc) const
+            {
+                if (empty(*this)) {
+                    return;
+                }
+
+                if (header().is_dense()) {
+                    acc.accumulate(data() + header().first_index(), header().count());
+                    return;
+                }
+
+                value_type block[Accumulator::block_size];
+                std::int64_t block_count{ 0 };
+
+                for_each_run([&](const_pointer first, std::int64_t length, std::int64_t stride) {
+                    for (std::int64_t i = 0; i < length; ++i) {
+                        block[block_count++] = first[i * stride];
+                        if (block_count == Accumulator::block_size) {
+                            accumulate_block(acc, std::span<const value_type, Accumulator::block_size>(block), block_count);
+                            block_count = 0;
+                        }
+                    }
+                });
+                accumulate_block(acc, std::span<const value_type, Accumulator::block_size>(block), block_count);
+            }
+
+            /**
+            * @return Array of finalize(acc) for each result element, where acc accumulated the elements of the reduced axes.
+            * If axes is empty, each acc accumulates a single element.
+            */
+            template <typename Accumulator, typename Finalize>
+            [[nodiscard]] auto reduce_by_accumulator(std::span<const std::int64_t> axes, bool keepdims, Finalize finalize) const
+            {
+                using U = std::remove_cvref_t<std::invoke_result_t<Finalize, const Accumulator&>>;
+
+                if (empty(*this)) {
+                    return replaced_type<U>();
+                }
+
+                if (axes.empty()) {
+                    return transform([&finalize](const_reference value) {
+                        Accumulator acc{};
+                        acc.accumulate(&value, 1);
+                        return static_cast<U>(finalize(acc));
+                    });
+                }
+
+                auto [order, res_dims, reduction_iteration_cycle] = reduction_layout(axes, keepdims);
+
+                replaced_type<U> res(std::span<const std::int64_t>(res_dims.data(), res_dims.size()));
+
+                indexer_type gen(header(), std::span<const std::int64_t>(order.data(), order.size()));
+
+                value_type block[Accumulator::block_size];
+
+                for (std::int64_t i = 0; i < res.header().count(); ++i) {
+                    Accumulator acc{};
+                    std::int64_t block_count{ 0 };
+                    for (std::int64_t j = 0; j < reduction_iteration_cycle; ++j, ++gen) {
+                        block[block_count++] = (*this)[*gen];
+                        if (block_count == Accumulator::block_size) {
+                            accumulate_block(acc, std::span<const value_type, Accumulator::block_size>(block), block_count);
+                            block_count = 0;
+                        }
+                    }
+                    accumulate_block(acc, std::span<const value_type, Accumulator::block_size>(block), block_count);
+                    res.data()[i] = finalize(acc);
+                }
+
+                return res;
+            }
+
+            /**
+            * @note Large dense arrays are partitioned over the thread pool.
+            * Partial moments are merged by partition order, so that the result does not depend on the scheduling.
+            */
+            [[nodiscard]] auto moments_of() const
+            {
+                using moments_type = decltype(moments_accumulator<T>{}.result());
+
+                if (empty(*this) || !header().is_dense() || header().count() < parallel_threshold) {
+                    moments_accumulator<T> acc{};
+                    accumulate_to(acc);
+                    return acc.result();
+                }
+
+                const_pointer first{ data() + header().first_index() };
+
+                std::mutex partials_mutex;
+                std::vector<std::pair<std::int64_t, moments_type>> partials;
+
+                thread_pool::current().parallel_for(header().count(), [&](std::int64_t first_ind, std::int64_t last_ind) {
+                    moments_accumulator<T> acc{};
+                    acc.accumulate(first + first_ind, last_ind - first_ind);
+
+                    std::scoped_lock lock(partials_mutex);
+                    partials.emplace_back(first_ind, acc.result());
+                });
+
+                std::sort(partials.begin(), partials.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.first < rhs.first;
+                });
+
+                moments_type res{};
+                for (const auto& partial : partials) {
+                    res.merge(partial.second);
+                }
+                return res;
+            }
+
+            /**
+            * @note Contiguous arrays are searched by the vectorized kernel, and large ones are partitioned over the thread pool.
+            */
+            template <typename Compare>
+            [[nodiscard]] std::int64_t arg_extremum_of(Compare comp) const
+            {
+                if (empty(*this)) {
+                    return -1;
+                }
+
+                const_pointer buffer{ data() };
+
+                if (!header().is_contiguous()) {
+                    indexer_type gen(header());
+                    std::int64_t best{ *gen };
+                    for (++gen; gen; ++gen) {
+                        if (comp(buffer[*gen], buffer[best])) {
+                            best = *gen;
+                        }
+                    }
+                    return best;
+                }
+
+                const_pointer first{ buffer + header().offset() };
+                const std::int64_t count{ header().count() };
+
+                if (count < parallel_threshold) {
+                    return header().offset() + arg_extremum(first, count, comp);
+                }
+
+                std::mutex best_mutex;
+                std::int64_t best{ -1 };
+
+                thread_pool::current().parallel_for(count, [&](std::int64_t first_ind, std::int64_t last_ind) {
+                    std::int64_t local_best{ first_ind + arg_extremum(first + first_ind, last_ind - first_ind, comp) };
+
+                    std::scoped_lock lock(best_mutex);
+                    if (best < 0 || comp(first[local_best], first[best]) || (!comp(first[best], first[local_best]) && local_best < best)) {
+                        best = local_best;
+                    }
+                });
+
+                return header().offset() + best;
+            }
+
+            /**
+            * @note Large arrays are partitioned over the thread pool by their outermost non reduced axis.
+            */
+            template <typename Compare>
+            [[nodiscard]] auto arg_extremum_of(Compare comp, std::int64_t axis) const
+            {
+                using indices_type = replaced_type<std::int64_t>;
+
+                if (empty(*this)) {
+                    return indices_type();
+                }
+
+                const std::int64_t ndims{ std::ssize(header().dims()) };
+                const std::int64_t fixed_axis{ modulo(axis, ndims) };
+
+                auto [order, res_dims, reduction_iteration_cycle] = reduction_layout(std::span<const std::int64_t>(&fixed_axis, 1), false);
+
+                indices_type res(std::span<const std::int64_t>(res_dims.data(), res_dims.size()));
+
+                auto full_ranges = [ndims](const header_type& hdr) {
+                    simple_dynamic_vector<Interval<std::int64_t>> ranges(ndims);
+                    for (std::int64_t i = 0; i < ndims; ++i) {
+                        ranges[i] = Interval<std::int64_t>{ 0, hdr.dims()[i] - 1 };
+                    }
+                    return ranges;
+                };
+
+                // partitions are searched by their headers over the buffer of this array, so that workers do not share (copies of) array references
+                const_pointer buffer{ data() };
+
+                auto search = [&](const header_type& src_hdr, std::int64_t* res_first) {
+                    // contiguous reduced runs are searched by the vectorized kernel, using the runs starts header
+                    if (src_hdr.strides()[fixed_axis] == 1) {
+                        auto ranges = full_ranges(src_hdr);
+                        ranges[fixed_axis] = Interval<std::int64_t>{ 0, 0 };
+                        const header_type starts_hdr(src_hdr, std::span<const Interval<std::int64_t>>(ranges.data(), ranges.size()));
+
+                        std::int64_t i{ 0 };
+                        for (indexer_type gen(starts_hdr); gen; ++gen, ++i) {
+                            res_first[i] = *gen + arg_extremum(buffer + *gen, reduction_iteration_cycle, comp);
+                        }
+                        return;
+                    }
+
+                    indexer_type gen(src_hdr, std::span<const std::int64_t>(order.data(), order.size()));
+                    for (std::int64_t i = 0; gen; ++i) {
+                        std::int64_t best{ *gen };
+                        ++gen;
+                        for (std::int64_t j = 1; j < reduction_iteration_cycle; ++j, ++gen) {
+                            if (comp(buffer[*gen], buffer[best])) {
+                                best = *gen;
+                            }
+                        }
+                        res_first[i] = best;
+                    }
+                };
+
+                // outermost non reduced axis
+                const std::int64_t split_axis{ order[0] != fixed_axis ? order[0] : -1 };
+
+                if (header().count() < parallel_threshold || split_axis < 0 || header().dims()[split_axis] < 2) {
+                    search(header(), res.data());
+                    return res;
+                }
+
+                const std::int64_t res_stride{ res.header().count() / header().dims()[split_axis] };
+                std::int64_t* res_buffer{ res.data() };
+
+                thread_pool::current().parallel_for(header().dims()[split_axis], [&](std::int64_t first_ind, std::int64_t last_ind) {
+                    auto ranges = full_ranges(header());
+                    ranges[split_axis] = Interval<std::int64_t>{ first_ind, last_ind - 1 };
+                    search(header_type(header(), std::span<const Interval<std::int64_t>>(ranges.data(), ranges.size())), res_buffer + first_ind * res_stride);
+                });
+
+                return res;
+            }
+
+            header_type hdr_{};
+            shared_ref_type buffsp_{ nullptr };
+        };
+
+        /**
+        * @note Copy is being performed even if dimensions are not match either partialy or by indices modulus.
+        */
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2& dst)
+        {
+            return dst.copy_from(src);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2&& dst)
+        {
+            return dst.copy_from(src);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, arrnd_complient ArCo3>
+        inline auto& copy(const ArCo1& src, ArCo2& dst, const ArCo3& indices)
+        {
+            return dst.copy_from(src, indices);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, arrnd_complient ArCo3>
+        inline auto& copy(const ArCo1& src, ArCo2&& dst, const ArCo3& indices)
+        {
+            return dst.copy_from(src, indices);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2& dst, std::span<const Interval<std::int64_t>> ranges)
+        {
+            return dst.copy_from(src, ranges);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2&& dst, std::span<const Interval<std::int64_t>> ranges)
+        {
+            return dst.copy_from(src, ranges);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2& dst, std::initializer_list<Interval<std::int64_t>> ranges)
+        {
+            return dst.copy_from(src, ranges);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& copy(const ArCo1& src, ArCo2&& dst, std::initializer_list<Interval<std::int64_t>> ranges)
+        {
+            return dst.copy_from(src, ranges);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& set(const ArCo1& src, ArCo2& dst)
+        {
+            return dst.set_from(src);
+        }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& set(const ArCo1& src, ArCo2&& dst)
+        {
+            return dst.set_from(src);
+        }
+
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto clone(const ArCo& arr)
+        {
+            return arr.clone();
+        }
+
+        /**
+        * @note Returning a reference to the input array, except in case of resulted empty array or an input subarray.
+        */
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto reshape(const ArCo& arr, std::span<const std::int64_t> new_dims)
+        {
+            return arr.reshape(new_dims);
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto reshape(const ArCo& arr, std::initializer_list<std::int64_t> new_dims)
+        {
+            return arr.reshape(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto resize(const ArCo& arr, std::span<const std::int64_t> new_dims)
+        {
+            return arr.resize(new_dims);
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto resize(const ArCo& arr, std::initializer_list<std::int64_t> new_dims)
+        {
+            return arr.resize(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline ArCo1 append(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.append(rhs);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline ArCo1 append(const ArCo1& lhs, const ArCo2& rhs, std::int64_t axis)
+        {
+            return lhs.append(rhs, axis);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline ArCo1 insert(const ArCo1& lhs, const ArCo2& rhs, std::int64_t ind)
+        {
+            return lhs.insert(rhs, ind);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline ArCo1 insert(const ArCo1& lhs, const ArCo2& rhs, std::int64_t ind, std::int64_t axis)
+        {
+            return lhs.insert(rhs, ind, axis);
+        }
+
+        /**
+        * @note All elements starting from ind are being removed in case that count value is too big.
+        */
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto remove(const ArCo& arr, std::int64_t ind, std::int64_t count)
+        {
+            return arr.remove(ind, count);
+        }
+
+        /**
+        * @note All elements starting from ind are being removed in case that count value is too big.
+        */
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto remove(const ArCo& arr, std::int64_t ind, std::int64_t count, std::int64_t axis)
+        {
+            return arr.remove(ind, count, axis);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline bool empty(const ArCo& arr) noexcept
+        {
+            return !arr.data() && arr.header().empty();
+        }
+
+        template <arrnd_complient ArCo, typename Unary_op> requires std::is_invocable_v<Unary_op, typename ArCo::value_type>
+        [[nodiscard]] inline auto transform(const ArCo& arr, Unary_op&& op)
+        {
+            return arr.transform(op);
+        }
+
+        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op)
+        {
+            return arr.reduce(op);
+        }
+
+        template <arrnd_complient ArCo, typename T, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo& arr, const T& init_value, Binary_op&& op)
+        {
+            return arr.reduce(init_value, op);
+        }
+
+        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op, std::int64_t axis)
+        {
+            return arr.reduce(op, axis);
+        }
+
+        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op, std::span<const std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.reduce(op, axes, keepdims);
+        }
+
+        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op, std::initializer_list<std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.reduce(op, axes, keepdims);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo2::value_type, typename ArCo1::value_type>
+        [[nodiscard]] inline auto reduce(const ArCo1& arr, const ArCo2& init_values, Binary_op&& op, std::int64_t axis)
+        {
+            return arr.reduce(init_values, op, axis);
+        }
+
+        template <typename Summation_policy = pairwise_summation, arrnd_complient ArCo>
+        [[nodiscard]] inline auto sum(const ArCo& arr)
+        {
+            return arr.template sum<Summation_policy>();
+        }
+
+        template <typename Summation_policy = pairwise_summation, arrnd_complient ArCo>
+        [[nodiscard]] inline auto sum(const ArCo& arr, std::span<const std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.template sum<Summation_policy>(axes, keepdims);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto mean(const ArCo& arr)
+        {
+            return arr.mean();
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto mean(const ArCo& arr, std::span<const std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.mean(axes, keepdims);
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto mean(const ArCo& arr, std::initializer_list<std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.mean(axes, keepdims);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto var(const ArCo& arr, std::int64_t ddof = 0)
+        {
+            return arr.var(ddof);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto var(const ArCo& arr, std::span<const std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false)
+        {
+            return arr.var(axes, ddof, keepdims);
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto var(const ArCo& arr, std::initializer_list<std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false)
+        {
+            return arr.var(axes, ddof, keepdims);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto stddev(const ArCo& arr, std::int64_t ddof = 0)
+        {
+            return arr.stddev(ddof);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto stddev(const ArCo& arr, std::span<const std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false)
+        {
+            return arr.stddev(axes, ddof, keepdims);
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto stddev(const ArCo& arr, std::initializer_list<std::int64_t> axes, std::int64_t ddof = 0, bool keepdims = false)
+        {
+            return arr.stddev(axes, ddof, keepdims);
+        }
+
+        template <arrnd_complient ArCo, typename... Args>
+        [[nodiscard]] inline auto async_transform(const ArCo& arr, Args&&... args)
+        {
+            return arr.async_transform(std::forward<Args>(args)...);
+        }
+
+        template <arrnd_complient ArCo, typename... Args>
+        [[nodiscard]] inline auto async_apply(const ArCo& arr, Args&&... args)
+        {
+            return arr.async_apply(std::forward<Args>(args)...);
+        }
+
+        template <arrnd_complient ArCo, typename... Args>
+        [[nodiscard]] inline auto async_reduce(const ArCo& arr, Args&&... args)
+        {
+            return arr.async_reduce(std::forward<Args>(args)...);
+        }
+
+        template <typename Summation_policy = pairwise_summation, arrnd_complient ArCo, typename... Args>
+        [[nodiscard]] inline auto async_sum(const ArCo& arr, Args&&... args)
+        {
+            return arr.template async_sum<Summation_policy>(std::forward<Args>(args)...);
+        }
+
+        template <arrnd_complient ArCo, typename... Args>
+        [[nodiscard]] inline auto async_filter(const ArCo& arr, Args&&... args)
+        {
+            return arr.async_filter(std::forward<Args>(args)...);
+        }
+
+        template <typename Summation_policy = pairwise_summation, arrnd_complient ArCo>
+        [[nodiscard]] inline auto sum(const ArCo& arr, std::initializer_list<std::int64_t> axes, bool keepdims = false)
+        {
+            return arr.template sum<Summation_policy>(axes, keepdims);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline std::int64_t argmin(const ArCo& arr)
+        {
+            return arr.argmin();
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto argmin(const ArCo& arr, std::int64_t axis)
+        {
+            return arr.argmin(axis);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline std::int64_t argmax(const ArCo& arr)
+        {
+            return arr.argmax();
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto argmax(const ArCo& arr, std::int64_t axis)
+        {
+            return arr.argmax(axis);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline bool all(const ArCo& arr)
+        {
+            return arr.all();
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto all(const ArCo& arr, std::int64_t axis)
+        {
+            return arr.all(axis);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline bool any(const ArCo& arr)
+        {
+            return arr.any();
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto any(const ArCo& arr, std::int64_t axis)
+        {
+            return arr.any(axis);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo1::value_type, typename ArCo2::value_type>
+        [[nodiscard]] inline auto transform(const ArCo1& lhs, const ArCo2& rhs, Binary_op&& op)
+        {
+            return lhs.transform(rhs, op);
+        }
+
+        template <arrnd_complient ArCo, typename T, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, T>
+        [[nodiscard]] inline auto transform(const ArCo& lhs, const T& rhs, Binary_op&& op)
+        {
+            return lhs.transform(rhs, op);
+        }
+
+        template <typename T, arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
+        [[nodiscard]] inline auto transform(const T& lhs, const ArCo& rhs, Binary_op&& op)
+        {
+            return rhs.transform([&lhs, &op](const typename ArCo::value_type& value) { return op(lhs, value); });
+        }
+
+        template <arrnd_complient ArCo, typename Unary_pred> requires std::is_invocable_v<Unary_pred, typename ArCo::value_type>
+        [[nodiscard]] inline auto filter(const ArCo& arr, Unary_pred pred)
+        {
+            return arr.filter(pred);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline ArCo1 filter(const ArCo1& arr, const ArCo2& mask)
+        {
+            return arr.filter(mask);
+        }
+
+        template <arrnd_complient ArCo, typename Unary_pred> requires std::is_invocable_v<Unary_pred, typename ArCo::value_type>
+        [[nodiscard]] inline auto find(const ArCo& arr, Unary_pred pred)
+        {
+            return arr.find(pred);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto find(const ArCo1& arr, const ArCo2& mask)
+        {
+            return arr.find(mask);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto transpose(const ArCo& arr, std::span<const std::int64_t> order)
+        {
+            return arr.transpose(order);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto transpose(const ArCo& arr, std::initializer_list<std::int64_t> order)
+        {
+            return arr.transpose(order);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto flip(const ArCo& arr, std::int64_t axis)
+        {
+            return arr.flip(axis);
+        }
+
+        template <arrnd_complient ArCo, typename Func>
+        inline void for_each_run(const ArCo& arr, Func&& func)
+        {
+            arr.for_each_run(std::forward<Func>(func));
+        }
+
+        template <arrnd_complient ArCo>
+        inline auto& fill_random_uniform(ArCo& arr, const typename ArCo::value_type& low, const typename ArCo::value_type& high, std::uint64_t seed)
+        {
+            return arr.fill_random_uniform(low, high, seed);
+        }
+
+        template <arrnd_complient ArCo>
+        inline auto& fill_random_normal(ArCo& arr, const typename ArCo::value_type& mean, const typename ArCo::value_type& stddev, std::uint64_t seed)
+        {
+            return arr.fill_random_normal(mean, stddev, seed);
+        }
+
+        /**
+        * @return Array of uniform values in [low, high) of a counter-based generator (reproducible by seed regardless of the number of threads).
+        */
+        template <arrnd_complient ArCo> requires std::floating_point<typename ArCo::value_type>
+        [[nodiscard]] inline ArCo random_uniform(std::span<const std::int64_t> dims, const typename ArCo::value_type& low, const typename ArCo::value_type& high, std::uint64_t seed)
+        {
+            ArCo res(dims);
+            res.fill_random_uniform(low, high, seed);
+            return res;
+        }
+        template <arrnd_complient ArCo> requires std::floating_point<typename ArCo::value_type>
+        [[nodiscard]] inline ArCo random_uniform(std::initializer_list<std::int64_t> dims, const typename ArCo::value_type& low, const typename ArCo::value_type& high, std::uint64_t seed)
+        {
+            return random_uniform<ArCo>(std::span<const std::int64_t>(dims.begin(), dims.size()), low, high, seed);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline ArCo random_normal(std::span<const std::int64_t> dims, const typename ArCo::value_type& mean, const typename ArCo::value_type& stddev, std::uint64_t seed)
+        {
+            ArCo res(dims);
+            res.fill_random_normal(mean, stddev, seed);
+            return res;
+        }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline ArCo random_normal(std::initializer_list<std::int64_t> dims, const typename ArCo::value_type& mean, const typename ArCo::value_type& stddev, std::uint64_t seed)
+        {
+            return random_normal<ArCo>(std::span<const std::int64_t>(dims.begin(), dims.size()), mean, stddev, seed);
+        }
+
+        /**
+        * @return Array of uniform integers in [low, high] of a counter-based generator.
+        */
+        template <arrnd_complient ArCo> requires std::integral<typename ArCo::value_type>
+        [[nodiscard]] inline ArCo random_integers(std::span<const std::int64_t> dims, const typename ArCo::value_type& low, const typename ArCo::value_type& high, std::uint64_t seed)
+        {
+            ArCo res(dims);
+            res.fill_random_uniform(low, high, seed);
+            return res;
+        }
+        template <arrnd_complient ArCo> requires std::integral<typename ArCo::value_type>
+        [[nodiscard]] inline ArCo random_integers(std::initializer_list<std::int64_t> dims, const typename ArCo::value_type& low, const typename ArCo::value_type& high, std::uint64_t seed)
+        {
+            return random_integers<ArCo>(std::span<const std::int64_t>(dims.begin(), dims.size()), low, high, seed);
+        }
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto slices(const ArCo& arr, std::int64_t axis = 0)
+        {
+            return arr.slices(axis);
+        }
+
+        template <arrnd_complient ArCo, typename Func>
+        inline void for_each_slice(const ArCo& arr, std::int64_t axis, Func&& func)
+        {
+            arr.for_each_slice(axis, std::forward<Func>(func));
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator==(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a == b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator==(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a == b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator==(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a == b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator!=(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a != b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator!=(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a != b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator!=(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a != b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto close(const ArCo1& lhs, const ArCo2& rhs, const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& atol = default_atol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > (), const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& rtol = default_rtol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > ())
+        {
+            return lhs.close(rhs, atol, rtol);
+        }
+
+        template <arrnd_complient ArCo, typename T> requires (!arrnd_complient<T>)
+        [[nodiscard]] inline auto close(const ArCo& lhs, const T& rhs, const decltype(typename ArCo::value_type{} - T{})& atol = default_atol<decltype(typename ArCo::value_type{} - T{}) > (), const decltype(typename ArCo::value_type{} - T{})& rtol = default_rtol<decltype(typename ArCo::value_type{} - T{}) > ())
+        {
+            return lhs.close(rhs, atol, rtol);
+        }
+
+        template <typename T, arrnd_complient ArCo> requires (!arrnd_complient<T>)
+        [[nodiscard]] inline auto close(const T& lhs, const ArCo& rhs, const decltype(T{} - typename ArCo::value_type{})& atol = default_atol<decltype(T{} - typename ArCo::value_type{}) > (), const decltype(T{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(T{} - typename ArCo::value_type{}) > ())
+        {
+            return rhs.close(lhs, atol, rtol);
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator>(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a > b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator>(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a > b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator>(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a > b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator>=(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >= b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator>=(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >= b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator>=(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a >= b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator<(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a < b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator<(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a < b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator<(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a < b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator<=(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a <= b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator<=(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a <= b; });
+        }
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator<=(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a <= b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator+(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a + b; });
+        }
+
+        /**
+        * @note Operation of a temporary array and a scalar, which is computed in place (and the array is returned)
+        * if the array buffer is uniquely owned and the result is of the array value type.
+        */
+        template <arrnd_complient ArCo, typename T, typename Binary_op> requires (!std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto transform_temporary(ArCo&& arr, const T& value, Binary_op&& op)
+        {
+            using U = std::invoke_result_t<Binary_op, const typename ArCo::value_type&, const T&>;
 
-                while (gen && res_gen) {
-                    res[*res_gen] = (*this)[*gen];
-                    ++gen;
-                    ++res_gen;
+            if constexpr (std::is_same_v<U, typename ArCo::value_type>) {
+                if (arr.is_unique()) {
+                    arr.apply(value, std::forward<Binary_op>(op));
+                    return ArCo(std::move(arr));
                 }
-
-                return res;
             }
 
-            [[nodiscard]] auto transpose(std::initializer_list<std::int64_t> order) const
-            {
-                return transpose(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+            return arr.transform(value, std::forward<Binary_op>(op));
+        }
 
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator+(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a + b; });
+        }
 
-            template <arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
-            [[nodiscard]] bool all_match(const ArCo& arr, Binary_pred pred) const
-            {
-                if (empty(*this) && empty(arr)) {
-                    return true;
-                }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator+(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a + b; });
+        }
 
-                if (empty(*this) || empty(arr)) {
-                    return false;
-                }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator+(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a + b; });
+        }
 
-                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
-                    return false;
-                }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator+(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a + b; });
+        }
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type arr_gen(arr.header());
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator+=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a + b; });
+        }
 
-                for (; gen && arr_gen; ++gen, ++arr_gen) {
-                    if (!pred((*this)[*gen], arr[*arr_gen])) {
-                        return false;
-                    }
-                }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator+=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a + b; });
+        }
 
-                return true;
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator-(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a - b; });
+        }
 
-            template <typename U, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, U>
-            [[nodiscard]] bool all_match(const U& value, Binary_pred pred) const
-            {
-                if (empty(*this)) {
-                    return true;
-                }
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator-(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a - b; });
+        }
 
-                for (indexer_type gen(header()); gen; ++gen) {
-                    if (!pred((*this)[*gen], value)) {
-                        return false;
-                    }
-                }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator-(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a - b; });
+        }
 
-                return true;
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator-(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a - b; });
+        }
 
-            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
-            [[nodiscard]] bool all_match(Unary_pred pred) const
-            {
-                if (empty(*this)) {
-                    return true;
-                }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator-(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a - b; });
+        }
 
-                for (indexer_type gen(header()); gen; ++gen) {
-                    if (!pred((*this)[*gen])) {
-                        return false;
-                    }
-                }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator-=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a - b; });
+        }
 
-                return true;
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator-=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a - b; });
+        }
 
-            template <arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
-            [[nodiscard]] bool any_match(const ArCo& arr, Binary_pred pred) const
-            {
-                if (empty(*this) && empty(arr)) {
-                    return true;
-                }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator*(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a * b; });
+        }
 
-                if (empty(*this) || empty(arr)) {
-                    return false;
-                }
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator*(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a * b; });
+        }
 
-                if (!std::equal(header().dims().begin(), header().dims().end(), arr.header().dims().begin(), arr.header().dims().end())) {
-                    return false;
-                }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator*(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a * b; });
+        }
 
-                indexer_type gen(header());
-                typename ArCo::indexer_type arr_gen(arr.header());
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator*(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a * b; });
+        }
 
-                for (; gen && arr_gen; ++gen, ++arr_gen) {
-                    if (pred((*this)[*gen], arr[*arr_gen])) {
-                        return true;
-                    }
-                }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator*(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a * b; });
+        }
 
-                return false;
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator*=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a * b; });
+        }
 
-            template <typename U, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, U>
-            [[nodiscard]] bool any_match(const U& value, Binary_pred pred) const
-            {
-                if (empty(*this)) {
-                    return true;
-                }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator*=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a * b; });
+        }
 
-                for (indexer_type gen(header()); gen; ++gen) {
-                    if (pred((*this)[*gen], value)) {
-                        return true;
-                    }
-                }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator/(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a / b; });
+        }
 
-                return false;
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator/(const ArCo& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return lhs.transform(fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a / b; });
             }
-
-            template <typename Unary_pred> requires std::is_invocable_v<Unary_pred, T>
-            [[nodiscard]] bool any_match(Unary_pred pred) const
-            {
-                if (empty(*this)) {
-                    return true;
-                }
-
-                for (indexer_type gen(header()); gen; ++gen) {
-                    if (pred((*this)[*gen])) {
-                        return true;
-                    }
-                }
-
-                return false;
+            else {
+                return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a / b; });
             }
+        }
 
-
-            [[nodiscard]] bool all() const
-            {
-                return all_match([](const value_type& value) { return static_cast<bool>(value); });
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator/(ArCo&& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return transform_temporary(std::move(lhs), fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a / b; });
             }
-
-            [[nodiscard]] auto all(std::int64_t axis) const
-            {
-                return reduce([](const value_type& a, const value_type& b) { return a && b; }, axis);
+            else {
+                return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a / b; });
             }
+        }
 
-            [[nodiscard]] bool any() const
-            {
-                return any_match([](const value_type& value) { return static_cast<bool>(value); });
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator/(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a / b; });
+        }
 
-            [[nodiscard]] auto any(std::int64_t axis) const
-            {
-                return reduce([](const value_type& a, const value_type& b) { return a || b; }, axis);
-            }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator/(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a / b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator/=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a / b; });
+        }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] replaced_type<bool> close(const ArCo& arr, const decltype(value_type{} - typename ArCo::value_type{})& atol = default_atol<decltype(value_type{} - typename ArCo::value_type{}) > (), const decltype(value_type{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(value_type{} - typename ArCo::value_type{}) > ()) const
-            {
-                return transform(arr, [&atol, &rtol](const value_type& a, const typename ArCo::value_type& b) { return oc::details::close(a, b, atol, rtol); });
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator/=(ArCo& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return lhs.apply(fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a / b; });
             }
-
-            template <typename U> requires (!arrnd_complient<U>)
-            [[nodiscard]] replaced_type<bool> close(const U& value, const decltype(value_type{} - U{})& atol = default_atol<decltype(value_type{} - U{}) > (), const decltype(value_type{} - U{})& rtol = default_rtol<decltype(value_type{} - U{}) > ()) const
-            {
-                return transform(value, [&atol, &rtol](const value_type& a, const U& b) { return oc::details::close(a, b, atol, rtol); });
+            else {
+                return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a / b; });
             }
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto operator%(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a % b; });
+        }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] bool all_equal(const ArCo& arr) const
-            {
-                return all_match(arr, [](const value_type& a, const typename ArCo::value_type& b) { return a == b; });
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator%(const ArCo& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return lhs.transform(fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a % b; });
             }
-
-            template <typename U>
-            [[nodiscard]] bool all_equal(const U& value) const
-            {
-                return all_match(value, [](const value_type& a, const U& b) { return a == b; });
+            else {
+                return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a % b; });
             }
+        }
 
-            template <arrnd_complient ArCo>
-            [[nodiscard]] bool all_close(const ArCo& arr, const decltype(value_type{} - typename ArCo::value_type{})& atol = default_atol<decltype(value_type{} - typename ArCo::value_type{}) > (), const decltype(value_type{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(value_type{} - typename ArCo::value_type{}) > ()) const
-            {
-                return all_match(arr, [&atol, &rtol](const value_type& a, const typename ArCo::value_type& b) { return oc::details::close(a, b, atol, rtol); });
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator%(ArCo&& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return transform_temporary(std::move(lhs), fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a % b; });
             }
-
-            template <typename U> requires (!arrnd_complient<U>)
-            [[nodiscard]] bool all_close(const U& value, const decltype(value_type{} - U{})& atol = default_atol<decltype(value_type{} - U{}) > (), const decltype(value_type{} - U{})& rtol = default_rtol<decltype(value_type{} - U{}) > ()) const
-            {
-                return all_match(value, [&atol, &rtol](const value_type& a, const U& b) { return oc::details::close(a, b, atol, rtol); });
+            else {
+                return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a % b; });
             }
+        }
 
-            auto begin(std::int64_t axis = 0)
-            {
-                return iterator(buffsp_->data(), indexer_type(hdr_, axis));
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator%(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a % b; });
+        }
 
-            auto end(std::int64_t axis = 0)
-            {
-                return iterator(buffsp_->data(), indexer_type(hdr_, axis, true) + 1);
-            }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator%(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a % b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator%=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a % b; });
+        }
 
-            auto cbegin(std::int64_t axis = 0) const
-            {
-                return const_iterator(buffsp_->data(), indexer_type(hdr_, axis));
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator%=(ArCo& lhs, const T& rhs)
+        {
+            if constexpr (fast_divisible<typename ArCo::value_type, T>) {
+                return lhs.apply(fast_divisor<T>(rhs), [](const T& a, const fast_divisor<T>& b) { return a % b; });
             }
-
-            auto cend(std::int64_t axis = 0) const
-            {
-                return const_iterator(buffsp_->data() , indexer_type(hdr_, axis, true) + 1);
+            else {
+                return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a % b; });
             }
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator^(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a ^ b; });
+        }
 
-            auto rbegin(std::int64_t axis = 0)
-            {
-                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis, true));
-            }
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator^(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a ^ b; });
+        }
 
-            auto rend(std::int64_t axis = 0)
-            {
-                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis) - 1);
-            }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator^(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a ^ b; });
+        }
 
-            auto crbegin(std::int64_t axis = 0) const
-            {
-                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis, true));
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator^(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a ^ b; });
+        }
 
-            auto crend(std::int64_t axis = 0) const
-            {
-                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, axis) - 1);
-            }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator^(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a ^ b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator^=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a ^ b; });
+        }
 
-            auto begin(std::span<const std::int64_t> order)
-            {
-                return iterator(buffsp_->data(), indexer_type(hdr_, order));
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator^=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a ^ b; });
+        }
 
-            auto end(std::span<const std::int64_t> order)
-            {
-                return iterator(buffsp_->data(), indexer_type(hdr_, order, true) + 1);
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator&(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a & b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator&(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a & b; });
+        }
 
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator&(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a & b; });
+        }
 
-            auto cbegin(std::span<const std::int64_t> order) const
-            {
-                return const_iterator(buffsp_->data(), indexer_type(hdr_, order));
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator&(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a & b; });
+        }
 
-            auto cend(std::span<const std::int64_t> order) const
-            {
-                return const_iterator(buffsp_->data(), indexer_type(hdr_, order, true) + 1);
-            }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator&(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a & b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator&=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a & b; });
+        }
 
-            auto rbegin(std::span<const std::int64_t> order)
-            {
-                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, order, true));
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator&=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a & b; });
+        }
 
-            auto rend(std::span<const std::int64_t> order)
-            {
-                return reverse_iterator(buffsp_->data(), indexer_type(hdr_, order) - 1);
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator|(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a | b; });
+        }
 
-            auto crbegin(std::span<const std::int64_t> order) const
-            {
-                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, order, true));
-            }
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator|(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a | b; });
+        }
 
-            auto crend(std::span<const std::int64_t> order) const
-            {
-                return const_reverse_iterator(buffsp_->data(), indexer_type(hdr_, order) - 1);
-            }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator|(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a | b; });
+        }
 
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator|(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a | b; });
+        }
 
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator|(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a | b; });
+        }
 
-            auto begin(std::initializer_list<std::int64_t> order)
-            {
-                return begin(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator|=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a | b; });
+        }
 
-            auto end(std::initializer_list<std::int64_t> order)
-            {
-                return end(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator|=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a | b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator<<(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a << b; });
+        }
 
-            auto cbegin(std::initializer_list<std::int64_t> order) const
-            {
-                return cbegin(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator<<(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a << b; });
+        }
 
-            auto cend(std::initializer_list<std::int64_t> order) const
-            {
-                return cend(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator<<(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a << b; });
+        }
 
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator<<(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a << b; });
+        }
 
-            auto rbegin(std::initializer_list<std::int64_t> order)
-            {
-                return rbegin(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator<<(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a << b; });
+        }
 
-            auto rend(std::initializer_list<std::int64_t> order)
-            {
-                return rend(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator<<=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a << b; });
+        }
 
-            auto crbegin(std::initializer_list<std::int64_t> order) const
-            {
-                return crbegin(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator<<=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a << b; });
+        }
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline auto operator>>(const ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >> b; });
+        }
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator>>(const ArCo& lhs, const T& rhs)
+        {
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >> b; });
+        }
+
+        template <arrnd_complient ArCo, typename T> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator>>(ArCo&& lhs, const T& rhs)
+        {
+            return transform_temporary(std::move(lhs), rhs, [](const typename ArCo::value_type& a, const T& b) { return a >> b; });
+        }
 
-            auto crend(std::initializer_list<std::int64_t> order) const
-            {
-                return crend(std::span<const std::int64_t>(order.begin(), order.size()));
-            }
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator>>(const T& lhs, const ArCo& rhs)
+        {
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a >> b; });
+        }
 
+        template <typename T, arrnd_complient ArCo> requires (std::is_arithmetic_v<T> && !std::is_const_v<ArCo>)
+        [[nodiscard]] inline auto operator>>(const T& lhs, ArCo&& rhs)
+        {
+            return transform_temporary(std::move(rhs), lhs, [](const typename ArCo::value_type& b, const T& a) { return a >> b; });
+        }
 
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        inline auto& operator>>=(ArCo1& lhs, const ArCo2& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >> b; });
+        }
 
-            [[nodiscard]] auto abs()
-            {
-                return transform([](const value_type& a) { return ::abs(a); });
-            }
+        template <arrnd_complient ArCo, typename T>
+        inline auto& operator>>=(ArCo& lhs, const T& rhs)
+        {
+            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >> b; });
+        }
 
-            
-            [[nodiscard]] auto acos()
-            {
-                return transform([](const value_type& a) { return ::acos(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator~(const ArCo& arr)
+        {
+            return arr.transform([](const typename ArCo::value_type& a) { return ~a; });
+        }
 
-            
-            [[nodiscard]] auto acosh()
-            {
-                return transform([](const value_type& a) { return ::acosh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator!(const ArCo& arr)
+        {
+            return arr.transform([](const typename ArCo::value_type& a) { return !a; });
+        }
 
-            
-            [[nodiscard]] auto asin()
-            {
-                return transform([](const value_type& a) { return ::asin(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator+(const ArCo& arr)
+        {
+            return arr.transform([](const typename ArCo::value_type& a) { return +a; });
+        }
 
-            
-            [[nodiscard]] auto asinh()
-            {
-                return transform([](const value_type& a) { return ::asinh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator-(const ArCo& arr)
+        {
+            return arr.transform([](const typename ArCo::value_type& a) { return -a; });
+        }
 
-            
-            [[nodiscard]] auto atan()
-            {
-                return transform([](const value_type& a) { return ::atan(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto abs(const ArCo& arr)
+        {
+            return arr.abs();
+        }
 
-            
-            [[nodiscard]] auto atanh()
-            {
-                return transform([](const value_type& a) { return ::atanh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto acos(const ArCo& arr)
+        {
+            return arr.acos();
+        }
 
-            
-            [[nodiscard]] auto cos()
-            {
-                return transform([](const value_type& a) { return ::cos(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto acosh(const ArCo& arr)
+        {
+            return arr.acosh();
+        }
 
-            
-            [[nodiscard]] auto cosh()
-            {
-                return transform([](const value_type& a) { return ::cosh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto asin(const ArCo& arr)
+        {
+            return arr.asin();
+        }
 
-            
-            [[nodiscard]] auto exp()
-            {
-                return transform([](const value_type& a) { return ::exp(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto asinh(const ArCo& arr)
+        {
+            return arr.asinh();
+        }
 
-            
-            [[nodiscard]] auto log()
-            {
-                return transform([](const value_type& a) { return ::log(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto atan(const ArCo& arr)
+        {
+            return arr.atan();
+        }
 
-            
-            [[nodiscard]] auto log10()
-            {
-                return transform([](const value_type& a) { return ::log10(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto atanh(const ArCo& arr)
+        {
+            return arr.atanh();
+        }
 
-            
-            [[nodiscard]] auto pow()
-            {
-                return transform([](const value_type& a) { return ::pow(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto cos(const ArCo& arr)
+        {
+            return arr.cos();
+        }
 
-            
-            [[nodiscard]] auto sin()
-            {
-                return transform([](const value_type& a) { return ::sin(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto cosh(const ArCo& arr)
+        {
+            return arr.cosh();
+        }
 
-            
-            [[nodiscard]] auto sinh()
-            {
-                return transform([](const value_type& a) { return ::sinh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto exp(const ArCo& arr)
+        {
+            return arr.exp();
+        }
+        
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto log(const ArCo& arr)
+        {
+            return arr.log();
+        }
 
-            
-            [[nodiscard]] auto sqrt()
-            {
-                return transform([](const value_type& a) { return ::sqrt(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto log10(const ArCo& arr)
+        {
+            return arr.log10();
+        }
 
-            
-            [[nodiscard]] auto tan()
-            {
-                return transform([](const value_type& a) { return ::tan(a); });
-            }
+        template <arrnd_complient ArCo, typename U>
+        [[nodiscard]] inline auto pow(const ArCo& arr, const U& exponent)
+        {
+            return arr.pow(exponent);
+        }
 
-            
-            [[nodiscard]] auto tanh()
-            {
-                return transform([](const value_type& a) { return ::tanh(a); });
-            }
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto sin(const ArCo& arr)
+        {
+            return arr.sin();
+        }
 
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto sinh(const ArCo& arr)
+        {
+            return arr.sinh();
+        }
 
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto sqrt(const ArCo& arr)
+        {
+            return arr.sqrt();
+        }
 
-        private:
-            header_type hdr_{};
-            std::shared_ptr<storage_type> buffsp_{ nullptr };
-        };
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto tan(const ArCo& arr)
+        {
+            return arr.tan();
+        }
 
-        /**
-        * @note Copy is being performed even if dimensions are not match either partialy or by indices modulus.
-        */
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2& dst)
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto tanh(const ArCo& arr)
         {
-            return dst.copy_from(src);
+            return arr.tanh();
         }
+
         template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2&& dst)
+        [[nodiscard]] inline auto operator&&(const ArCo1& lhs, const ArCo2& rhs)
         {
-            return dst.copy_from(src);
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a && b; });
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, arrnd_complient ArCo3>
-        inline auto& copy(const ArCo1& src, ArCo2& dst, const ArCo3& indices)
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator&&(const ArCo& lhs, const T& rhs)
         {
-            return dst.copy_from(src, indices);
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a && b; });
         }
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, arrnd_complient ArCo3>
-        inline auto& copy(const ArCo1& src, ArCo2&& dst, const ArCo3& indices)
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator&&(const T& lhs, const ArCo& rhs)
         {
-            return dst.copy_from(src, indices);
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a && b; });
         }
 
         template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2& dst, std::span<const Interval<std::int64_t>> ranges)
+        [[nodiscard]] inline auto operator||(const ArCo1& lhs, const ArCo2& rhs)
         {
-            return dst.copy_from(src, ranges);
+            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a || b; });
         }
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2&& dst, std::span<const Interval<std::int64_t>> ranges)
+
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline auto operator||(const ArCo& lhs, const T& rhs)
         {
-            return dst.copy_from(src, ranges);
+            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a || b; });
         }
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2& dst, std::initializer_list<Interval<std::int64_t>> ranges)
+
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator||(const T& lhs, const ArCo& rhs)
         {
-            return dst.copy_from(src, ranges);
+            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a || b; });
+        }
+
+        template <arrnd_complient ArCo>
+        inline auto& operator++(ArCo& arr)
+        {
+            if (empty(arr)) {
+                return arr;
+            }
+
+            for (typename ArCo::indexer_type gen(arr.header()); gen; ++gen) {
+                ++arr[*gen];
+            }
+            return arr;
         }
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& copy(const ArCo1& src, ArCo2&& dst, std::initializer_list<Interval<std::int64_t>> ranges)
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator++(ArCo&& arr)
         {
-            return dst.copy_from(src, ranges);
+            return operator++(arr);
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& set(const ArCo1& src, ArCo2& dst)
+        template <arrnd_complient ArCo>
+        inline auto operator++(ArCo& arr, int)
         {
-            return dst.set_from(src);
+            ArCo old = clone(arr);
+            operator++(arr);
+            return old;
         }
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& set(const ArCo1& src, ArCo2&& dst)
+
+        template <arrnd_complient ArCo>
+        [[nodiscard]] inline auto operator++(ArCo&& arr, int)
         {
-            return dst.set_from(src);
+            return operator++(arr, int{});
         }
 
-
         template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto clone(const ArCo& arr)
+        inline auto& operator--(ArCo& arr)
         {
-            return arr.clone();
+            if (empty(arr)) {
+                return arr;
+            }
+
+            for (typename ArCo::indexer_type gen(arr.header()); gen; ++gen) {
+                --arr[*gen];
+            }
+            return arr;
         }
 
-        /**
-        * @note Returning a reference to the input array, except in case of resulted empty array or an input subarray.
-        */
         template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto reshape(const ArCo& arr, std::span<const std::int64_t> new_dims)
+        [[nodiscard]] inline auto operator--(ArCo&& arr)
         {
-            return arr.reshape(new_dims);
+            return operator--(arr);
         }
+
         template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto reshape(const ArCo& arr, std::initializer_list<std::int64_t> new_dims)
+        inline auto operator--(ArCo& arr, int)
         {
-            return arr.reshape(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+            ArCo old = clone(arr);
+            operator--(arr);
+            return old;
         }
 
         template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto resize(const ArCo& arr, std::span<const std::int64_t> new_dims)
+        [[nodiscard]] inline auto operator--(ArCo&& arr, int)
         {
-            return arr.resize(new_dims);
+            return operator--(arr, int{});
         }
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto resize(const ArCo& arr, std::initializer_list<std::int64_t> new_dims)
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo1::value_type, typename ArCo2::value_type>
+        [[nodiscard]] inline bool all_match(const ArCo1& lhs, const ArCo2& rhs, Binary_pred pred)
         {
-            return arr.resize(std::span<const std::int64_t>(new_dims.begin(), new_dims.size()));
+            return lhs.all_match(rhs, pred);
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline ArCo1 append(const ArCo1& lhs, const ArCo2& rhs)
+        template <arrnd_complient ArCo, typename T, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo::value_type, T>
+        [[nodiscard]] inline bool all_match(const ArCo& lhs, const T& rhs, Binary_pred pred)
         {
-            return lhs.append(rhs);
+            return lhs.all_match(rhs, pred);
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline ArCo1 append(const ArCo1& lhs, const ArCo2& rhs, std::int64_t axis)
+        template <typename T, arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
+        [[nodiscard]] inline bool all_match(const T& lhs, const ArCo& rhs, Binary_pred pred)
         {
-            return lhs.append(rhs, axis);
+            return rhs.all_match([&lhs, &pred](const typename ArCo::value_type& value) { return pred(lhs, value); });
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline ArCo1 insert(const ArCo1& lhs, const ArCo2& rhs, std::int64_t ind)
+
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo1::value_type, typename ArCo2::value_type>
+        [[nodiscard]] inline bool any_match(const ArCo1& lhs, const ArCo2& rhs, Binary_pred pred)
         {
-            return lhs.insert(rhs, ind);
+            return lhs.any_match(rhs, pred);
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline ArCo1 insert(const ArCo1& lhs, const ArCo2& rhs, std::int64_t ind, std::int64_t axis)
+        template <arrnd_complient ArCo, typename T, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo::value_type, T>
+        [[nodiscard]] inline bool any_match(const ArCo& lhs, const T& rhs, Binary_pred pred)
         {
-            return lhs.insert(rhs, ind, axis);
+            return lhs.any_match(rhs, pred);
         }
 
-        /**
-        * @note All elements starting from ind are being removed in case that count value is too big.
-        */
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto remove(const ArCo& arr, std::int64_t ind, std::int64_t count)
+        template <typename T, arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
+        [[nodiscard]] inline bool any_match(const T& lhs, const ArCo& rhs, Binary_pred pred)
         {
-            return arr.remove(ind, count);
+            return rhs.any_match([&lhs, &pred](const typename ArCo::value_type& value) { return pred(lhs, value); });
         }
 
-        /**
-        * @note All elements starting from ind are being removed in case that count value is too big.
-        */
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto remove(const ArCo& arr, std::int64_t ind, std::int64_t count, std::int64_t axis)
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline bool all_equal(const ArCo1& lhs, const ArCo2& rhs)
         {
-            return arr.remove(ind, count, axis);
+            return lhs.all_equal(rhs);
         }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline bool empty(const ArCo& arr) noexcept
+        template <arrnd_complient ArCo, typename T>
+        [[nodiscard]] inline bool all_equal(const ArCo& lhs, const T& rhs)
         {
-            return !arr.data() && arr.header().empty();
+            return lhs.all_equal(rhs);
         }
 
-        template <arrnd_complient ArCo, typename Unary_op> requires std::is_invocable_v<Unary_op, typename ArCo::value_type>
-        [[nodiscard]] inline auto transform(const ArCo& arr, Unary_op&& op)
+        template <typename T, arrnd_complient ArCo>
+        [[nodiscard]] inline bool all_equal(const T& lhs, const ArCo& rhs)
         {
-            return arr.transform(op);
+            return rhs.all_equal(lhs);
         }
 
-        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
-        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op)
+        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
+        [[nodiscard]] inline bool all_close(const ArCo1& lhs, const ArCo2& rhs, const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& atol = default_atol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > (), const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& rtol = default_rtol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > ())
         {
-            return arr.reduce(op);
+            return lhs.all_close(rhs, atol, rtol);
         }
 
-        template <arrnd_complient ArCo, typename T, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
-        [[nodiscard]] inline auto reduce(const ArCo& arr, const T& init_value, Binary_op&& op)
+        template <arrnd_complient ArCo, typename T> requires (!arrnd_complient<T>)
+        [[nodiscard]] inline bool all_close(const ArCo& lhs, const T& rhs, const decltype(typename ArCo::value_type{} - T{})& atol = default_atol<decltype(typename ArCo::value_type{} - T{}) > (), const decltype(typename ArCo::value_type{} - T{})& rtol = default_rtol<decltype(typename ArCo::value_type{} - T{}) > ())
         {
-            return arr.reduce(init_value, op);
+            return lhs.all_close(rhs, atol, rtol);
         }
 
-        template <arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, typename ArCo::value_type>
-        [[nodiscard]] inline auto reduce(const ArCo& arr, Binary_op&& op, std::int64_t axis)
+        template <typename T, arrnd_complient ArCo> requires (!arrnd_complient<T>)
+        [[nodiscard]] inline bool all_close(const T& lhs, const ArCo& rhs, const decltype(T{} - typename ArCo::value_type{})& atol = default_atol<decltype(T{} - typename ArCo::value_type{}) > (), const decltype(T{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(T{} - typename ArCo::value_type{}) > ())
         {
-            return arr.reduce(op, axis);
+            return rhs.all_close(lhs, atol, rtol);
+        }
+    }
+
+    namespace details {
+
+        /**
+        * @return Array of op applied to the elements of a contiguous array, computed in parallel for large arrays.
+        */
+        template <arrnd_complient ArCo, typename Unary_op>
+        [[nodiscard]] inline auto transform_values(const ArCo& values, Unary_op& op)
+        {
+            using U = decltype(op(std::declval<const typename ArCo::value_type&>()));
+            using res_type = typename ArCo::template replaced_type<U>;
+
+            if (details::empty(values)) {
+                return res_type();
+            }
+
+            if (!values.header().is_contiguous()) {
+                return transform_values(values.clone(), op);
+            }
+
+            const std::int64_t count{ values.header().count() };
+            res_type res({ count });
+
+            const auto* src{ values.data() + values.header().offset() };
+            U* dst{ res.data() };
+
+            for_each_partition<typename ArCo::value_type, U>(count, count, [&](std::int64_t first, std::int64_t last) {
+                for (std::int64_t i = first; i < last; ++i) {
+                    dst[i] = op(src[i]);
+                }
+            });
+
+            return res;
         }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo2::value_type, typename ArCo1::value_type>
-        [[nodiscard]] inline auto reduce(const ArCo1& arr, const ArCo2& init_values, Binary_op&& op, std::int64_t axis)
-        {
-            return arr.reduce(init_values, op, axis);
-        }
+        /*
+        * Ragged array:
+        * =============
+        * Rows of varying lengths, stored as a single flat values array and an offsets array of (rows + 1) elements,
+        * such that row i consists of the values in [offsets[i], offsets[i + 1]).
+        * Rows are accessed as spans into the values buffer, and copies of a ragged array share both arrays (as arrnd does).
+        */
+
+        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator>
+        class arrnd_ragged {
+        public:
+            using value_type = T;
+            using size_type = std::int64_t;
+            using difference_type = std::int64_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
+
+            using values_type = arrnd<T, Storage, SharedRefAllocator>;
+            using offsets_type = arrnd<std::int64_t, typename Storage::template replaced_type<std::int64_t>, SharedRefAllocator>;
+
+            using this_type = arrnd_ragged<T, Storage, SharedRefAllocator>;
+            template <typename U>
+            using replaced_type = arrnd_ragged<U, typename Storage::template replaced_type<U>, SharedRefAllocator>;
+
+            arrnd_ragged() = default;
+
+            /**
+            * @param lengths Number of elements of each row.
+            * @param data Row major values of all rows (i.e. the flat values array), or nullptr for default initialized values.
+            */
+            explicit arrnd_ragged(std::span<const std::int64_t> lengths, const_pointer data = nullptr)
+                : offsets_({ std::ssize(lengths) + 1 })
+            {
+                std::int64_t* offsets{ offsets_.data() };
+                offsets[0] = 0;
+                for (std::int64_t i = 0; i < std::ssize(lengths); ++i) {
+                    offsets[i + 1] = offsets[i] + lengths[i];
+                }
+
+                if (offsets[std::ssize(lengths)] > 0) {
+                    values_ = values_type({ offsets[std::ssize(lengths)] }, data);
+                }
+            }
+            explicit arrnd_ragged(std::span<const std::int64_t> lengths, std::initializer_list<value_type> data)
+                : arrnd_ragged(lengths, data.begin())
+            {
+            }
+            explicit arrnd_ragged(std::initializer_list<std::int64_t> lengths, const_pointer data = nullptr)
+                : arrnd_ragged(std::span<const std::int64_t>(lengths.begin(), lengths.size()), data)
+            {
+            }
+            explicit arrnd_ragged(std::initializer_list<std::int64_t> lengths, std::initializer_list<value_type> data)
+                : arrnd_ragged(std::span<const std::int64_t>(lengths.begin(), lengths.size()), data.begin())
+            {
+            }
+
+            /**
+            * @note No copy is made, the ragged array shares the values and offsets buffers.
+            */
+            explicit arrnd_ragged(const values_type& values, const offsets_type& offsets)
+                : values_(values), offsets_(offsets)
+            {
+            }
+
+            /**
+            * @note Flattens an array of arrays, each inner array (in iteration order) is a row.
+            */
+            template <arrnd_complient ArCo> requires arrnd_complient<typename ArCo::value_type>
+            explicit arrnd_ragged(const ArCo& nested)
+            {
+                if (details::empty(nested)) {
+                    return;
+                }
+
+                offsets_ = offsets_type({ nested.header().count() + 1 });
+                std::int64_t* offsets{ offsets_.data() };
+                offsets[0] = 0;
+
+                std::int64_t i{ 0 };
+                for (typename ArCo::indexer_type gen(nested.header()); gen; ++gen, ++i) {
+                    offsets[i + 1] = offsets[i] + nested[*gen].header().count();
+                }
+
+                if (offsets[i] == 0) {
+                    return;
+                }
+
+                values_ = values_type({ offsets[i] });
+                pointer values{ values_.data() };
+                for (typename ArCo::indexer_type gen(nested.header()); gen; ++gen) {
+                    const auto& row = nested[*gen];
+                    if (!details::empty(row)) {
+                        for (typename ArCo::value_type::indexer_type row_gen(row.header()); row_gen; ++row_gen) {
+                            *values++ = row[*row_gen];
+                        }
+                    }
+                }
+            }
+
+            [[nodiscard]] std::int64_t rows() const noexcept
+            {
+                return details::empty(offsets_) ? 0 : offsets_.header().count() - 1;
+            }
+
+            /**
+            * @return Total number of values of all rows.
+            */
+            [[nodiscard]] std::int64_t count() const noexcept
+            {
+                return details::empty(offsets_) ? 0 : offsets_.data()[rows()];
+            }
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return rows() == 0;
+            }
+
+            [[nodiscard]] const values_type& values() const noexcept
+            {
+                return values_;
+            }
+
+            [[nodiscard]] const offsets_type& offsets() const noexcept
+            {
+                return offsets_;
+            }
+
+            [[nodiscard]] pointer data() const noexcept
+            {
+                return values_.data();
+            }
+
+            [[nodiscard]] std::int64_t row_size(std::int64_t row) const noexcept
+            {
+                return offsets_.data()[row + 1] - offsets_.data()[row];
+            }
+
+            [[nodiscard]] std::span<const value_type> operator[](std::int64_t row) const noexcept
+            {
+                return std::span<const value_type>(data() + offsets_.data()[row], row_size(row));
+            }
+            [[nodiscard]] std::span<value_type> operator[](std::int64_t row) noexcept
+            {
+                return std::span<value_type>(data() + offsets_.data()[row], row_size(row));
+            }
+
+            /**
+            * @note The result shares the offsets array of this ragged array. Large arrays are transformed in parallel.
+            */
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            [[nodiscard]] auto transform(Unary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>()));
+
+                return replaced_type<U>(transform_values(values_, op), offsets_);
+            }
+
+            /**
+            * @return Array of the reduction of each row. An empty row is reduced to a default constructed value.
+            * @note Large arrays are reduced in parallel by rows.
+            */
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>(), std::declval<const_reference>()));
+
+                return reduce_rows<U>([&op](std::span<const value_type> row) {
+                    if (row.empty()) {
+                        return U{};
+                    }
+                    U res{ static_cast<U>(row[0]) };
+                    for (std::int64_t i = 1; i < std::ssize(row); ++i) {
+                        res = op(res, row[i]);
+                    }
+                    return res;
+                });
+            }
+
+            template <typename U, typename Binary_op> requires std::is_invocable_v<Binary_op, U, T>
+            [[nodiscard]] auto reduce(const U& init_value, Binary_op&& op) const
+            {
+                using V = decltype(op(init_value, std::declval<const_reference>()));
+
+                return reduce_rows<V>([&op, &init_value](std::span<const value_type> row) {
+                    V res{ init_value };
+                    for (const auto& value : row) {
+                        res = op(res, value);
+                    }
+                    return res;
+                });
+            }
+
+        private:
+            template <typename U, typename Row_op>
+            [[nodiscard]] auto reduce_rows(Row_op&& row_op) const
+            {
+                using res_type = typename values_type::template replaced_type<U>;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline bool all(const ArCo& arr)
-        {
-            return arr.all();
-        }
+                if (empty()) {
+                    return res_type();
+                }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto all(const ArCo& arr, std::int64_t axis)
-        {
-            return arr.all(axis);
-        }
+                res_type res({ rows() });
+                U* dst{ res.data() };
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline bool any(const ArCo& arr)
-        {
-            return arr.any();
-        }
+                for_each_partition(rows(), count(), [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t i = first; i < last; ++i) {
+                        dst[i] = row_op((*this)[i]);
+                    }
+                });
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto any(const ArCo& arr, std::int64_t axis)
-        {
-            return arr.any(axis);
-        }
+                return res;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo1::value_type, typename ArCo2::value_type>
-        [[nodiscard]] inline auto transform(const ArCo1& lhs, const ArCo2& rhs, Binary_op&& op)
-        {
-            return lhs.transform(rhs, op);
-        }
+            values_type values_{};
+            offsets_type offsets_{};
+        };
+    }
 
-        template <arrnd_complient ArCo, typename T, typename Binary_op> requires std::is_invocable_v<Binary_op, typename ArCo::value_type, T>
-        [[nodiscard]] inline auto transform(const ArCo& lhs, const T& rhs, Binary_op&& op)
-        {
-            return lhs.transform(rhs, op);
-        }
+    namespace details {
 
-        template <typename T, arrnd_complient ArCo, typename Binary_op> requires std::is_invocable_v<Binary_op, T, typename ArCo::value_type>
-        [[nodiscard]] inline auto transform(const T& lhs, const ArCo& rhs, Binary_op&& op)
-        {
-            return rhs.transform([&lhs, &op](const typename ArCo::value_type& value) { return op(lhs, value); });
-        }
+        /*
+        * Sparse matrices:
+        * ================
+        * Two dimensional matrices that store only their nonzero elements.
+        *
+        * arrnd_coo - coordinate format, (row, column, value) triplets in any order. Suitable for incremental construction.
+        * arrnd_csr - compressed sparse row format, the columns and values of row i are in [row_offsets[i], row_offsets[i + 1]).
+        *             Suitable for arithmetic.
+        *
+        * Element wise operations are applied to the stored elements only, and therefore should map zero to zero.
+        */
 
-        template <arrnd_complient ArCo, typename Unary_pred> requires std::is_invocable_v<Unary_pred, typename ArCo::value_type>
-        [[nodiscard]] inline auto filter(const ArCo& arr, Unary_pred pred)
-        {
-            return arr.filter(pred);
-        }
+        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator>
+        class arrnd_csr;
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline ArCo1 filter(const ArCo1& arr, const ArCo2& mask)
-        {
-            return arr.filter(mask);
-        }
+        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator>
+        class arrnd_coo {
+        public:
+            using value_type = T;
+            using size_type = std::int64_t;
+            using difference_type = std::int64_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
 
-        template <arrnd_complient ArCo, typename Unary_pred> requires std::is_invocable_v<Unary_pred, typename ArCo::value_type>
-        [[nodiscard]] inline auto find(const ArCo& arr, Unary_pred pred)
-        {
-            return arr.find(pred);
-        }
+            using values_type = arrnd<T, Storage, SharedRefAllocator>;
+            using indices_type = arrnd<std::int64_t, typename Storage::template replaced_type<std::int64_t>, SharedRefAllocator>;
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto find(const ArCo1& arr, const ArCo2& mask)
-        {
-            return arr.find(mask);
-        }
+            using this_type = arrnd_coo<T, Storage, SharedRefAllocator>;
+            template <typename U>
+            using replaced_type = arrnd_coo<U, typename Storage::template replaced_type<U>, SharedRefAllocator>;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto transpose(const ArCo& arr, std::span<const std::int64_t> order)
-        {
-            return arr.transpose(order);
-        }
+            arrnd_coo() = default;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto transpose(const ArCo& arr, std::initializer_list<std::int64_t> order)
-        {
-            return arr.transpose(order);
-        }
+            /**
+            * @note No copy is made. Repeated coordinates are allowed, and their values are accumulated on conversion.
+            */
+            explicit arrnd_coo(std::int64_t rows, std::int64_t cols, const indices_type& row_indices, const indices_type& col_indices, const values_type& values)
+                : rows_(rows), cols_(cols), row_indices_(row_indices), col_indices_(col_indices), values_(values)
+            {
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator==(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a == b; });
-        }
+            /**
+            * @note The nonzero elements (the ones that find(value != 0) would return) of a two dimensional array, in iteration order.
+            */
+            template <arrnd_complient ArCo>
+            explicit arrnd_coo(const ArCo& dense)
+            {
+                if (details::empty(dense) || std::ssize(dense.header().dims()) != 2) {
+                    return;
+                }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator==(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a == b; });
-        }
+                rows_ = dense.header().dims()[0];
+                cols_ = dense.header().dims()[1];
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator==(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a == b; });
-        }
+                std::int64_t nnz{ 0 };
+                for (typename ArCo::indexer_type gen(dense.header()); gen; ++gen) {
+                    nnz += dense[*gen] != typename ArCo::value_type{};
+                }
+                if (nnz == 0) {
+                    return;
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator!=(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a != b; });
-        }
+                row_indices_ = indices_type({ nnz });
+                col_indices_ = indices_type({ nnz });
+                values_ = values_type({ nnz });
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator!=(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a != b; });
-        }
+                std::int64_t pos{ 0 };
+                std::int64_t i{ 0 };
+                for (typename ArCo::indexer_type gen(dense.header()); gen; ++gen, ++i) {
+                    if (dense[*gen] != typename ArCo::value_type{}) {
+                        row_indices_.data()[pos] = i / cols_;
+                        col_indices_.data()[pos] = i % cols_;
+                        values_.data()[pos] = dense[*gen];
+                        ++pos;
+                    }
+                }
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator!=(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a != b; });
-        }
+            [[nodiscard]] std::int64_t rows() const noexcept
+            {
+                return rows_;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto close(const ArCo1& lhs, const ArCo2& rhs, const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& atol = default_atol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > (), const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& rtol = default_rtol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > ())
-        {
-            return lhs.close(rhs, atol, rtol);
-        }
+            [[nodiscard]] std::int64_t cols() const noexcept
+            {
+                return cols_;
+            }
 
-        template <arrnd_complient ArCo, typename T> requires (!arrnd_complient<T>)
-        [[nodiscard]] inline auto close(const ArCo& lhs, const T& rhs, const decltype(typename ArCo::value_type{} - T{})& atol = default_atol<decltype(typename ArCo::value_type{} - T{}) > (), const decltype(typename ArCo::value_type{} - T{})& rtol = default_rtol<decltype(typename ArCo::value_type{} - T{}) > ())
-        {
-            return lhs.close(rhs, atol, rtol);
-        }
+            /**
+            * @return Number of stored elements.
+            */
+            [[nodiscard]] std::int64_t nnz() const noexcept
+            {
+                return details::empty(values_) ? 0 : values_.header().count();
+            }
 
-        template <typename T, arrnd_complient ArCo> requires (!arrnd_complient<T>)
-        [[nodiscard]] inline auto close(const T& lhs, const ArCo& rhs, const decltype(T{} - typename ArCo::value_type{})& atol = default_atol<decltype(T{} - typename ArCo::value_type{}) > (), const decltype(T{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(T{} - typename ArCo::value_type{}) > ())
-        {
-            return rhs.close(lhs, atol, rtol);
-        }
+            [[nodiscard]] const indices_type& row_indices() const noexcept
+            {
+                return row_indices_;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator>(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a > b; });
-        }
+            [[nodiscard]] const indices_type& col_indices() const noexcept
+            {
+                return col_indices_;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator>(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a > b; });
-        }
+            [[nodiscard]] const values_type& values() const noexcept
+            {
+                return values_;
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator>(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a > b; });
-        }
+            [[nodiscard]] values_type to_dense() const
+            {
+                if (rows_ == 0 || cols_ == 0) {
+                    return values_type();
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator>=(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >= b; });
-        }
+                values_type res({ rows_, cols_ }, T{});
+                for (std::int64_t k = 0; k < nnz(); ++k) {
+                    res.data()[row_indices_.data()[k] * cols_ + col_indices_.data()[k]] += values_.data()[k];
+                }
+                return res;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator>=(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >= b; });
-        }
+            [[nodiscard]] auto to_csr() const
+            {
+                return arrnd_csr<T, Storage, SharedRefAllocator>(*this);
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator>=(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a >= b; });
-        }
+            /**
+            * @note The result shares the coordinates arrays of this matrix.
+            */
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            [[nodiscard]] auto transform(Unary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator<(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a < b; });
-        }
+                return replaced_type<U>(rows_, cols_, row_indices_, col_indices_, transform_values(values_, op));
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator<(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a < b; });
-        }
+            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
+            [[nodiscard]] auto transform(const V& value, Binary_op&& op) const
+            {
+                return transform([&value, &op](const_reference element) {
+                    return op(element, value);
+                });
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator<(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a < b; });
-        }
+        private:
+            std::int64_t rows_{ 0 };
+            std::int64_t cols_{ 0 };
+            indices_type row_indices_{};
+            indices_type col_indices_{};
+            values_type values_{};
+        };
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator<=(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a <= b; });
-        }
+        template <typename T, typename Storage, template<typename> typename SharedRefAllocator>
+        class arrnd_csr {
+        public:
+            using value_type = T;
+            using size_type = std::int64_t;
+            using difference_type = std::int64_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator<=(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a <= b; });
-        }
+            using values_type = arrnd<T, Storage, SharedRefAllocator>;
+            using indices_type = arrnd<std::int64_t, typename Storage::template replaced_type<std::int64_t>, SharedRefAllocator>;
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator<=(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a <= b; });
-        }
+            using this_type = arrnd_csr<T, Storage, SharedRefAllocator>;
+            template <typename U>
+            using replaced_type = arrnd_csr<U, typename Storage::template replaced_type<U>, SharedRefAllocator>;
+
+            arrnd_csr() = default;
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator+(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a + b; });
-        }
+            /**
+            * @note No copy is made.
+            */
+            explicit arrnd_csr(std::int64_t rows, std::int64_t cols, const indices_type& row_offsets, const indices_type& col_indices, const values_type& values)
+                : rows_(rows), cols_(cols), row_offsets_(row_offsets), col_indices_(col_indices), values_(values)
+            {
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator+(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a + b; });
-        }
+            /**
+            * @note Elements are sorted by rows with a counting sort. Within a row, the coordinates order is kept and repeated coordinates are not merged.
+            */
+            explicit arrnd_csr(const arrnd_coo<T, Storage, SharedRefAllocator>& coo)
+                : rows_(coo.rows()), cols_(coo.cols())
+            {
+                if (rows_ == 0) {
+                    return;
+                }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator+(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a + b; });
-        }
+                const std::int64_t nnz{ coo.nnz() };
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator+=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a + b; });
-        }
+                row_offsets_ = indices_type({ rows_ + 1 }, std::int64_t{ 0 });
+                std::int64_t* offsets{ row_offsets_.data() };
+                for (std::int64_t k = 0; k < nnz; ++k) {
+                    ++offsets[coo.row_indices().data()[k] + 1];
+                }
+                std::partial_sum(offsets, offsets + rows_ + 1, offsets);
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator+=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a + b; });
-        }
+                if (nnz == 0) {
+                    return;
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator-(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a - b; });
-        }
+                col_indices_ = indices_type({ nnz });
+                values_ = values_type({ nnz });
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator-(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a - b; });
-        }
+                indices_type positions({ rows_ });
+                std::copy_n(offsets, rows_, positions.data());
+                for (std::int64_t k = 0; k < nnz; ++k) {
+                    std::int64_t pos{ positions.data()[coo.row_indices().data()[k]]++ };
+                    col_indices_.data()[pos] = coo.col_indices().data()[k];
+                    values_.data()[pos] = coo.values().data()[k];
+                }
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator-(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a - b; });
-        }
+            template <arrnd_complient ArCo>
+            explicit arrnd_csr(const ArCo& dense)
+                : arrnd_csr(arrnd_coo<T, Storage, SharedRefAllocator>(dense))
+            {
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator-=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a - b; });
-        }
+            [[nodiscard]] std::int64_t rows() const noexcept
+            {
+                return rows_;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator-=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a - b; });
-        }
+            [[nodiscard]] std::int64_t cols() const noexcept
+            {
+                return cols_;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator*(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a * b; });
-        }
+            /**
+            * @return Number of stored elements.
+            */
+            [[nodiscard]] std::int64_t nnz() const noexcept
+            {
+                return details::empty(values_) ? 0 : values_.header().count();
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator*(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a * b; });
-        }
+            [[nodiscard]] const indices_type& row_offsets() const noexcept
+            {
+                return row_offsets_;
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator*(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a * b; });
-        }
+            [[nodiscard]] const indices_type& col_indices() const noexcept
+            {
+                return col_indices_;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator*=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a * b; });
-        }
+            [[nodiscard]] const values_type& values() const noexcept
+            {
+                return values_;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator*=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a * b; });
-        }
+            [[nodiscard]] values_type to_dense() const
+            {
+                return to_coo().to_dense();
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator/(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a / b; });
-        }
+            [[nodiscard]] auto to_coo() const
+            {
+                using coo_type = arrnd_coo<T, Storage, SharedRefAllocator>;
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator/(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a / b; });
-        }
+                if (nnz() == 0) {
+                    return coo_type(rows_, cols_, indices_type{}, indices_type{}, values_type{});
+                }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator/(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a / b; });
-        }
+                indices_type row_indices({ nnz() });
+                for (std::int64_t i = 0; i < rows_; ++i) {
+                    std::fill(row_indices.data() + row_offsets_.data()[i], row_indices.data() + row_offsets_.data()[i + 1], i);
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator/=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a / b; });
-        }
+                return coo_type(rows_, cols_, row_indices, col_indices_, values_);
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator/=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a / b; });
-        }
+            /**
+            * @note The result shares the structure arrays of this matrix.
+            */
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            [[nodiscard]] auto transform(Unary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto operator%(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a % b; });
-        }
+                return replaced_type<U>(rows_, cols_, row_offsets_, col_indices_, transform_values(values_, op));
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator%(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a % b; });
-        }
+            template <typename V, typename Binary_op> requires std::is_invocable_v<Binary_op, T, V>
+            [[nodiscard]] auto transform(const V& value, Binary_op&& op) const
+            {
+                return transform([&value, &op](const_reference element) {
+                    return op(element, value);
+                });
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator%(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a % b; });
-        }
+            /**
+            * @return Array of the reduction of the stored elements of each row. A row without stored elements is reduced to a default constructed value.
+            */
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>(), std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator%=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a % b; });
-        }
+                return reduce_rows<U>([&op](const_pointer first, const_pointer last) {
+                    if (first == last) {
+                        return U{};
+                    }
+                    U res{ static_cast<U>(*first) };
+                    for (++first; first != last; ++first) {
+                        res = op(res, *first);
+                    }
+                    return res;
+                });
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator%=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a % b; });
-        }
+            template <typename U, typename Binary_op> requires std::is_invocable_v<Binary_op, U, T>
+            [[nodiscard]] auto reduce(const U& init_value, Binary_op&& op) const
+            {
+                using V = decltype(op(init_value, std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator^(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a ^ b; });
-        }
+                return reduce_rows<V>([&op, &init_value](const_pointer first, const_pointer last) {
+                    V res{ init_value };
+                    for (; first != last; ++first) {
+                        res = op(res, *first);
+                    }
+                    return res;
+                });
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator^(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a ^ b; });
-        }
+            /**
+            * @return Matrix-vector product for a vector of cols() elements, or matrix-matrix product for a (cols() x n) matrix.
+            * Empty array for other dimensions.
+            * @note Rows are computed in parallel for large products.
+            */
+            template <arrnd_complient ArCo>
+            [[nodiscard]] auto dot(const ArCo& arr) const
+            {
+                using U = decltype(std::declval<const_reference>() * std::declval<const typename ArCo::value_type&>());
+                using res_type = typename values_type::template replaced_type<U>;
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator^(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a ^ b; });
-        }
+                const std::int64_t ndims{ details::empty(arr) ? 0 : std::ssize(arr.header().dims()) };
+                if (rows_ == 0 || ndims < 1 || ndims > 2 || arr.header().dims()[0] != cols_) {
+                    return res_type();
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator^=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a ^ b; });
-        }
+                // the dense operand is accessed by rows, which requires a contiguous buffer
+                ArCo dense{ arr };
+                if (!dense.header().is_contiguous()) {
+                    dense = arr.clone();
+                }
+                const auto* x{ dense.data() + dense.header().offset() };
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator^=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a ^ b; });
-        }
+                const std::int64_t* offsets{ row_offsets_.data() };
+                const std::int64_t* cols{ col_indices_.data() };
+                const_pointer values{ values_.data() };
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator&(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a & b; });
-        }
+                if (ndims == 1) {
+                    res_type res({ rows_ });
+                    U* y{ res.data() };
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator&(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a & b; });
-        }
+                    for_each_partition(rows_, nnz(), [&](std::int64_t first, std::int64_t last) {
+                        for (std::int64_t i = first; i < last; ++i) {
+                            y[i] = row_dot<U>(values, cols, offsets[i], offsets[i + 1], x);
+                        }
+                    });
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator&(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a & b; });
-        }
+                    return res;
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator&=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a & b; });
-        }
+                const std::int64_t n{ arr.header().dims()[1] };
+                res_type res({ rows_, n }, U{});
+                U* y{ res.data() };
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator&=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a & b; });
-        }
+                for_each_partition(rows_, nnz() * n, [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t i = first; i < last; ++i) {
+                        U* y_row{ y + i * n };
+                        for (std::int64_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                            const T value{ values[k] };
+                            const auto* x_row{ x + cols[k] * n };
+                            for (std::int64_t j = 0; j < n; ++j) {
+                                y_row[j] += value * x_row[j];
+                            }
+                        }
+                    }
+                });
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator|(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a | b; });
-        }
+                return res;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator|(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a | b; });
-        }
+        private:
+            /**
+            * @note Gathered products are accumulated by independent lanes.
+            */
+            template <typename U, typename X>
+            [[nodiscard]] static U row_dot(const_pointer values, const std::int64_t* cols, std::int64_t first, std::int64_t last, const X* x) noexcept
+            {
+                constexpr std::int64_t lanes = 4;
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator|(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a | b; });
-        }
+                U acc[lanes]{};
+                std::int64_t k = first;
+                for (; k + lanes <= last; k += lanes) {
+                    for (std::int64_t j = 0; j < lanes; ++j) {
+                        acc[j] += values[k + j] * x[cols[k + j]];
+                    }
+                }
+                for (; k < last; ++k) {
+                    acc[0] += values[k] * x[cols[k]];
+                }
+                return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator|=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a | b; });
-        }
+            template <typename U, typename Row_op>
+            [[nodiscard]] auto reduce_rows(Row_op&& row_op) const
+            {
+                using res_type = typename values_type::template replaced_type<U>;
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator|=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a | b; });
-        }
+                if (rows_ == 0) {
+                    return res_type();
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator<<(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a << b; });
-        }
+                res_type res({ rows_ });
+                U* dst{ res.data() };
+                const std::int64_t* offsets{ row_offsets_.data() };
+                const_pointer values{ values_.data() };
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator<<(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a << b; });
-        }
+                for_each_partition(rows_, nnz(), [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t i = first; i < last; ++i) {
+                        dst[i] = row_op(values + offsets[i], values + offsets[i + 1]);
+                    }
+                });
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator<<(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a << b; });
-        }
+                return res;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator<<=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a << b; });
-        }
+            std::int64_t rows_{ 0 };
+            std::int64_t cols_{ 0 };
+            indices_type row_offsets_{};
+            indices_type col_indices_{};
+            values_type values_{};
+        };
+    }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator<<=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a << b; });
-        }
+    namespace details {
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator>>(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >> b; });
-        }
+        /*
+        * Tiled array:
+        * ============
+        * N-dimensional array that is stored by fixed size N-dimensional tiles.
+        * The tiles are stored contiguously one after the other, in row major order of the tiles grid,
+        * and the elements of each tile are stored in row major order.
+        * Tiles on the upper edges are padded to the full tile size, so that all the tiles have the same strides.
+        *
+        * Example:
+        * --------
+        * D = {3, 5}, tile dims = {2, 2} => grid dims = {2, 3}, tile size = 4
+        *
+        * Elements (by subscripts):     Buffer (by tiles):
+        * 00 01 | 02 03 | 04            {00 01 10 11} {02 03 12 13} {04 -- 14 --}
+        * 10 11 | 12 13 | 14            {20 21 -- --} {22 23 -- --} {24 -- -- --}
+        * ------+-------+---
+        * 20 21 | 22 23 | 24
+        *
+        * A window, a row or a column of a large matrix then spans a few tiles, instead of a cache line (and a page) per element.
+        */
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator>>(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >> b; });
-        }
+        /**
+        * @note Iterates the buffer indices of the elements of a tiled array tile by tile. Padding elements are skipped.
+        */
+        template <typename Storage = simple_dynamic_vector<std::int64_t>>
+        class arrnd_tiled_indexer final {
+        public:
+            using storage_type = Storage;
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator>>(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a >> b; });
-        }
+            constexpr arrnd_tiled_indexer(std::span<const std::int64_t> dims, std::span<const std::int64_t> tile_dims)
+                : dims_(dims.begin(), dims.end()), tile_dims_(tile_dims.begin(), tile_dims.end())
+                , grid_subs_(std::ssize(dims)), local_subs_(std::ssize(dims)), extents_(std::ssize(dims)), tile_strides_(std::ssize(dims))
+            {
+                ndims_ = std::ssize(dims);
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        inline auto& operator>>=(ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a >> b; });
-        }
+                num_tiles_ = ndims_ > 0 && std::ssize(tile_dims) == ndims_ ? 1 : 0;
+                for (std::int64_t i = ndims_ - 1; i >= 0 && num_tiles_ > 0; --i) {
+                    if (dims_[i] <= 0 || tile_dims_[i] <= 0) {
+                        num_tiles_ = 0;
+                        break;
+                    }
+                    tile_strides_[i] = tile_size_;
+                    tile_size_ *= tile_dims_[i];
+                    num_tiles_ *= (dims_[i] + tile_dims_[i] - 1) / tile_dims_[i];
+                }
 
-        template <arrnd_complient ArCo, typename T>
-        inline auto& operator>>=(ArCo& lhs, const T& rhs)
-        {
-            return lhs.apply(rhs, [](const typename ArCo::value_type& a, const T& b) { return a >> b; });
-        }
+                std::fill(grid_subs_.begin(), grid_subs_.end(), 0);
+                std::fill(local_subs_.begin(), local_subs_.end(), 0);
+                if (num_tiles_ > 0) {
+                    update_extents();
+                }
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator~(const ArCo& arr)
-        {
-            return arr.transform([](const typename ArCo::value_type& a) { return ~a; });
-        }
+            constexpr arrnd_tiled_indexer() = default;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator!(const ArCo& arr)
-        {
-            return arr.transform([](const typename ArCo::value_type& a) { return !a; });
-        }
+            constexpr arrnd_tiled_indexer& operator++() noexcept
+            {
+                if (tile_ind_ >= num_tiles_) {
+                    return *this;
+                }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator+(const ArCo& arr)
-        {
-            return arr.transform([](const typename ArCo::value_type& a) { return +a; });
-        }
+                for (std::int64_t i = ndims_ - 1; i >= 0; --i) {
+                    if (++local_subs_[i] < extents_[i]) {
+                        local_offset_ += tile_strides_[i];
+                        return *this;
+                    }
+                    local_offset_ -= (extents_[i] - 1) * tile_strides_[i];
+                    local_subs_[i] = 0;
+                }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator-(const ArCo& arr)
-        {
-            return arr.transform([](const typename ArCo::value_type& a) { return -a; });
-        }
+                ++tile_ind_;
+                for (std::int64_t i = ndims_ - 1; i >= 0; --i) {
+                    if (++grid_subs_[i] * tile_dims_[i] < dims_[i]) {
+                        break;
+                    }
+                    grid_subs_[i] = 0;
+                }
+                if (tile_ind_ < num_tiles_) {
+                    update_extents();
+                }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto abs(const ArCo& arr)
-        {
-            return arr.abs();
-        }
+                return *this;
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto acos(const ArCo& arr)
-        {
-            return arr.acos();
-        }
+            constexpr arrnd_tiled_indexer operator++(int) noexcept
+            {
+                arrnd_tiled_indexer temp{ *this };
+                ++(*this);
+                return temp;
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto acosh(const ArCo& arr)
-        {
-            return arr.acosh();
-        }
+            [[nodiscard]] explicit constexpr operator bool() const noexcept
+            {
+                return tile_ind_ < num_tiles_;
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto asin(const ArCo& arr)
-        {
-            return arr.asin();
-        }
+            [[nodiscard]] constexpr std::int64_t operator*() const noexcept
+            {
+                return tile_ind_ * tile_size_ + local_offset_;
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto asinh(const ArCo& arr)
-        {
-            return arr.asinh();
-        }
+            /**
+            * @return Subscript of the current element along axis.
+            */
+            [[nodiscard]] constexpr std::int64_t sub(std::int64_t axis) const noexcept
+            {
+                return grid_subs_[axis] * tile_dims_[axis] + local_subs_[axis];
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto atan(const ArCo& arr)
-        {
-            return arr.atan();
-        }
+        private:
+            constexpr void update_extents() noexcept
+            {
+                for (std::int64_t i = 0; i < ndims_; ++i) {
+                    extents_[i] = std::min(tile_dims_[i], dims_[i] - grid_subs_[i] * tile_dims_[i]);
+                }
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto atanh(const ArCo& arr)
-        {
-            return arr.atanh();
-        }
+            storage_type dims_;
+            storage_type tile_dims_;
+            storage_type grid_subs_;
+            storage_type local_subs_;
+            storage_type extents_;
+            storage_type tile_strides_;
+
+            std::int64_t ndims_{ 0 };
+            std::int64_t tile_size_{ 1 };
+            std::int64_t num_tiles_{ 0 };
+
+            std::int64_t tile_ind_{ 0 };
+            std::int64_t local_offset_{ 0 };
+        };
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto cos(const ArCo& arr)
-        {
-            return arr.cos();
-        }
+        template <typename T, typename Storage = simple_dynamic_vector<T>, template<typename> typename SharedRefAllocator = lightweight_allocator>
+        class arrnd_tiled {
+        public:
+            using value_type = T;
+            using size_type = std::int64_t;
+            using difference_type = std::int64_t;
+            using reference = T&;
+            using const_reference = const T&;
+            using pointer = T*;
+            using const_pointer = const T*;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto cosh(const ArCo& arr)
-        {
-            return arr.cosh();
-        }
+            using values_type = arrnd<T, Storage, SharedRefAllocator>;
+            using dims_storage_type = typename values_type::header_type::storage_type;
+            using indexer_type = arrnd_tiled_indexer<dims_storage_type>;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto exp(const ArCo& arr)
-        {
-            return arr.exp();
-        }
-        
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto log(const ArCo& arr)
-        {
-            return arr.log();
-        }
+            using this_type = arrnd_tiled<T, Storage, SharedRefAllocator>;
+            template <typename U>
+            using replaced_type = arrnd_tiled<U, typename Storage::template replaced_type<U>, SharedRefAllocator>;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto log10(const ArCo& arr)
-        {
-            return arr.log10();
-        }
+            arrnd_tiled() = default;
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto pow(const ArCo& arr)
-        {
-            return arr.pow();
-        }
+            /**
+            * @note An empty array is created if the number of tile dimensions is different from the number of dimensions, or if any dimension is not positive.
+            */
+            explicit arrnd_tiled(std::span<const std::int64_t> dims, std::span<const std::int64_t> tile_dims, const_reference value = value_type{})
+            {
+                if (!init_layout(dims, tile_dims)) {
+                    return;
+                }
+                values_ = values_type({ num_tiles_ * tile_size_ }, value);
+            }
+            explicit arrnd_tiled(std::initializer_list<std::int64_t> dims, std::initializer_list<std::int64_t> tile_dims, const_reference value = value_type{})
+                : arrnd_tiled(std::span<const std::int64_t>(dims.begin(), dims.size()), std::span<const std::int64_t>(tile_dims.begin(), tile_dims.size()), value)
+            {
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto sin(const ArCo& arr)
-        {
-            return arr.sin();
-        }
+            /**
+            * @note Copies the elements of an array (or subarray) into tiles of tile_dims.
+            */
+            template <arrnd_complient ArCo>
+            explicit arrnd_tiled(const ArCo& arr, std::span<const std::int64_t> tile_dims)
+            {
+                if (details::empty(arr) || !init_layout(std::span<const std::int64_t>(arr.header().dims().data(), arr.header().dims().size()), tile_dims)) {
+                    return;
+                }
+                values_ = values_type({ num_tiles_ * tile_size_ });
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto sinh(const ArCo& arr)
-        {
-            return arr.sinh();
-        }
+                pointer dst{ values_.data() };
+                const std::int64_t stride{ arr.header().strides()[ndims() - 1] };
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto sqrt(const ArCo& arr)
-        {
-            return arr.sqrt();
-        }
+                for_each_partition(num_tiles_, count(), [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t tile = first; tile < last; ++tile) {
+                        for_each_tile_run(tile, [&](std::int64_t index, std::span<const std::int64_t> subs, std::int64_t length) {
+                            const std::int64_t src_index{ dense_index(arr.header(), subs) };
+                            for (std::int64_t j = 0; j < length; ++j) {
+                                dst[index + j] = arr[src_index + j * stride];
+                            }
+                        });
+                    }
+                });
+            }
+            template <arrnd_complient ArCo>
+            explicit arrnd_tiled(const ArCo& arr, std::initializer_list<std::int64_t> tile_dims)
+                : arrnd_tiled(arr, std::span<const std::int64_t>(tile_dims.begin(), tile_dims.size()))
+            {
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto tan(const ArCo& arr)
-        {
-            return arr.tan();
-        }
+            [[nodiscard]] std::span<const std::int64_t> dims() const noexcept
+            {
+                return std::span<const std::int64_t>(dims_.data(), dims_.size());
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto tanh(const ArCo& arr)
-        {
-            return arr.tanh();
-        }
+            [[nodiscard]] std::span<const std::int64_t> tile_dims() const noexcept
+            {
+                return std::span<const std::int64_t>(tile_dims_.data(), tile_dims_.size());
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator&&(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a && b; });
-        }
+            [[nodiscard]] std::int64_t ndims() const noexcept
+            {
+                return std::ssize(dims_);
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator&&(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a && b; });
-        }
+            /**
+            * @return Number of elements, excluding padding.
+            */
+            [[nodiscard]] std::int64_t count() const noexcept
+            {
+                return empty() ? 0 : std::accumulate(dims().begin(), dims().end(), std::int64_t{ 1 }, std::multiplies<>{});
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator&&(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a && b; });
-        }
+            [[nodiscard]] std::int64_t num_tiles() const noexcept
+            {
+                return num_tiles_;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline auto operator||(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo1::value_type& a, const typename ArCo2::value_type& b) { return a || b; });
-        }
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return num_tiles_ == 0;
+            }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline auto operator||(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.transform(rhs, [](const typename ArCo::value_type& a, const T& b) { return a || b; });
-        }
+            [[nodiscard]] pointer data() const noexcept
+            {
+                return values_.data();
+            }
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator||(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.transform(lhs, [](const typename ArCo::value_type& b, const T& a) { return a || b; });
-        }
+            [[nodiscard]] indexer_type indexer() const
+            {
+                return indexer_type(dims(), tile_dims());
+            }
 
-        template <arrnd_complient ArCo>
-        inline auto& operator++(ArCo& arr)
-        {
-            if (empty(arr)) {
-                return arr;
+            [[nodiscard]] const_reference operator[](std::span<const std::int64_t> subs) const noexcept
+            {
+                return data()[index_of(subs)];
+            }
+            [[nodiscard]] const_reference operator[](std::initializer_list<std::int64_t> subs) const noexcept
+            {
+                return (*this)[std::span<const std::int64_t>(subs.begin(), subs.size())];
+            }
+            [[nodiscard]] reference operator[](std::span<const std::int64_t> subs) noexcept
+            {
+                return data()[index_of(subs)];
+            }
+            [[nodiscard]] reference operator[](std::initializer_list<std::int64_t> subs) noexcept
+            {
+                return (*this)[std::span<const std::int64_t>(subs.begin(), subs.size())];
             }
 
-            for (typename ArCo::indexer_type gen(arr.header()); gen; ++gen) {
-                ++arr[*gen];
+            /**
+            * @return Row major array with the same elements.
+            */
+            [[nodiscard]] values_type to_dense() const
+            {
+                if (empty()) {
+                    return values_type();
+                }
+
+                values_type res(dims());
+                pointer dst{ res.data() };
+                const_pointer src{ data() };
+
+                for_each_partition(num_tiles_, count(), [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t tile = first; tile < last; ++tile) {
+                        for_each_tile_run(tile, [&](std::int64_t index, std::span<const std::int64_t> subs, std::int64_t length) {
+                            std::copy_n(src + index, length, dst + dense_index(res.header(), subs));
+                        });
+                    }
+                });
+
+                return res;
             }
-            return arr;
-        }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator++(ArCo&& arr)
-        {
-            return operator++(arr);
-        }
+            /**
+            * @note Applied tile by tile on the contiguous runs of each tile, with tiles processed in parallel for large arrays.
+            */
+            template <typename Unary_op> requires std::is_invocable_v<Unary_op, T>
+            [[nodiscard]] auto transform(Unary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo>
-        inline auto operator++(ArCo& arr, int)
-        {
-            ArCo old = clone(arr);
-            operator++(arr);
-            return old;
-        }
+                if (empty()) {
+                    return replaced_type<U>();
+                }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator++(ArCo&& arr, int)
-        {
-            return operator++(arr, int{});
-        }
+                replaced_type<U> res(dims(), tile_dims());
+                U* dst{ res.data() };
+                const_pointer src{ data() };
 
-        template <arrnd_complient ArCo>
-        inline auto& operator--(ArCo& arr)
-        {
-            if (empty(arr)) {
-                return arr;
+                for_each_partition(num_tiles_, count(), [&](std::int64_t first, std::int64_t last) {
+                    for (std::int64_t tile = first; tile < last; ++tile) {
+                        for_each_tile_run(tile, [&](std::int64_t index, std::span<const std::int64_t>, std::int64_t length) {
+                            for (std::int64_t j = index; j < index + length; ++j) {
+                                dst[j] = op(src[j]);
+                            }
+                        });
+                    }
+                });
+
+                return res;
             }
 
-            for (typename ArCo::indexer_type gen(arr.header()); gen; ++gen) {
-                --arr[*gen];
+            /**
+            * @note Elements are visited tile by tile (i.e. in indexer order).
+            */
+            template <typename Binary_op> requires std::is_invocable_v<Binary_op, T, T>
+            [[nodiscard]] auto reduce(Binary_op&& op) const
+            {
+                using U = decltype(op(std::declval<const_reference>(), std::declval<const_reference>()));
+
+                if (empty()) {
+                    return U{};
+                }
+
+                indexer_type gen{ indexer() };
+                U res{ static_cast<U>(data()[*gen]) };
+                for (++gen; gen; ++gen) {
+                    res = op(res, data()[*gen]);
+                }
+                return res;
             }
-            return arr;
-        }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator--(ArCo&& arr)
-        {
-            return operator--(arr);
-        }
+            template <typename U, typename Binary_op> requires std::is_invocable_v<Binary_op, U, T>
+            [[nodiscard]] auto reduce(const U& init_value, Binary_op&& op) const
+            {
+                using V = decltype(op(init_value, std::declval<const_reference>()));
 
-        template <arrnd_complient ArCo>
-        inline auto operator--(ArCo& arr, int)
-        {
-            ArCo old = clone(arr);
-            operator--(arr);
-            return old;
-        }
+                V res{ init_value };
+                for (indexer_type gen{ indexer() }; gen; ++gen) {
+                    res = op(res, data()[*gen]);
+                }
+                return res;
+            }
 
-        template <arrnd_complient ArCo>
-        [[nodiscard]] inline auto operator--(ArCo&& arr, int)
-        {
-            return operator--(arr, int{});
-        }
+            /**
+            * @return Tiled array with permuted dimensions and tile dimensions, or empty array if order is not a permutation of the axes.
+            * @note Each tile is transposed into a single tile of the result, so that both reads and writes stay within a tile.
+            */
+            [[nodiscard]] auto transpose(std::span<const std::int64_t> order) const
+            {
+                if (empty() || std::ssize(order) != ndims()) {
+                    return this_type();
+                }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo1::value_type, typename ArCo2::value_type>
-        [[nodiscard]] inline bool all_match(const ArCo1& lhs, const ArCo2& rhs, Binary_pred pred)
-        {
-            return lhs.all_match(rhs, pred);
-        }
+                dims_storage_type res_dims(ndims());
+                dims_storage_type res_tile_dims(ndims());
+                dims_storage_type used(ndims());
+                std::fill(used.begin(), used.end(), 0);
+                for (std::int64_t k = 0; k < ndims(); ++k) {
+                    if (order[k] < 0 || order[k] >= ndims() || used[order[k]]) {
+                        return this_type();
+                    }
+                    used[order[k]] = 1;
+                    res_dims[k] = dims_[order[k]];
+                    res_tile_dims[k] = tile_dims_[order[k]];
+                }
+
+                this_type res(std::span<const std::int64_t>(res_dims.data(), res_dims.size()), std::span<const std::int64_t>(res_tile_dims.data(), res_tile_dims.size()));
+                pointer dst{ res.data() };
+                const_pointer src{ data() };
+
+                // stride in the result tile of the innermost source axis
+                std::int64_t step{ 1 };
+                for (std::int64_t k = ndims() - 1; order[k] != ndims() - 1; --k) {
+                    step *= res_tile_dims[k];
+                }
+
+                for_each_partition(num_tiles_, count(), [&](std::int64_t first, std::int64_t last) {
+                    dims_storage_type res_subs(ndims());
+                    for (std::int64_t tile = first; tile < last; ++tile) {
+                        for_each_tile_run(tile, [&](std::int64_t index, std::span<const std::int64_t> subs, std::int64_t length) {
+                            for (std::int64_t k = 0; k < ndims(); ++k) {
+                                res_subs[k] = subs[order[k]];
+                            }
+                            const std::int64_t res_index{ res.index_of(std::span<const std::int64_t>(res_subs.data(), res_subs.size())) };
+                            for (std::int64_t j = 0; j < length; ++j) {
+                                dst[res_index + j * step] = src[index + j];
+                            }
+                        });
+                    }
+                });
 
-        template <arrnd_complient ArCo, typename T, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo::value_type, T>
-        [[nodiscard]] inline bool all_match(const ArCo& lhs, const T& rhs, Binary_pred pred)
-        {
-            return lhs.all_match(rhs, pred);
-        }
+                return res;
+            }
+            [[nodiscard]] auto transpose(std::initializer_list<std::int64_t> order) const
+            {
+                return transpose(std::span<const std::int64_t>(order.begin(), order.size()));
+            }
 
-        template <typename T, arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
-        [[nodiscard]] inline bool all_match(const T& lhs, const ArCo& rhs, Binary_pred pred)
-        {
-            return rhs.all_match([&lhs, &pred](const typename ArCo::value_type& value) { return pred(lhs, value); });
-        }
+        private:
+            bool init_layout(std::span<const std::int64_t> dims, std::span<const std::int64_t> tile_dims)
+            {
+                if (dims.empty() || dims.size() != tile_dims.size()) {
+                    return false;
+                }
 
+                dims_storage_type grid_dims(std::ssize(dims));
+                dims_storage_type tile_strides(std::ssize(dims));
+                std::int64_t tile_size{ 1 };
+                std::int64_t num_tiles{ 1 };
+                for (std::int64_t i = std::ssize(dims) - 1; i >= 0; --i) {
+                    if (dims[i] <= 0 || tile_dims[i] <= 0) {
+                        return false;
+                    }
+                    grid_dims[i] = (dims[i] + tile_dims[i] - 1) / tile_dims[i];
+                    tile_strides[i] = tile_size;
+                    tile_size *= tile_dims[i];
+                    num_tiles *= grid_dims[i];
+                }
+
+                dims_ = dims_storage_type(dims.begin(), dims.end());
+                tile_dims_ = dims_storage_type(tile_dims.begin(), tile_dims.end());
+                grid_dims_ = std::move(grid_dims);
+                tile_strides_ = std::move(tile_strides);
+                tile_size_ = tile_size;
+                num_tiles_ = num_tiles;
+                return true;
+            }
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo1::value_type, typename ArCo2::value_type>
-        [[nodiscard]] inline bool any_match(const ArCo1& lhs, const ArCo2& rhs, Binary_pred pred)
-        {
-            return lhs.any_match(rhs, pred);
-        }
+            [[nodiscard]] std::int64_t index_of(std::span<const std::int64_t> subs) const noexcept
+            {
+                std::int64_t tile{ 0 };
+                std::int64_t local_offset{ 0 };
+                for (std::int64_t i = 0; i < ndims(); ++i) {
+                    tile = tile * grid_dims_[i] + subs[i] / tile_dims_[i];
+                    local_offset += (subs[i] % tile_dims_[i]) * tile_strides_[i];
+                }
+                return tile * tile_size_ + local_offset;
+            }
 
-        template <arrnd_complient ArCo, typename T, typename Binary_pred> requires std::is_invocable_v<Binary_pred, typename ArCo::value_type, T>
-        [[nodiscard]] inline bool any_match(const ArCo& lhs, const T& rhs, Binary_pred pred)
-        {
-            return lhs.any_match(rhs, pred);
-        }
+            template <typename Header>
+            [[nodiscard]] static std::int64_t dense_index(const Header& hdr, std::span<const std::int64_t> subs) noexcept
+            {
+                std::int64_t index{ hdr.offset() };
+                for (std::int64_t i = 0; i < std::ssize(subs); ++i) {
+                    index += subs[i] * hdr.strides()[i];
+                }
+                return index;
+            }
 
-        template <typename T, arrnd_complient ArCo, typename Binary_pred> requires std::is_invocable_v<Binary_pred, T, typename ArCo::value_type>
-        [[nodiscard]] inline bool any_match(const T& lhs, const ArCo& rhs, Binary_pred pred)
-        {
-            return rhs.any_match([&lhs, &pred](const typename ArCo::value_type& value) { return pred(lhs, value); });
-        }
+            /**
+            * @note Calls func(index, subs, length) for each contiguous run of the tile along the last axis,
+            * where index is the buffer index of the run and subs are the subscripts of its first element.
+            */
+            template <typename Func>
+            void for_each_tile_run(std::int64_t tile, Func&& func) const
+            {
+                const std::int64_t nd{ ndims() };
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline bool all_equal(const ArCo1& lhs, const ArCo2& rhs)
-        {
-            return lhs.all_equal(rhs);
-        }
+                dims_storage_type first_subs(nd);
+                dims_storage_type extents(nd);
+                for (std::int64_t i = nd - 1, rem = tile; i >= 0; --i) {
+                    first_subs[i] = (rem % grid_dims_[i]) * tile_dims_[i];
+                    extents[i] = std::min(tile_dims_[i], dims_[i] - first_subs[i]);
+                    rem /= grid_dims_[i];
+                }
 
-        template <arrnd_complient ArCo, typename T>
-        [[nodiscard]] inline bool all_equal(const ArCo& lhs, const T& rhs)
-        {
-            return lhs.all_equal(rhs);
-        }
+                dims_storage_type subs(first_subs.begin(), first_subs.end());
+                const std::int64_t length{ extents[nd - 1] };
+                std::int64_t index{ tile * tile_size_ };
 
-        template <typename T, arrnd_complient ArCo>
-        [[nodiscard]] inline bool all_equal(const T& lhs, const ArCo& rhs)
-        {
-            return rhs.all_equal(lhs);
-        }
+                for (;;) {
+                    func(index, std::span<const std::int64_t>(subs.data(), subs.size()), length);
 
-        template <arrnd_complient ArCo1, arrnd_complient ArCo2>
-        [[nodiscard]] inline bool all_close(const ArCo1& lhs, const ArCo2& rhs, const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& atol = default_atol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > (), const decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{})& rtol = default_rtol<decltype(typename ArCo1::value_type{} - typename ArCo2::value_type{}) > ())
-        {
-            return lhs.all_close(rhs, atol, rtol);
-        }
+                    std::int64_t i = nd - 2;
+                    for (; i >= 0; --i) {
+                        if (++subs[i] < first_subs[i] + extents[i]) {
+                            index += tile_strides_[i];
+                            break;
+                        }
+                        index -= (extents[i] - 1) * tile_strides_[i];
+                        subs[i] = first_subs[i];
+                    }
+                    if (i < 0) {
+                        return;
+                    }
+                }
+            }
 
-        template <arrnd_complient ArCo, typename T> requires (!arrnd_complient<T>)
-        [[nodiscard]] inline bool all_close(const ArCo& lhs, const T& rhs, const decltype(typename ArCo::value_type{} - T{})& atol = default_atol<decltype(typename ArCo::value_type{} - T{}) > (), const decltype(typename ArCo::value_type{} - T{})& rtol = default_rtol<decltype(typename ArCo::value_type{} - T{}) > ())
-        {
-            return lhs.all_close(rhs, atol, rtol);
-        }
+            dims_storage_type dims_{};
+            dims_storage_type tile_dims_{};
+            dims_storage_type grid_dims_{};
+            dims_storage_type tile_strides_{};
+            std::int64_t tile_size_{ 1 };
+            std::int64_t num_tiles_{ 0 };
 
-        template <typename T, arrnd_complient ArCo> requires (!arrnd_complient<T>)
-        [[nodiscard]] inline bool all_close(const T& lhs, const ArCo& rhs, const decltype(T{} - typename ArCo::value_type{})& atol = default_atol<decltype(T{} - typename ArCo::value_type{}) > (), const decltype(T{} - typename ArCo::value_type{})& rtol = default_rtol<decltype(T{} - typename ArCo::value_type{}) > ())
-        {
-            return rhs.all_close(lhs, atol, rtol);
-        }
+            values_type values_{};
+        };
     }
 
     using details::arrnd;
+    using details::arrnd_ragged;
+    using details::arrnd_coo;
+    using details::arrnd_csr;
+    using details::arrnd_tiled;
+    using details::arrnd_tiled_indexer;
 
     using details::arrnd_header;
+    using details::arrnd_layout;
     
+    using details::arrnd_iteration_plan;
+    using details::arrnd_iteration_plan_cache;
+    using details::iteration_plan_of;
+    using details::for_each_joint_run;
+    using details::arrnd_multi_indexer;
     using details::arrnd_general_indexer;
+    using details::arrnd_arena;
+    using details::arrnd_arena_scope;
+    using details::arena_allocator;
+    using details::arena_header;
+    using details::huge_page_size;
+    using details::huge_page_allocator;
+    using details::hugetlb_allocator;
+    using details::atomic_ref_count;
+    using details::non_atomic_ref_count;
+    using details::intrusive_ref_count;
     using details::arrnd_fast_indexer;
 
     using details::arrnd_iterator;
@@ -4577,11 +9501,33 @@ namespace oc {
     using details::any_match;
     using details::transform;
     using details::reduce;
+    using details::sum;
+    using details::argmin;
+    using details::argmax;
+    using details::mean;
+    using details::var;
+    using details::stddev;
+    using details::async_transform;
+    using details::async_apply;
+    using details::async_reduce;
+    using details::async_sum;
+    using details::async_filter;
     using details::all;
     using details::any;
     using details::filter;
     using details::find;
     using details::transpose;
+    using details::flip;
+    using details::for_each_run;
+    using details::philox_generator;
+    using details::fill_random_uniform;
+    using details::fill_random_normal;
+    using details::random_uniform;
+    using details::random_normal;
+    using details::random_integers;
+    using details::arrnd_slices;
+    using details::slices;
+    using details::for_each_slice;
     using details::close;
     using details::all_equal;
     using details::all_close;
@@ -4606,4 +9552,28 @@ namespace oc {
     using details::tanh;
 }
 
+/**
+* @note If OC_ARRND_EXTERN_TEMPLATES is defined (by linking the oc-arrnd::precompiled library), the arrays of the common element types
+* are not instantiated by each translation unit, but compiled once by src/arrnd.cpp.
+* Member templates (e.g. transform by a user function) are still instantiated by their users.
+*/
+#if defined(OC_ARRND_EXTERN_TEMPLATES)
+namespace oc {
+    namespace details {
+        extern template class simple_dynamic_vector<std::int64_t>;
+        extern template class arrnd_header<>;
+        extern template class arrnd_general_indexer<>;
+
+        extern template class simple_dynamic_vector<float>;
+        extern template class simple_dynamic_vector<double>;
+        extern template class simple_dynamic_vector<int>;
+
+        extern template class arrnd<float>;
+        extern template class arrnd<double>;
+        extern template class arrnd<int>;
+        extern template class arrnd<std::int64_t>;
+    }
+}
+#endif // OC_ARRND_EXTERN_TEMPLATES
+
 #endif // OC_ARRAY_H
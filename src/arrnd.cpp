@@ -0,0 +1,21 @@
+#include <oc/arrnd.h>
+
+#include <cstdint>
+
+// explicit instantiations of the extern templates declared by oc/arrnd.h
+namespace oc {
+    namespace details {
+        template class simple_dynamic_vector<std::int64_t>;
+        template class arrnd_header<>;
+        template class arrnd_general_indexer<>;
+
+        template class simple_dynamic_vector<float>;
+        template class simple_dynamic_vector<double>;
+        template class simple_dynamic_vector<int>;
+
+        template class arrnd<float>;
+        template class arrnd<double>;
+        template class arrnd<int>;
+        template class arrnd<std::int64_t>;
+    }
+}
@@ -193,6 +193,89 @@ TEST(simple_dynamic_vector_test, basic_functionality)
     //EXPECT_EQ("", sv.back());
 }
 
+TEST(simple_dynamic_vector_test, trivially_copyable_growth)
+{
+    using simple_vector = oc::details::simple_dynamic_vector<int>;
+
+    // geometric growth
+    simple_vector sv;
+    std::int64_t reallocations{ 0 };
+    for (int i = 0; i < 10000; ++i) {
+        const auto capacity = sv.capacity();
+        sv.expand(1);
+        sv.back() = i;
+        reallocations += sv.capacity() != capacity;
+    }
+    EXPECT_EQ(10000, sv.size());
+    EXPECT_GE(25, reallocations);
+
+    const simple_vector& csv = sv;
+    EXPECT_EQ(49995000, std::accumulate(csv.begin(), csv.end(), 0));
+
+    // expanding up to the capacity keeps the buffer
+    simple_vector fv(4);
+    fv.reserve(8);
+    const auto* data = fv.data();
+    fv.expand(4);
+    EXPECT_EQ(8, fv.capacity());
+    EXPECT_EQ(data, fv.data());
+
+    simple_vector a, b;
+    a = b = sv;
+    EXPECT_TRUE(std::ranges::equal(sv, a));
+    EXPECT_TRUE(std::ranges::equal(sv, b));
+    a.shrink(9000);
+    a.shrink_to_fit();
+    EXPECT_EQ(1000, a.capacity());
+    EXPECT_EQ(999, a.back());
+
+    // mapped buffers grow by remapping
+    using huge_vector = oc::details::simple_dynamic_vector<double, oc::huge_page_allocator>;
+    huge_vector hv(1 << 18);
+    std::iota(hv.begin(), hv.end(), 0.0);
+    hv.resize(1 << 19);
+    EXPECT_EQ(static_cast<double>((1 << 18) - 1), hv[(1 << 18) - 1]);
+    hv.shrink(1 << 19);
+    hv.shrink_to_fit();
+    EXPECT_TRUE(hv.empty());
+}
+
+TEST(huge_page_allocator_test, backs_large_vectors_and_arrays)
+{
+    using huge_vector = oc::details::simple_dynamic_vector<double, oc::huge_page_allocator>;
+
+    // below and above the huge page threshold
+    for (std::int64_t size : { std::int64_t{ 10 }, oc::huge_page_size / std::int64_t{ sizeof(double) } + 1 }) {
+        huge_vector hv(size);
+        std::fill(hv.begin(), hv.end(), 2.5);
+        hv.resize(size + 3);
+        EXPECT_EQ(size + 3, hv.size());
+        EXPECT_DOUBLE_EQ(2.5, hv[size - 1]);
+    }
+
+    using huge_array = oc::arrnd<int, oc::details::simple_dynamic_vector<int, oc::hugetlb_allocator>, oc::hugetlb_allocator>;
+    const std::int64_t count{ oc::huge_page_size };
+    huge_array arr({ 2, count / 2 }, 1);
+    EXPECT_EQ(count, oc::sum(arr));
+    EXPECT_EQ(2 * count, oc::sum(arr.transform([](int n) { return 2 * n; })));
+
+#if defined(__linux__)
+    // mapped allocations start at a huge page boundary, also after they are grown
+    oc::huge_page_allocator<char> alloc;
+    std::int64_t length{ oc::huge_page_size + 1 };
+    char* p{ alloc.allocate(length) };
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % oc::huge_page_size);
+    p[length - 1] = 'x';
+    for (std::int64_t new_length : { 4 * oc::huge_page_size, 64 * oc::huge_page_size }) {
+        p = alloc.reallocate(p, length, new_length);
+        length = new_length;
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(p) % oc::huge_page_size);
+        EXPECT_EQ('x', p[oc::huge_page_size]);
+    }
+    alloc.deallocate(p, length);
+#endif
+}
+
 TEST(simple_static_vector_test, span_usage)
 {
     using simple_vector = oc::details::simple_static_vector<std::string, 2>;
@@ -337,6 +420,43 @@ TEST(arrnd_test, iterators)
     EXPECT_TRUE(std::equal(inds[3].begin(), inds[3].end(), res.begin()));
 }
 
+TEST(arrnd_iteration_plan, coalesced_loop_nest_and_cache)
+{
+    using namespace oc;
+
+    // contiguous axes are merged into a single run
+    const std::int64_t dims[]{ 2, 1, 3, 4 };
+    arrnd_header hdr(std::span(dims, 4));
+    auto plan = iteration_plan_of(hdr);
+    EXPECT_EQ(24, plan->count());
+    EXPECT_EQ(1, plan->ndims());
+    EXPECT_EQ(24, plan->inner_length());
+    EXPECT_EQ(1, plan->inner_stride(0));
+    EXPECT_EQ(plan, iteration_plan_of(hdr));
+
+    // a subarray breaks the runs at the sliced axis
+    arrnd_header shdr(hdr, std::initializer_list<Interval<std::int64_t>>{ {0, 1}, {0, 0}, {0, 2}, {1, 2} });
+    auto splan = iteration_plan_of(shdr);
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 6, 2 }, splan->dims()));
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 4, 1 }, splan->strides(0)));
+
+    // axes are merged only if they are contiguous for all the operands
+    arrnd_header fhdr(std::span(dims, 4), arrnd_layout::column_major);
+    auto jplan = iteration_plan_of(hdr, fhdr);
+    EXPECT_EQ(2, jplan->num_operands());
+    EXPECT_EQ(3, jplan->ndims());
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 12, 4, 1 }, jplan->strides(0)));
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 1, 2, 6 }, jplan->strides(1)));
+    EXPECT_EQ(24, iteration_plan_of(hdr, hdr)->inner_length());
+
+    // axes order
+    const std::int64_t order[]{ 3, 2, 1, 0 };
+    const std::span<const std::int64_t> strides[]{ hdr.strides() };
+    auto oplan = arrnd_iteration_plan_cache<>::get(hdr.dims(), strides, order);
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 4, 3, 2 }, oplan->dims()));
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 1, 4, 12 }, oplan->strides(0)));
+}
+
 TEST(arrnd_general_indexer, simple_forward_backward_iterations)
 {
     using namespace oc;
@@ -726,6 +846,548 @@ TEST(arrnd_test, can_return_its_header_and_data)
     }
 }
 
+TEST(arrnd_test, column_major_and_strided_layouts)
+{
+    oc::arrnd<int> rarr{ {2, 3}, {
+        1, 2, 3,
+        4, 5, 6 } };
+
+    // Fortran ordered buffer
+    oc::arrnd<int> farr({ 2, 3 }, oc::arrnd_layout::column_major, { 1, 4, 2, 5, 3, 6 });
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 1, 2 }, farr.header().strides()));
+    EXPECT_TRUE(farr.header().is_dense());
+    EXPECT_FALSE(farr.header().is_contiguous());
+    EXPECT_TRUE(rarr.header().is_contiguous());
+    EXPECT_EQ(3, (farr[{ 0, 2 }]));
+    EXPECT_TRUE(oc::all_equal(rarr, farr));
+
+    // element wise results keep the memory order of their input
+    auto tarr = farr.transform([](int n) { return n * 10; });
+    EXPECT_TRUE(std::ranges::equal(farr.header().strides(), tarr.header().strides()));
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 10, 40, 20, 50, 30, 60 }, std::span<const int>(tarr.data(), 6)));
+    EXPECT_TRUE(oc::all_equal(rarr.transform([](int n) { return n * 10; }), tarr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {2, 4, 6, 8, 10, 12} }, farr.transform(farr, [](int a, int b) { return a + b; })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {2, 4, 6, 8, 10, 12} }, farr.transform(rarr, [](int a, int b) { return a + b; })));
+    oc::arrnd<int> aarr = oc::copy(farr, oc::arrnd<int>({ 2, 3 }, oc::arrnd_layout::column_major));
+    aarr.apply([](int n) { return -n; });
+    EXPECT_TRUE(oc::all_equal(rarr.transform(std::negate<>{}), aarr));
+
+    EXPECT_EQ(21, oc::sum(farr));
+    EXPECT_DOUBLE_EQ(3.5, oc::mean(farr));
+    EXPECT_EQ(5, oc::argmax(farr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {5, 7, 9} }, oc::sum(farr, { 0 })));
+    EXPECT_TRUE(oc::all_equal(rarr.reshape({ 3, 2 }), farr.reshape({ 3, 2 })));
+    EXPECT_TRUE(oc::all_equal(rarr.transpose({ 1, 0 }), farr.transpose({ 1, 0 })));
+
+    // slices keep the strides of the axes without intervals
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {1, 3}, {4, 5, 6} }, (farr[{ {1, 1} }])));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {2, 3, 5, 6} }, (farr[{ {0, 1}, {1, 2} }])));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {1, 2}, {1, 3} }, (rarr[{ {0, 1}, {0, 2, 2} }][{ {0, 0} }])));
+
+    // arbitrary strides, e.g. rows padded to four elements
+    const std::int64_t dims[]{ 2, 2 };
+    const std::int64_t strides[]{ 4, 1 };
+    const int padded[]{ 1, 2, 0, 0, 3, 4, 0, 0 };
+    oc::arrnd<int> parr(dims, strides, padded);
+    EXPECT_FALSE(parr.header().is_dense());
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {1, 2, 3, 4} }, parr));
+    EXPECT_EQ(10, oc::sum(parr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {2, 4, 6, 8} }, parr.transform([](int n) { return 2 * n; })));
+
+    const std::int64_t invalid_strides[]{ 4, 0 };
+    EXPECT_TRUE(oc::empty(oc::arrnd<int>(std::span<const std::int64_t>(dims), std::span<const std::int64_t>(invalid_strides))));
+}
+
+TEST(arrnd_test, math_functions_of_const_arrays)
+{
+    const oc::arrnd<double> arr{ {2, 2}, {1.0, 4.0, 9.0, 16.0} };
+
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {2, 2}, {1.0, 2.0, 3.0, 4.0} }, oc::sqrt(arr)));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {2, 2}, {1.0, 16.0, 81.0, 256.0} }, oc::pow(arr, 2)));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {2, 2}, {1.0, 2.0, 3.0, 4.0} }, arr.pow(0.5)));
+}
+
+TEST(arrnd_test, scalar_operations_of_temporaries_are_in_place)
+{
+    oc::arrnd<int> arr{ {2, 3}, {1, 2, 3, 4, 5, 6} };
+
+    // lvalue operands are not modified
+    auto res = arr * 2;
+    EXPECT_NE(arr.data(), res.data());
+    EXPECT_EQ(21, oc::sum(arr));
+    EXPECT_TRUE(res.is_unique());
+    EXPECT_FALSE(oc::arrnd<int>(arr).is_unique());
+
+    // uniquely owned temporaries are reused
+    auto tmp = arr.clone();
+    const int* buffer = tmp.data();
+    auto scaled = ((std::move(tmp) * 3 + 1) << 1) - 2;
+    EXPECT_EQ(buffer, scaled.data());
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {6, 12, 18, 24, 30, 36} }, scaled));
+    auto rscaled = 100 - std::move(scaled);
+    EXPECT_EQ(buffer, rscaled.data());
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {94, 88, 82, 76, 70, 64} }, rscaled));
+
+    // shared buffers and other result types are not
+    auto shared = arr[{ {0, 1}, {1, 2} }];
+    auto sres = std::move(shared) + 10;
+    EXPECT_NE(arr.data(), sres.data());
+    EXPECT_EQ(21, oc::sum(arr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {12, 13, 15, 16} }, sres));
+
+    auto dres = arr.clone() * 0.5;
+    EXPECT_EQ(10.5, oc::sum(dres));
+    auto tres = arr.clone() > 3;
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<bool>{ {2, 3}, {false, false, false, true, true, true} }, tres));
+
+    // nor are const temporaries
+    const oc::arrnd<int> carr{ arr.clone() };
+    auto cres = 1 + std::move(carr) * 2;
+    EXPECT_NE(carr.data(), cres.data());
+    EXPECT_EQ(21, oc::sum(carr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {3, 5, 7, 9, 11, 13} }, cres));
+    auto make_const = [&arr]() -> const oc::arrnd<int> { return arr.clone(); };
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {0, 1, 1, 2, 2, 3} }, make_const() / 2));
+}
+
+TEST(arrnd_test, slices_along_axis)
+{
+    oc::arrnd<int> arr{ {2, 3, 4}, {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12,
+
+        13, 14, 15, 16,
+        17, 18, 19, 20,
+        21, 22, 23, 24 } };
+
+    std::vector<int> sums;
+    for (const auto& slice : oc::slices(arr, 1)) {
+        EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 2, 1, 4 }, slice.header().dims()));
+        EXPECT_EQ(arr.data(), slice.data());
+        sums.push_back(oc::sum(slice));
+    }
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 68, 100, 132 }, sums));
+
+    auto range = arr.slices(-1);
+    EXPECT_EQ(4, range.size());
+    EXPECT_TRUE(oc::all_equal(arr[{ {0, 1}, {0, 2}, {2, 2} }], range.slice(2)));
+
+    for (auto& slice : arr.slices(0)) {
+        slice *= 2;
+    }
+    EXPECT_EQ(600, oc::sum(arr));
+
+    // slices of a subarray
+    auto sarr = arr[{ {0, 1}, {1, 2}, {0, 3, 2} }];
+    sums.clear();
+    for (const auto& slice : sarr.slices(2)) {
+        sums.push_back(oc::sum(slice));
+    }
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 2 * (5 + 9 + 17 + 21), 2 * (7 + 11 + 19 + 23) }, sums));
+
+    // rows of a large matrix over the thread pool
+    oc::arrnd<int> large({ 512, 256 }, 1);
+    oc::arrnd<int> row_sums({ 512 }, 0);
+    oc::for_each_slice(large, 0, [&row_sums](std::int64_t i, const oc::arrnd<int>& row) {
+        row_sums.data()[i] = oc::sum(row) + static_cast<int>(i);
+    });
+    for (std::int64_t i = 0; i < 512; ++i) {
+        EXPECT_EQ(256 + i, row_sums.data()[i]);
+    }
+
+    std::atomic<std::int64_t> count{ 0 };
+    large.for_each_slice(1, [&count](oc::arrnd<int>& column) {
+        count += column.header().count();
+    });
+    EXPECT_EQ(512 * 256, count.load());
+
+    // calls from a worker are partitioned over the workers of its pool
+    oc::thread_pool pool(4);
+    oc::arrnd<int> visits({ 512 }, 0);
+    oc::task_group group(pool);
+    group.run([&]() {
+        EXPECT_EQ(&pool, &oc::thread_pool::current());
+        large.for_each_slice(0, [&visits](std::int64_t i, oc::arrnd<int>& row) {
+            row += 1;
+            ++visits.data()[i];
+        });
+    });
+    group.wait();
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>({ 512 }, 1), visits));
+    EXPECT_EQ(2 * 512 * 256, oc::sum(large));
+
+    // and arrays of a non atomic reference count by a single partition
+    using single_thread_array = oc::arrnd<int, oc::details::simple_dynamic_vector<int>, oc::details::lightweight_allocator, oc::details::arrnd_header<>, oc::details::arrnd_general_indexer<>, oc::non_atomic_ref_count>;
+    single_thread_array single({ 512, 256 }, 1);
+    std::int64_t rows{ 0 };
+    group.run([&]() {
+        single.for_each_slice(0, [&rows](single_thread_array& row) {
+            rows += row.header().count() / 256;
+        });
+    });
+    group.wait();
+    EXPECT_EQ(512, rows);
+    EXPECT_TRUE(single.is_unique());
+}
+
+namespace {
+    thread_local std::int64_t heap_allocations{ 0 };
+
+    // arena allocator that counts the allocations of the current thread which are not from its current arena
+    template <typename T>
+    class counting_arena_allocator : public oc::details::arena_allocator<T> {
+    public:
+        using base_type = oc::details::arena_allocator<T>;
+        using typename base_type::pointer;
+        using typename base_type::size_type;
+
+        counting_arena_allocator() = default;
+
+        template <typename U>
+        counting_arena_allocator(const counting_arena_allocator<U>&) noexcept {}
+
+        [[nodiscard]] pointer allocate(size_type n)
+        {
+            pointer p{ base_type::allocate(n) };
+            if (p && !(oc::arrnd_arena::current() && oc::arrnd_arena::current()->owns(p))) {
+                ++heap_allocations;
+            }
+            return p;
+        }
+    };
+}
+
+TEST(arrnd_test, slices_with_arena_headers)
+{
+    using header_type = oc::arena_header;
+    using array_type = oc::arrnd<int, oc::details::simple_dynamic_vector<int>, oc::details::lightweight_allocator, header_type, oc::details::arrnd_general_indexer<oc::details::simple_dynamic_vector<std::int64_t>, header_type>>;
+
+    array_type arr{ {4, 4}, {
+        0, 1, 2, 3,
+        4, 5, 6, 7,
+        8, 9, 10, 11,
+        12, 13, 14, 15 } };
+
+    // caller provided arena
+    alignas(16) std::array<std::byte, 4096> buffer{};
+    oc::arrnd_arena arena(buffer);
+    {
+        oc::arrnd_arena_scope scope(arena);
+        auto sarr = arr[{ {1, 3}, {1, 3} }][{ {0, 1}, {1, 2} }];
+        EXPECT_TRUE(arena.owns(sarr.header().dims().data()));
+        EXPECT_TRUE(arena.owns(sarr.header().strides().data()));
+        EXPECT_FALSE(arena.owns(arr.header().dims().data()));
+        EXPECT_LT(0, arena.mark());
+        EXPECT_EQ(34, oc::sum(sarr));
+    }
+    EXPECT_EQ(0, arena.mark());
+    EXPECT_EQ(nullptr, oc::arrnd_arena::current());
+
+    // no heap allocations of headers and indexers by a slicing chain and the iteration of its result
+    using counted_header_type = oc::details::arrnd_header<oc::details::simple_dynamic_vector<std::int64_t, counting_arena_allocator>>;
+    using counted_array_type = oc::arrnd<int, oc::details::simple_dynamic_vector<int>, oc::details::lightweight_allocator, counted_header_type, oc::details::arrnd_general_indexer<oc::details::simple_dynamic_vector<std::int64_t, counting_arena_allocator>, counted_header_type>>;
+    const counted_array_type carr{ {4, 4}, static_cast<const int*>(arr.data()) };
+    {
+        oc::arrnd_arena_scope scope(arena);
+        const std::int64_t allocations{ heap_allocations };
+        auto sarr = carr[{ {1, 3}, {1, 3} }][{ {0, 1}, {1, 2} }][{ {1, 1}, {0, 1} }];
+        std::int64_t total{ 0 };
+        for (auto value : sarr) {
+            total += value;
+        }
+        EXPECT_EQ(allocations, heap_allocations);
+        EXPECT_EQ(21, total);
+
+        // whereas without an arena the dimensions and strides of each slice are allocated
+        oc::arrnd_arena_scope heap_scope(nullptr);
+        auto harr = carr[{ {1, 3}, {1, 3} }];
+        EXPECT_EQ(allocations + 2, heap_allocations);
+        EXPECT_FALSE(arena.owns(harr.header().dims().data()));
+    }
+
+    // thread local arena for temporaries
+    int total{ 0 };
+    for (int i = 0; i < 1000; ++i) {
+        oc::arrnd_arena_scope scope;
+        total += oc::sum(arr[{ {i % 4, 3} }][{ {0, 0}, {0, 3} }]);
+    }
+    EXPECT_EQ(250 * (6 + 22 + 38 + 54), total);
+
+    // exhausted arena falls back to the heap
+    alignas(16) std::array<std::byte, 16> small_buffer{};
+    oc::arrnd_arena small_arena(small_buffer);
+    {
+        oc::arrnd_arena_scope scope(small_arena);
+        auto sarr = arr[{ {0, 1}, {0, 1} }];
+        EXPECT_FALSE(small_arena.owns(sarr.header().dims().data()));
+        EXPECT_TRUE(oc::all_equal(array_type{ {2, 2}, {0, 1, 4, 5} }, sarr));
+    }
+
+    // arrays that outlive the scope are assigned from the heap
+    array_type farr{};
+    {
+        oc::arrnd_arena_scope scope(arena);
+        auto sarr = arr[{ {0, 1}, {0, 3} }];
+        {
+            oc::arrnd_arena_scope heap_scope(nullptr);
+            farr = sarr[{ {0, 1}, {0, 1} }];
+        }
+        EXPECT_FALSE(arena.owns(farr.header().dims().data()));
+        EXPECT_FALSE(arena.owns(farr.header().strides().data()));
+    }
+    EXPECT_TRUE(oc::all_equal(array_type{ {2, 2}, {0, 1, 4, 5} }, farr));
+}
+
+TEST(arrnd_test, reference_count_policies)
+{
+    auto check = []<typename Policy>(Policy) {
+        using array_type = oc::arrnd<int, oc::details::simple_dynamic_vector<int>, oc::details::lightweight_allocator, oc::details::arrnd_header<>, oc::details::arrnd_general_indexer<>, Policy>;
+
+        array_type arr{ {2, 3}, {1, 2, 3, 4, 5, 6} };
+        {
+            array_type carr{ arr };
+            auto sarr = arr[{ {0, 1}, {1, 2} }];
+            EXPECT_EQ(arr.data(), carr.data());
+            EXPECT_EQ(arr.data(), sarr.data());
+            sarr = 0;
+        }
+        EXPECT_EQ(5, oc::sum(arr));
+
+        auto darr = arr.transform([](int a) { return a * 0.5; });
+        static_assert(std::is_same_v<Policy, typename decltype(darr)::ref_count_policy_type>);
+        EXPECT_EQ(2.5, oc::sum(darr));
+
+        array_type moved{ std::move(arr) };
+        EXPECT_TRUE(oc::all_equal(array_type{ {2, 3}, {1, 0, 0, 4, 0, 0} }, moved));
+    };
+
+    check(oc::atomic_ref_count{});
+    check(oc::non_atomic_ref_count{});
+    check(oc::intrusive_ref_count{});
+
+    using ref_type = oc::details::intrusive_shared_ref<std::string, std::int64_t>;
+    auto ref = ref_type::make("abc");
+    EXPECT_EQ(1, ref.use_count());
+    {
+        auto cref = ref;
+        EXPECT_EQ(2, ref.use_count());
+        EXPECT_EQ("abc", *cref);
+    }
+    EXPECT_EQ(1, ref.use_count());
+    ref = nullptr;
+    EXPECT_FALSE(ref);
+
+    // arrays of a non atomic reference count (and arrays of them) are not copied by parallel algorithms
+    using single_thread_array = oc::arrnd<int, oc::details::simple_dynamic_vector<int>, oc::details::lightweight_allocator, oc::details::arrnd_header<>, oc::details::arrnd_general_indexer<>, oc::non_atomic_ref_count>;
+    static_assert(oc::details::is_concurrently_copyable_v<oc::arrnd<oc::arrnd<int>>>);
+    static_assert(!oc::details::is_concurrently_copyable_v<single_thread_array>);
+    static_assert(!oc::details::is_concurrently_copyable_v<oc::arrnd<single_thread_array>>);
+
+    single_thread_array element({ 2 }, 7);
+    {
+        oc::arrnd<single_thread_array> nested({ oc::parallel_threshold }, element);
+        EXPECT_EQ(element.data(), nested[{ oc::parallel_threshold - 1 }].data());
+        EXPECT_FALSE(element.is_unique());
+    }
+    EXPECT_TRUE(element.is_unique());
+
+    // and their async operations are processed by the calling thread
+    auto sum_result = element.async_sum();
+    EXPECT_TRUE(sum_result.ready());
+    EXPECT_TRUE(element.is_unique());
+    EXPECT_EQ(14, sum_result.get());
+    auto transform_result = element.async_transform([](int a) { return a + 1; });
+    EXPECT_TRUE(element.is_unique());
+    EXPECT_TRUE(oc::all_equal(single_thread_array({ 2 }, 8), transform_result.get()));
+}
+
+TEST(arrnd_test, for_each_run_visits_maximal_runs)
+{
+    oc::arrnd<int> arr{ {2, 3, 4}, {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12,
+
+        13, 14, 15, 16,
+        17, 18, 19, 20,
+        21, 22, 23, 24 } };
+
+    auto collect = [](const auto& a) {
+        std::vector<std::int64_t> lengths;
+        std::vector<int> values;
+        oc::for_each_run(a, [&](const int* first, std::int64_t length, std::int64_t stride) {
+            lengths.push_back(length);
+            for (std::int64_t i = 0; i < length; ++i) {
+                values.push_back(first[i * stride]);
+            }
+        });
+        return std::make_pair(lengths, values);
+    };
+
+    auto [lengths, values] = collect(arr);
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 24 }, lengths));
+    EXPECT_EQ(24, std::ssize(values));
+
+    auto [slengths, svalues] = collect(arr[{ {0, 1}, {1, 2}, {0, 3, 2} }]);
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 4, 4 }, slengths));
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 5, 7, 9, 11, 17, 19, 21, 23 }, svalues));
+
+    auto [rlengths, rvalues] = collect(arr[{ {0, 0}, {0, 2}, {-1, 0, -1} }]);
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 4, 4, 4 }, rlengths));
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 4, 3, 2, 1, 8, 7, 6, 5, 12, 11, 10, 9 }, rvalues));
+
+    std::int64_t runs{ 0 };
+    oc::for_each_run(arr.header(), [&runs](std::int64_t index, std::int64_t length, std::int64_t stride) {
+        EXPECT_EQ(0, index);
+        EXPECT_EQ(24, length);
+        EXPECT_EQ(1, stride);
+        ++runs;
+    });
+    EXPECT_EQ(1, runs);
+
+    // kernels over runs
+    auto sarr = arr[{ {0, 1}, {1, 2}, {0, 3, 2} }];
+    EXPECT_EQ(112, sarr.reduce([](int a, int b) { return a + b; }));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2, 2}, {5, 7, 9, 11, 17, 19, 21, 23} }, sarr.clone()));
+    sarr = 0;
+    EXPECT_EQ(300 - 112, oc::sum(arr));
+}
+
+TEST(arrnd_test, joint_runs_of_multiple_operands)
+{
+    oc::arrnd<int> arr{ {2, 3, 4}, {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12,
+
+        13, 14, 15, 16,
+        17, 18, 19, 20,
+        21, 22, 23, 24 } };
+    auto farr = oc::flip(arr, 2);
+
+    // dims are coalesced only where both operands are contiguous
+    std::vector<std::int64_t> lengths;
+    std::int64_t sum{ 0 };
+    oc::for_each_joint_run([&](const auto& indices, std::int64_t length, const auto& strides) {
+        EXPECT_EQ(1, strides[0]);
+        EXPECT_EQ(-1, strides[1]);
+        lengths.push_back(length);
+        for (std::int64_t i = 0; i < length; ++i) {
+            sum += arr.data()[indices[0] + i * strides[0]] * farr.data()[indices[1] + i * strides[1]];
+        }
+    }, arr.header(), farr.header());
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>(6, 4), lengths));
+    EXPECT_EQ(oc::sum(arr * oc::flip(arr, 2).clone()), sum);
+
+    std::vector<std::pair<int, int>> pairs;
+    for (oc::arrnd_multi_indexer<2> gen(arr.header(), farr.header()); gen; ++gen) {
+        pairs.emplace_back(arr.data()[gen[0]], farr.data()[gen[1]]);
+    }
+    EXPECT_EQ(24, std::ssize(pairs));
+    EXPECT_EQ(std::make_pair(1, 4), pairs.front());
+    EXPECT_EQ(std::make_pair(24, 21), pairs.back());
+
+    // binary kernels over joint runs
+    auto sarr = arr[{ {0, 1}, {1, 2}, {0, 3, 2} }];
+    oc::arrnd<int> rarr{ {2, 2, 2}, {1, 2, 3, 4, 5, 6, 7, 8} };
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2, 2}, {6, 9, 12, 15, 22, 25, 28, 31} }, sarr + rarr));
+    EXPECT_TRUE(oc::all_equal(farr + arr, arr + farr));
+    EXPECT_FALSE(oc::all_equal(farr, arr));
+
+    rarr.copy_to(sarr);
+    EXPECT_EQ(36, oc::sum(sarr));
+    sarr.apply(rarr, [](int a, int b) { return a - b; });
+    EXPECT_EQ(0, oc::sum(sarr));
+    EXPECT_EQ(300 - 112, oc::sum(arr));
+}
+
+TEST(arrnd_test, bulk_copy_of_runs)
+{
+    // large contiguous clone and converting copy
+    oc::arrnd<int> large({ 1 << 17 }, 0);
+    std::iota(large.data(), large.data() + (1 << 17), 0);
+    auto cl = large.clone();
+    EXPECT_NE(large.data(), cl.data());
+    EXPECT_TRUE(oc::all_equal(large, cl));
+    oc::arrnd<double> dlarge(large);
+    EXPECT_EQ(static_cast<double>((1 << 17) - 1), dlarge.data()[(1 << 17) - 1]);
+
+    // overlapping runs of the same buffer
+    oc::arrnd<int> arr{ {10}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9} };
+    auto src = arr[{ {0, 4} }];
+    auto dst = arr[{ {2, 6} }];
+    src.copy_to(dst);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {10}, {0, 1, 0, 1, 2, 3, 4, 7, 8, 9} }, arr));
+
+    // strided source into contiguous destinations of other dimensions
+    oc::arrnd<int> marr{ {3, 4}, {
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12 } };
+    auto smarr = marr[{ {0, 2}, {1, 3, 2} }];
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {2, 4, 6, 8} }, oc::resize(smarr, { 2, 2 })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {2, 4, 6, 8, 10, 12} }, oc::resize(smarr, { 2, 3 })));
+
+    oc::arrnd<int> res({ 4 }, 0);
+    smarr.copy_to(res);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {4}, {2, 4, 6, 8} }, res));
+}
+
+TEST(arrnd_test, negative_strides_and_flip)
+{
+    oc::arrnd<int> arr{ {2, 3}, {
+        1, 2, 3,
+        4, 5, 6 } };
+
+    // flipped views share the buffer
+    auto farr0 = oc::flip(arr, 0);
+    EXPECT_EQ(arr.data(), farr0.data());
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ -3, 1 }, farr0.header().strides()));
+    EXPECT_EQ(3, farr0.header().offset());
+    EXPECT_FALSE(farr0.header().is_contiguous());
+    EXPECT_TRUE(farr0.header().is_dense());
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {4, 5, 6, 1, 2, 3} }, farr0));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {3, 2, 1, 6, 5, 4} }, arr.flip(-1)));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {6, 5, 4, 3, 2, 1} }, arr.flip(0).flip(1)));
+    EXPECT_TRUE(oc::all_equal(arr, farr0.flip(0)));
+
+    // reversed intervals
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {3, 1, 6, 4} }, (arr[{ {0, 1}, {-1, 0, -2} }])));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {1, 2}, {2, 1} }, (arr.flip(0)[{ {1, 1}, {1, 0, -1} }])));
+    EXPECT_TRUE(oc::empty(arr[{ {0, 1}, {0, 2, -1} }]));
+
+    farr0[{ 0, 0 }] = 40;
+    EXPECT_EQ(40, (arr[{ 1, 0 }]));
+    farr0[{ 0, 0 }] = 4;
+
+    // iteration in both directions
+    auto rarr = arr.flip(1);
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 3, 2, 1, 6, 5, 4 }, std::vector<int>(rarr.cbegin(), rarr.cend())));
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 4, 5, 6, 1, 2, 3 }, std::vector<int>(rarr.crbegin(), rarr.crend())));
+
+    // kernels
+    EXPECT_EQ(21, oc::sum(farr0));
+    EXPECT_DOUBLE_EQ(3.5, oc::mean(rarr));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2}, {6, 15} }, oc::sum(rarr, { 1 })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {6, 4, 2, 12, 10, 8} }, rarr.transform([](int n) { return 2 * n; })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {4, 4, 4, 10, 10, 10} }, rarr.transform(arr, [](int a, int b) { return a + b; })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3, 2}, {3, 6, 2, 5, 1, 4} }, rarr.transpose({ 1, 0 })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3, 2}, {3, 2, 1, 6, 5, 4} }, rarr.reshape({ 3, 2 })));
+
+    oc::arrnd<int> carr = arr.clone();
+    carr.flip(0).flip(1).apply([](int n) { return -n; });
+    EXPECT_TRUE(oc::all_equal(arr.transform([](int n) { return -n; }), carr));
+
+    // buffer with negative strides, of reversed rows
+    const std::int64_t dims[]{ 2, 3 };
+    const std::int64_t strides[]{ -3, 1 };
+    const int data[]{ 4, 5, 6, 1, 2, 3 };
+    oc::arrnd<int> narr(dims, strides, data);
+    EXPECT_TRUE(oc::all_equal(arr, narr));
+    EXPECT_EQ(3, narr.header().offset());
+}
+
 TEST(arrnd_test, have_read_write_access_to_its_cells)
 {
     using Integer_array = oc::arrnd<int>;
@@ -989,6 +1651,448 @@ TEST(arrnd_test, reduce_elements)
     }
 }
 
+TEST(arrnd_test, reduce_elements_by_multiple_axes)
+{
+    // NCHW layout with N = 2, C = 3, H = 2, W = 2
+    oc::arrnd<int> arr({ 2, 3, 2, 2 });
+    std::iota(arr.data(), arr.data() + arr.header().count(), 0);
+
+    auto plus = [](int a, int b) { return a + b; };
+
+    oc::arrnd per_channel{ {3}, {60, 92, 124} };
+    EXPECT_TRUE(oc::all_equal(per_channel, oc::reduce(arr, plus, { 0, 2, 3 })));
+    EXPECT_TRUE(oc::all_equal(per_channel, oc::reduce(oc::reduce(oc::reduce(arr, plus, 3), plus, 2), plus, 0)));
+    EXPECT_TRUE(oc::all_equal(per_channel, oc::sum(arr, { 0, 2, 3 })));
+    EXPECT_TRUE(oc::all_equal(per_channel, oc::sum(arr, { 3, -2, 0, 0 })));
+
+    auto kept = oc::reduce(arr, plus, { 0, 2, 3 }, true);
+    const std::int64_t kept_dims[]{ 1, 3, 1, 1 };
+    EXPECT_TRUE(std::ranges::equal(kept_dims, kept.header().dims()));
+    EXPECT_TRUE(oc::all_equal(per_channel, kept.reshape({ 3 })));
+
+    oc::arrnd<int> all_reduced = oc::reduce(arr, plus, { 0, 1, 2, 3 });
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>({ 1 }, 276), all_reduced));
+
+    // single middle axis of a three dimensional array
+    oc::arrnd<int> arr3d({ 2, 3, 2 });
+    std::iota(arr3d.data(), arr3d.data() + arr3d.header().count(), 1);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd{ {2, 2}, {9, 12, 27, 30} }, oc::reduce(arr3d, plus, 1)));
+
+    // subarray
+    auto sarr = arr[{ {0, 1}, {0, 2, 2}, {1, 1}, {0, 1} }];
+    EXPECT_TRUE(oc::all_equal(oc::arrnd{ {2}, {34, 66} }, oc::reduce(sarr, plus, { 0, 2, 3 })));
+
+    EXPECT_TRUE(oc::empty(oc::reduce(oc::arrnd<int>{}, plus, { 0, 1 })));
+
+    // no axes - each element is reduced alone
+    const std::span<const std::int64_t> no_axes{};
+    EXPECT_TRUE(oc::all_equal(sarr, oc::reduce(sarr, plus, no_axes)));
+    EXPECT_TRUE(oc::all_equal(arr3d, oc::mean(arr3d, no_axes)));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>({ 2, 3, 2 }, 0.0), oc::var(arr3d, no_axes)));
+}
+
+TEST(arrnd_test, argmin_argmax)
+{
+    EXPECT_EQ(-1, oc::argmin(oc::arrnd<int>{}));
+    EXPECT_TRUE(oc::empty(oc::argmax(oc::arrnd<int>{}, 0)));
+
+    oc::arrnd<int> arr{ {2, 3, 4}, {
+        5, 1, 7, 1,
+        3, 9, 2, 8,
+        4, 6, 0, 9,
+
+        2, 2, 2, 2,
+        -1, 3, 3, 4,
+        8, 0, 11, 6 } };
+
+    EXPECT_EQ(16, oc::argmin(arr));
+    EXPECT_EQ(22, oc::argmax(arr));
+    EXPECT_EQ(10, oc::argmin(arr[{ {0, 0} }]));
+
+    // indices along last axis are buffer indices, and can be used to gather the extremum values
+    auto imin2 = oc::argmin(arr, 2);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {2, 3}, {1, 6, 10, 12, 16, 21} }, imin2));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {1, 2, 0, 2, -1, 0} }, arr[imin2]));
+
+    auto imax1 = oc::argmax(arr, 1);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {2, 4}, {0, 5, 2, 11, 20, 17, 22, 23} }, imax1));
+
+    auto imax0 = oc::argmax(arr[{ {0, 1}, {1, 2} }], 0);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {2, 4}, {4, 5, 18, 7, 20, 9, 22, 11} }, imax0));
+
+    // large inputs are processed in parallel
+    const std::int64_t count{ 3 * oc::parallel_threshold };
+    oc::arrnd<double> large({ 3, count / 3 }, 0.5);
+    large[{ 2, 17 }] = -1.0;
+    large[{ 0, 5 }] = 2.0;
+    large[{ 1, 5 }] = 2.0;
+    EXPECT_EQ(2 * (count / 3) + 17, oc::argmin(large));
+    EXPECT_EQ(5, oc::argmax(large));
+
+    auto imin = oc::argmin(large, 1);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {3}, {0, count / 3, 2 * (count / 3) + 17} }, imin));
+    auto imax = oc::argmax(large, 0);
+    EXPECT_EQ(5, imax[{ 5 }]);
+    EXPECT_EQ(count / 3 - 1, imax[{ count / 3 - 1 }]);
+}
+
+TEST(thread_pool_test, parallel_for_covers_the_whole_range)
+{
+    oc::thread_pool pool(4);
+    EXPECT_EQ(4, pool.size());
+
+    std::vector<int> visits(1000, 0);
+    pool.parallel_for(std::ssize(visits), [&visits](std::int64_t first, std::int64_t last) {
+        for (std::int64_t i = first; i < last; ++i) {
+            ++visits[i];
+        }
+    });
+    EXPECT_TRUE(std::ranges::all_of(visits, [](int v) { return v == 1; }));
+
+    EXPECT_THROW(pool.parallel_for(10, [](std::int64_t first, std::int64_t) {
+        if (first > 0) {
+            throw std::runtime_error("partition failure");
+        }
+    }), std::runtime_error);
+}
+
+namespace {
+    std::int64_t fork_join_fibonacci(oc::thread_pool& pool, std::int64_t n)
+    {
+        if (n < 2) {
+            return n;
+        }
+        std::int64_t first{ 0 };
+        oc::task_group group(pool);
+        group.run([&]() { first = fork_join_fibonacci(pool, n - 1); });
+        std::int64_t second{ fork_join_fibonacci(pool, n - 2) };
+        group.wait();
+        return first + second;
+    }
+}
+
+TEST(thread_pool_test, nested_and_irregular_work_is_stolen)
+{
+    oc::thread_pool pool(4);
+
+    EXPECT_EQ(610, fork_join_fibonacci(pool, 15));
+
+    // nested parallel calls from inside pool tasks
+    std::vector<std::vector<int>> visits(16);
+    pool.parallel_for(std::ssize(visits), [&](std::int64_t first, std::int64_t last) {
+        for (std::int64_t i = first; i < last; ++i) {
+            visits[i].resize(100 * (i + 1), 0);
+            pool.parallel_for(std::ssize(visits[i]), [&visits, i](std::int64_t vfirst, std::int64_t vlast) {
+                for (std::int64_t j = vfirst; j < vlast; ++j) {
+                    ++visits[i][j];
+                }
+            });
+        }
+    });
+    EXPECT_TRUE(std::ranges::all_of(visits, [](const auto& v) { return std::ranges::all_of(v, [](int n) { return n == 1; }); }));
+
+    oc::task_group group(pool);
+    group.run([]() { throw std::runtime_error("task failure"); });
+    group.run([]() {});
+    EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST(thread_pool_test, large_arrays_are_initialized_by_partitions)
+{
+    oc::thread_pool pool(3, true);
+    std::vector<int> visits(1000, 0);
+    for (std::int64_t worker = 0; worker < 10; ++worker) {
+        pool.submit_to(worker, []() {});
+    }
+    pool.parallel_for(std::ssize(visits), [&visits](std::int64_t first, std::int64_t last) {
+        for (std::int64_t i = first; i < last; ++i) {
+            ++visits[i];
+        }
+    });
+    EXPECT_TRUE(std::ranges::all_of(visits, [](int v) { return v == 1; }));
+
+    const std::int64_t count{ oc::parallel_threshold * 2 + 3 };
+    std::vector<std::int64_t> data(count);
+    std::iota(data.begin(), data.end(), std::int64_t{ 0 });
+
+    oc::arrnd<std::int64_t> carr({ count }, static_cast<const std::int64_t*>(data.data()));
+    EXPECT_TRUE(std::ranges::equal(data, std::span<const std::int64_t>(carr.data(), count)));
+
+    oc::arrnd<std::int64_t> farr({ count }, std::int64_t{ 3 });
+    EXPECT_EQ(3 * count, oc::sum(farr));
+
+    // cpus that the thread is not allowed to run on are ignored
+    const int no_cpus[]{ -1 };
+    EXPECT_FALSE(oc::details::pin_current_thread(no_cpus));
+    EXPECT_FALSE(oc::details::pin_current_thread({}));
+
+    // the shared pool is configured only before its first use
+    const std::int64_t size{ oc::thread_pool::instance().size() };
+    EXPECT_FALSE(oc::thread_pool::configure_instance(size + 1, true));
+    EXPECT_EQ(size, oc::thread_pool::instance().size());
+}
+
+namespace {
+    oc::async_result<int> async_weighted_sum(const oc::arrnd<int>& arr)
+    {
+        int total = co_await arr.async_sum();
+        oc::arrnd<int> doubled = co_await arr.async_transform([](int n) { return 2 * n; });
+        co_return total + co_await doubled.async_reduce([](int a, int b) { return a + b; });
+    }
+}
+
+TEST(async_result_test, operations_on_the_thread_pool)
+{
+    oc::arrnd<int> arr{ {2, 3}, {1, 2, 3, 4, 5, 6} };
+
+    auto tres = oc::async_transform(arr, [](int n) { return n * n; });
+    auto fres = arr.async_filter([](int n) { return n % 2 == 0; });
+    auto rres = arr.async_reduce([](int a, int b) { return a + b; }, 1);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {1, 4, 9, 16, 25, 36} }, tres.get()));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {2, 4, 6} }, fres.get()));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2}, {6, 15} }, rres.get()));
+    EXPECT_TRUE(tres.ready());
+
+    oc::arrnd<int> carr = arr.clone();
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 3}, {-1, -2, -3, -4, -5, -6} }, carr.async_apply([](int n) { return -n; }).get()));
+    EXPECT_EQ(-21, oc::sum(carr));
+
+    auto cres = async_weighted_sum(arr);
+    EXPECT_EQ(63, cres.get());
+
+    auto eres = oc::async_invoke([]() -> int { throw std::runtime_error("operation failure"); });
+    EXPECT_THROW(static_cast<void>(eres.get()), std::runtime_error);
+}
+
+TEST(arrnd_test, sum_with_accumulation_policies)
+{
+    EXPECT_EQ(0, oc::sum(oc::arrnd<int>{}));
+
+    oc::arrnd iarr{ {3, 1, 2}, {1, 2, 3, 4, 5, 6} };
+    EXPECT_EQ(21, oc::sum(iarr));
+    EXPECT_EQ(21, oc::sum<oc::kahan_babuska_summation>(iarr));
+    EXPECT_EQ(21, (oc::sum<oc::widened_summation<>>(iarr)));
+    EXPECT_EQ(12, oc::sum(iarr[{ {0, 2}, {0, 0}, {1, 1} }]));
+
+    // one million values of 0.1f, where sequential float accumulation drifts far from the exact value
+    const std::int64_t count{ 1 << 20 };
+    oc::arrnd<float> farr({ count }, 0.1f);
+    const double exact{ count * static_cast<double>(0.1f) };
+
+    float naive = oc::reduce(farr, [](float a, float b) { return a + b; });
+    EXPECT_GT(std::abs(naive - exact), 1000.0);
+
+    EXPECT_NEAR(exact, oc::sum(farr), exact * 1e-6);
+    EXPECT_NEAR(exact, oc::sum<oc::kahan_babuska_summation>(farr), exact * 1e-6);
+
+    auto wide = oc::sum<oc::widened_summation<>>(farr);
+    static_assert(std::is_same_v<double, decltype(wide)>);
+    EXPECT_NEAR(exact, wide, exact * 1e-12);
+
+    // subarray elements are gathered by blocks
+    auto sfarr = farr[{ {1, count - 1, 2} }];
+    EXPECT_NEAR(exact / 2, oc::sum(sfarr), exact * 1e-6);
+    EXPECT_NEAR(exact / 2, oc::sum<oc::kahan_babuska_summation>(sfarr), exact * 1e-6);
+}
+
+TEST(arrnd_test, mean_var_std)
+{
+    EXPECT_TRUE(std::isnan(oc::mean(oc::arrnd<int>{})));
+    EXPECT_TRUE(oc::empty(oc::var(oc::arrnd<int>{}, { 0 })));
+
+    oc::arrnd iarr{ {2, 3}, {1, 2, 3, 4, 5, 6} };
+
+    auto m = oc::mean(iarr);
+    static_assert(std::is_same_v<double, decltype(m)>);
+    EXPECT_DOUBLE_EQ(3.5, m);
+    EXPECT_DOUBLE_EQ(17.5 / 6, oc::var(iarr));
+    EXPECT_DOUBLE_EQ(3.5, oc::var(iarr, 1));
+    EXPECT_DOUBLE_EQ(std::sqrt(3.5), oc::stddev(iarr, 1));
+    EXPECT_TRUE(std::isnan(oc::var(iarr, 6)));
+
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {3}, {2.5, 3.5, 4.5} }, oc::mean(iarr, { 0 })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {3}, {2.25, 2.25, 2.25} }, oc::var(iarr, { 0 })));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {2, 1}, {1.0, 1.0} }, oc::stddev(iarr, { 1 }, 1, true)));
+    EXPECT_DOUBLE_EQ(17.5 / 6, (oc::var(iarr, { 0, 1 })[{ 0 }]));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<double>{ {2}, {2.0, 5.0} }, oc::mean(iarr[{ {0, 1}, {0, 2, 2} }], { 1 })));
+
+    // values with a large mean, where the sum of squares formula loses all precision
+    const std::int64_t count{ 3 * oc::parallel_threshold };
+    oc::arrnd<double> large({ count });
+    for (std::int64_t i = 0; i < count; ++i) {
+        large[{ i }] = 1e9 + static_cast<double>(i % 4);
+    }
+    EXPECT_NEAR(1e9 + 1.5, oc::mean(large), 1e-6);
+    EXPECT_NEAR(1.25, oc::var(large), 1e-6);
+    EXPECT_NEAR(std::sqrt(1.25), oc::stddev(large), 1e-6);
+    EXPECT_NEAR(1.25, (oc::var(large.reshape({ 4, count / 4 }), { 0, 1 })[{ 0 }]), 1e-6);
+    EXPECT_NEAR(1.25, oc::var(large[{ {0, count - 1, 3} }]), 1e-6);
+}
+
+TEST(arrnd_ragged_test, rows_views_and_reductions)
+{
+    oc::arrnd_ragged<int> empty_ragged{};
+    EXPECT_TRUE(empty_ragged.empty());
+    EXPECT_TRUE(oc::empty(empty_ragged.reduce(std::plus<>{})));
+
+    oc::arrnd_ragged<int> ragged({ 3, 0, 2 }, { 1, 2, 3, 4, 5 });
+    EXPECT_EQ(3, ragged.rows());
+    EXPECT_EQ(5, ragged.count());
+    EXPECT_EQ(0, ragged.row_size(1));
+    EXPECT_TRUE(ragged[1].empty());
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 4, 5 }, ragged[2]));
+
+    // rows are views of the shared values buffer
+    oc::arrnd_ragged<int> shared = ragged;
+    shared[0][1] = 20;
+    EXPECT_EQ(20, ragged[0][1]);
+    shared[0][1] = 2;
+
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {6, 0, 9} }, ragged.reduce(std::plus<>{})));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::string>{ {3}, {std::string{"-1-2-3"}, std::string{}, std::string{"-4-5"}} },
+        ragged.reduce(std::string{}, [](const std::string& s, int n) { return s + "-" + std::to_string(n); })));
+
+    auto halves = ragged.transform([](int n) { return n / 2.0; });
+    static_assert(std::is_same_v<oc::arrnd_ragged<double>, decltype(halves)>);
+    EXPECT_EQ(ragged.offsets().data(), halves.offsets().data());
+    EXPECT_TRUE(std::ranges::equal(std::vector<double>{ 2.0, 2.5 }, halves[2]));
+
+    // conversion from an array of arrays
+    oc::arrnd<oc::arrnd<int>> nested({ 3 });
+    nested[{ 0 }] = oc::arrnd<int>{ {3}, {1, 2, 3} };
+    nested[{ 2 }] = oc::arrnd<int>{ {2, 1}, {4, 5} };
+    oc::arrnd_ragged<int> flattened(nested);
+    EXPECT_EQ(3, flattened.rows());
+    EXPECT_TRUE(oc::all_equal(ragged.offsets(), flattened.offsets()));
+    EXPECT_TRUE(oc::all_equal(ragged.values(), flattened.values()));
+
+    // many short rows are processed in parallel
+    const std::int64_t rows{ oc::parallel_threshold };
+    std::vector<std::int64_t> lengths(rows);
+    for (std::int64_t i = 0; i < rows; ++i) {
+        lengths[i] = i % 4;
+    }
+    oc::arrnd_ragged<std::int64_t> large(lengths);
+    for (std::int64_t i = 0; i < rows; ++i) {
+        std::ranges::fill(large[i], i);
+    }
+    auto sums = large.transform([](std::int64_t n) { return n + 1; }).reduce(std::plus<>{});
+    for (std::int64_t i = 0; i < rows; ++i) {
+        EXPECT_EQ((i + 1) * (i % 4), sums[{ i }]);
+    }
+}
+
+TEST(arrnd_sparse_test, conversions_and_kernels)
+{
+    oc::arrnd<int> dense{ {3, 4}, {
+        0, 2, 0, 0,
+        1, 0, 0, 3,
+        0, 0, 0, 0 } };
+
+    oc::arrnd_coo<int> coo(dense);
+    EXPECT_EQ(3, coo.rows());
+    EXPECT_EQ(4, coo.cols());
+    EXPECT_EQ(3, coo.nnz());
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {3}, {0, 1, 1} }, coo.row_indices()));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {3}, {1, 0, 3} }, coo.col_indices()));
+    EXPECT_TRUE(oc::all_equal(dense, coo.to_dense()));
+
+    oc::arrnd_csr<int> csr(dense);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<std::int64_t>{ {4}, {0, 1, 3, 3} }, csr.row_offsets()));
+    EXPECT_TRUE(oc::all_equal(dense, csr.to_dense()));
+    EXPECT_TRUE(oc::all_equal(dense, csr.to_coo().to_csr().to_dense()));
+
+    // element wise operations with scalars apply to the stored elements
+    auto scaled = csr.transform(0.5, std::multiplies<>{});
+    static_assert(std::is_same_v<oc::arrnd_csr<double>, decltype(scaled)>);
+    EXPECT_EQ(csr.col_indices().data(), scaled.col_indices().data());
+    EXPECT_TRUE(oc::all_equal(dense.transform([](int n) { return n * 0.5; }), scaled.to_dense()));
+    EXPECT_TRUE(oc::all_equal(dense.transform([](int n) { return -n; }), coo.transform(std::negate<>{}).to_dense()));
+
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {2, 4, 0} }, csr.reduce(std::plus<>{})));
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {3, 5, 1} }, csr.reduce(1, std::plus<>{})));
+
+    // matrix-vector and matrix-matrix products
+    oc::arrnd<int> x{ {4}, {1, 2, 3, 4} };
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {4, 13, 0} }, csr.dot(x)));
+    oc::arrnd<int> padded{ {8}, {1, 0, 2, 0, 3, 0, 4, 0} };
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3}, {4, 13, 0} }, csr.dot(padded[{ {0, 7, 2} }])));
+
+    oc::arrnd<int> xs{ {4, 2}, {
+        1, 0,
+        0, 1,
+        1, 1,
+        2, 0 } };
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {3, 2}, {0, 2, 7, 0, 0, 0} }, csr.dot(xs)));
+    EXPECT_TRUE(oc::empty(csr.dot(oc::arrnd<int>{ {3}, {1, 2, 3} })));
+
+    // repeated coordinates are accumulated on conversion to dense
+    oc::arrnd_coo<int> repeated(2, 2, oc::arrnd<std::int64_t>{ {3}, {1, 0, 1} }, oc::arrnd<std::int64_t>{ {3}, {1, 0, 1} }, oc::arrnd<int>{ {3}, {1, 2, 3} });
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {2, 2}, {2, 0, 0, 4} }, repeated.to_csr().to_dense()));
+
+    // large products are computed in parallel
+    const std::int64_t n{ oc::parallel_threshold };
+    oc::arrnd<std::int64_t> diagonal({ n });
+    oc::arrnd<double> values({ n });
+    for (std::int64_t i = 0; i < n; ++i) {
+        diagonal[{ i }] = i;
+        values[{ i }] = static_cast<double>(i % 7);
+    }
+    oc::arrnd_csr<double> large(oc::arrnd_coo<double>(n, n, diagonal, diagonal, values));
+    auto y = large.dot(oc::arrnd<double>({ n }, 2.0));
+    EXPECT_TRUE(oc::all_equal(values.transform([](double v) { return 2.0 * v; }), y));
+    EXPECT_TRUE(oc::all_equal(values, large.reduce(std::plus<>{})));
+}
+
+TEST(arrnd_tiled_test, layout_and_kernels)
+{
+    EXPECT_TRUE(oc::arrnd_tiled<int>({ 3, 5 }, { 2 }).empty());
+    EXPECT_TRUE(oc::arrnd_tiled<int>({ 3, 0 }, { 2, 2 }).empty());
+
+    oc::arrnd<int> dense({ 3, 5 });
+    std::iota(dense.data(), dense.data() + dense.header().count(), 0);
+
+    oc::arrnd_tiled<int> tiled(dense, { 2, 2 });
+    EXPECT_EQ(6, tiled.num_tiles());
+    EXPECT_EQ(15, tiled.count());
+    EXPECT_EQ(14, (tiled[{ 2, 4 }]));
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 0, 1, 5, 6, 2, 3, 7, 8 }, std::span<const int>(tiled.data(), 8)));
+    EXPECT_TRUE(oc::all_equal(dense, tiled.to_dense()));
+
+    // the indexer walks tile by tile, skipping padding
+    std::vector<int> visited;
+    for (auto gen = tiled.indexer(); gen; ++gen) {
+        visited.push_back(tiled.data()[*gen]);
+    }
+    EXPECT_TRUE(std::ranges::equal(std::vector<int>{ 0, 1, 5, 6, 2, 3, 7, 8, 4, 9, 10, 11, 12, 13, 14 }, visited));
+
+    EXPECT_EQ(105, tiled.reduce(std::plus<>{}));
+    EXPECT_EQ(106, tiled.reduce(1, std::plus<>{}));
+    EXPECT_TRUE(oc::all_equal(dense.transform([](int n) { return n * 0.5; }), tiled.transform([](int n) { return n * 0.5; }).to_dense()));
+
+    auto transposed = tiled.transpose({ 1, 0 });
+    EXPECT_TRUE(std::ranges::equal(std::vector<std::int64_t>{ 5, 3 }, transposed.dims()));
+    EXPECT_TRUE(oc::all_equal(dense.transpose({ 1, 0 }), transposed.to_dense()));
+    EXPECT_TRUE(tiled.transpose({ 0, 0 }).empty());
+
+    // subarray source
+    auto sdense = dense[{ {0, 2}, {1, 4, 2} }];
+    EXPECT_TRUE(oc::all_equal(sdense, oc::arrnd_tiled<int>(sdense, { 2, 1 }).to_dense()));
+
+    // three dimensional, with partial tiles on all the axes
+    oc::arrnd<int> dense3d({ 3, 4, 5 });
+    std::iota(dense3d.data(), dense3d.data() + dense3d.header().count(), 0);
+    oc::arrnd_tiled<int> tiled3d(dense3d, { 2, 3, 2 });
+    EXPECT_TRUE(oc::all_equal(dense3d.transpose({ 2, 0, 1 }), tiled3d.transpose({ 2, 0, 1 }).to_dense()));
+
+    // large arrays are processed by tiles in parallel
+    oc::arrnd<double> large({ 300, 260 });
+    std::iota(large.data(), large.data() + large.header().count(), 0.0);
+    oc::arrnd_tiled<double> tiled_large(large, { 64, 64 });
+    EXPECT_TRUE(oc::all_equal(large.transpose({ 1, 0 }), tiled_large.transpose({ 1, 0 }).to_dense()));
+    EXPECT_TRUE(oc::all_equal(large.transform([](double v) { return -v; }), tiled_large.transform(std::negate<>{}).to_dense()));
+}
+
 TEST(arrnd_test, all)
 {
     const bool data[] = {
@@ -1279,6 +2383,19 @@ TEST(arrnd_test, transpose)
 
     EXPECT_TRUE(oc::all_equal(rarr, oc::transpose(iarr, { 2, 0, 1, 3, 2 })));
     EXPECT_TRUE(oc::empty(oc::transpose(iarr, { 2, 0, 1, 4 })));
+
+    // reordered dimensions that are partially contiguous
+    oc::arrnd<int> carr({ 4, 2, 3 });
+    std::iota(carr.data(), carr.data() + carr.header().count(), 0);
+    oc::arrnd<int> rcarr{ {2, 3, 4}, {
+        0, 6, 12, 18,
+        1, 7, 13, 19,
+        2, 8, 14, 20,
+
+        3, 9, 15, 21,
+        4, 10, 16, 22,
+        5, 11, 17, 23} };
+    EXPECT_TRUE(oc::all_equal(rcarr, oc::transpose(carr, { 1, 2, 0 })));
 }
 
 TEST(arrnd_test, equal)
@@ -2581,9 +3698,9 @@ TEST(arrnd_test, can_return_slice)
         EXPECT_TRUE(oc::all_equal(sarr1, sarr3));
         EXPECT_EQ(arr.data(), sarr3.data());
 
-        // out of range and negative indices
+        // out of range and negative indices, negative step reverses the axis
         Integer_array sarr4{ arr[{{-1, 3, -2}, {1}, {-2}}] };
-        EXPECT_TRUE(oc::all_equal(sarr1, sarr4));
+        EXPECT_TRUE(oc::all_equal(oc::flip(sarr1, 0), sarr4));
         EXPECT_EQ(arr.data(), sarr4.data());
     }
 }
@@ -3713,6 +4830,121 @@ TEST(arrnd_test, complex_array)
     EXPECT_TRUE(oc::all_equal(sarr2, (sarr1[{ {0, 0}, {0, 0}, {0, 0}, {1, 1}, {0, 0} }])));
 }
 
+TEST(fast_divisor_test, matches_hardware_division)
+{
+    auto check = []<typename T>(T) {
+        using limits = std::numeric_limits<T>;
+        std::vector<T> values{ 0, 1, 2, 3, 5, 7, 10, 100, 641, 1000003, limits::max(), static_cast<T>(limits::max() - 1), static_cast<T>(limits::max() / 2), static_cast<T>(limits::max() / 3) };
+        if constexpr (std::is_signed_v<T>) {
+            for (T v : std::vector<T>(values)) {
+                values.push_back(static_cast<T>(-v));
+            }
+            values.push_back(limits::min());
+            values.push_back(static_cast<T>(limits::min() + 1));
+        }
+        for (int i = 0; i < 64; ++i) {
+            values.push_back(static_cast<T>(static_cast<std::uint64_t>(0x9e3779b97f4a7c15ull * (i + 1)) >> (i % 48)));
+        }
+
+        for (T d : values) {
+            if (d == 0) {
+                continue;
+            }
+            const oc::fast_divisor<T> fd(d);
+            for (T n : values) {
+                if (std::is_signed_v<T> && n == limits::min() && d == static_cast<T>(-1)) {
+                    continue;
+                }
+                EXPECT_EQ(static_cast<T>(n / d), n / fd) << n << " / " << d;
+                EXPECT_EQ(static_cast<T>(n % d), n % fd) << n << " % " << d;
+                if (d < T{ 2000000 } && (std::is_unsigned_v<T> || d > static_cast<T>(-2000000))) {
+                    EXPECT_EQ(oc::modulo(n, d), oc::modulo(n, fd)) << n << " mod " << d;
+                }
+            }
+        }
+    };
+
+    check(std::int32_t{});
+    check(std::uint32_t{});
+    check(std::int64_t{});
+    check(std::uint64_t{});
+
+    // array-scalar division and modulo
+    oc::arrnd<std::int64_t> ids({ 1000 }, 0);
+    std::iota(ids.data(), ids.data() + 1000, -500);
+    auto shards = ids % std::int64_t{ 7 };
+    auto quotients = ids / std::int64_t{ 7 };
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ((i - 500) % 7, shards.data()[i]);
+        EXPECT_EQ((i - 500) / 7, quotients.data()[i]);
+    }
+    ids /= std::int64_t{ -3 };
+    EXPECT_EQ(500 / 3, ids.data()[0]);
+    EXPECT_TRUE(oc::all_equal(oc::arrnd<int>{ {4}, {0, 1, 2, 0} }, oc::arrnd<int>{ {4}, {3, 4, 5, 6} } % 3));
+}
+
+TEST(philox_generator_test, known_answers_and_reproducible_arrays)
+{
+    // known answers of Philox4x32-10
+    EXPECT_EQ((std::array<std::uint32_t, 4>{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }), oc::philox_generator(0)(0, 0));
+    EXPECT_EQ((std::array<std::uint32_t, 4>{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }), oc::philox_generator(~std::uint64_t{ 0 })(~std::uint64_t{ 0 }, ~std::uint64_t{ 0 }));
+
+    // large arrays are filled by partitions, with the same values as by a single thread
+    constexpr std::int64_t count{ 1 << 17 };
+    auto uarr = oc::random_uniform<oc::arrnd<double>>({ count }, -1.0, 1.0, 42);
+    const oc::philox_generator gen(42);
+    bool same{ true };
+    double sum{ 0 };
+    for (std::int64_t i = 0; i < count; ++i) {
+        same = same && uarr.data()[i] == -1.0 + 2.0 * oc::details::unit_uniform<double>(gen(i));
+        sum += uarr.data()[i];
+        EXPECT_TRUE(uarr.data()[i] >= -1.0 && uarr.data()[i] < 1.0);
+    }
+    EXPECT_TRUE(same);
+    EXPECT_NEAR(0.0, sum / count, 0.01);
+    EXPECT_TRUE(oc::all_equal(uarr, oc::random_uniform<oc::arrnd<double>>({ count }, -1.0, 1.0, 42)));
+    EXPECT_FALSE(oc::all_equal(uarr, oc::random_uniform<oc::arrnd<double>>({ count }, -1.0, 1.0, 43)));
+
+    auto narr = oc::random_normal<oc::arrnd<double>>({ count }, 2.0, 3.0, 7);
+    const double mean{ oc::sum(narr) / count };
+    const double var{ oc::sum((narr - mean) * (narr - mean)) / count };
+    EXPECT_NEAR(2.0, mean, 0.05);
+    EXPECT_NEAR(9.0, var, 0.15);
+
+    auto iarr = oc::random_integers<oc::arrnd<int>>({ 1000 }, -3, 3, 1);
+    std::array<int, 7> histogram{};
+    for (std::int64_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(iarr.data()[i] >= -3 && iarr.data()[i] <= 3);
+        ++histogram[iarr.data()[i] + 3];
+    }
+    EXPECT_TRUE(std::ranges::all_of(histogram, [](int h) { return h > 100; }));
+
+    // subarrays are filled in iteration order
+    oc::arrnd<int> arr({ 4, 4 }, 0);
+    auto sarr = arr[{ {1, 2}, {1, 2} }];
+    oc::fill_random_uniform(sarr, 1, 100, 5);
+    auto expected = oc::random_integers<oc::arrnd<int>>({ 2, 2 }, 1, 100, 5);
+    EXPECT_TRUE(oc::all_equal(expected, sarr));
+    EXPECT_EQ(oc::sum(expected), oc::sum(arr));
+
+    // and large subarrays by partitions of their runs
+    oc::thread_pool pool(4);
+    oc::task_group group(pool);
+    oc::arrnd<double> larr({ 520, 520 }, 5.0);
+    auto lsarr = larr[{ {4, 515}, {3, 514} }];
+    group.run([&]() {
+        oc::fill_random_uniform(lsarr, -1.0, 1.0, 42);
+    });
+    group.wait();
+    EXPECT_TRUE(oc::all_equal(oc::random_uniform<oc::arrnd<double>>({ 512, 512 }, -1.0, 1.0, 42), lsarr));
+    EXPECT_EQ(520 * 520 - 512 * 512, std::count(larr.data(), larr.data() + 520 * 520, 5.0));
+
+    // floating point values are below high even where low + (high - low) * u rounds up to it
+    const float high{ std::nextafter(1.0f, 2.0f) };
+    auto farr = oc::random_uniform<oc::arrnd<float>>({ 1000 }, 1.0f, high, 3);
+    EXPECT_TRUE(std::all_of(farr.data(), farr.data() + 1000, [high](float v) { return v >= 1.0f && v < high; }));
+}
+
 
 
 //#include <thread>